@@ -0,0 +1,139 @@
+/**
+ @file
+ @brief 通用IO库 异步IO引擎接口定义
+
+ @author 司马坑
+ @date 2026/10/17
+*/
+#pragma once
+#include "Utilities.FileStream.h"
+
+#include <future>
+#include <functional>
+#include <exception>
+
+namespace Utilities
+{
+	/**
+		使用方式：
+		@code
+			FileStream fs(L"level.pak", Stream::Type::ReadOnly, false);
+			std::vector<std::future<void>> pending;
+			{
+				// 作用域内发起的请求会在作用域结束时通过一次系统调用批量提交
+				AsyncIOEngine::Batch batch;
+				for (auto& chunk : chunks)
+					pending.push_back(fs.ReadAsync(chunk.offset, chunk.size, chunk.buffer));
+			}
+			for (auto& f : pending)
+				f.get();	// IO 失败或读到文件末尾时抛出异常
+		@endcode
+	*/
+	/// <summary>
+	/// 异步IO引擎
+	/// <para>
+	/// Linux 下使用 io_uring 提交请求，由一个后台线程收割完成事件；
+	/// io_uring 不可用时(包括 Windows)退化为一个执行 FileStream::ReadAt / WriteAt 的小线程池
+	/// </para>
+	/// <para>
+	/// 请求完成前，文件流对象以及数据缓冲区都必须保持有效
+	/// </para>
+	/// </summary>
+	class AsyncIOEngine
+	{
+	public:
+		/// <summary>
+		/// 完成回调 参数为空表示请求成功
+		/// <para>
+		/// 回调在引擎的后台线程上执行，应当尽快返回，不能抛出异常；
+		/// io_uring 出现无法恢复的错误时，所有未完成的请求以该错误结束，回调可能在发起请求的线程上执行
+		/// </para>
+		/// </summary>
+		using Completion = std::function<void(std::exception_ptr)>;
+		/// <summary>
+		/// 批量提交作用域
+		/// <para>
+		/// 当前线程在该对象的生命周期内向该引擎发起的请求不会立即提交，而是在作用域结束时一并提交；
+		/// 向其他引擎发起的请求不受影响
+		/// </para>
+		/// <para>
+		/// 作用域内不能等待该引擎上的请求完成(例如调用 future::get)，这些请求在作用域结束前不会被提交
+		/// </para>
+		/// </summary>
+		class Batch
+		{
+		public:
+			Batch(AsyncIOEngine& engine = AsyncIOEngine::Default());
+			~Batch();
+			Batch(const Batch&) = delete;
+			Batch& operator=(const Batch&) = delete;
+		private:
+			AsyncIOEngine& engine;
+		};
+	public:
+		/// <summary>
+		/// 创建一个异步IO引擎
+		/// </summary>
+		/// <param name="queueDepth">同时处理中的请求数上限</param>
+		/// <param name="workerCount">退化为线程池时的线程数</param>
+		AsyncIOEngine(unsigned queueDepth = 256, unsigned workerCount = 4);
+		~AsyncIOEngine();
+		AsyncIOEngine(const AsyncIOEngine&) = delete;
+		AsyncIOEngine& operator=(const AsyncIOEngine&) = delete;
+	public:
+		/// <summary>
+		/// 获取进程内共享的缺省引擎
+		/// </summary>
+		static AsyncIOEngine& Default();
+		/// <summary>
+		/// 发起一次异步定位读取
+		/// </summary>
+		/// <param name="stream">文件流</param>
+		/// <param name="offset">文件中的偏移量</param>
+		/// <param name="len">要读取的数据长度</param>
+		/// <param name="data">数据写入的目标缓冲区</param>
+		/// <returns>请求完成时就绪，失败或读到文件末尾时携带异常</returns>
+		std::future<void> Read(FileStream& stream, uint64_t offset, size_t len, void* data);
+		/// <summary>
+		/// 发起一次异步定位写入
+		/// </summary>
+		/// <param name="stream">文件流</param>
+		/// <param name="offset">文件中的偏移量</param>
+		/// <param name="len">要写入的数据长度</param>
+		/// <param name="data">数据</param>
+		/// <returns>请求完成时就绪，失败时携带异常</returns>
+		std::future<void> Write(FileStream& stream, uint64_t offset, size_t len, const void* data);
+		/// <summary>
+		/// 发起一次异步定位读取，完成时调用 done
+		/// </summary>
+		/// <param name="stream">文件流</param>
+		/// <param name="offset">文件中的偏移量</param>
+		/// <param name="len">要读取的数据长度</param>
+		/// <param name="data">数据写入的目标缓冲区</param>
+		/// <param name="done">完成回调</param>
+		void Read(FileStream& stream, uint64_t offset, size_t len, void* data, Completion done);
+		/// <summary>
+		/// 发起一次异步定位写入，完成时调用 done
+		/// </summary>
+		/// <param name="stream">文件流</param>
+		/// <param name="offset">文件中的偏移量</param>
+		/// <param name="len">要写入的数据长度</param>
+		/// <param name="data">数据</param>
+		/// <param name="done">完成回调</param>
+		void Write(FileStream& stream, uint64_t offset, size_t len, const void* data, Completion done);
+		/// <summary>
+		/// 立即提交所有尚未提交的请求
+		/// <para>
+		/// 提交失败时引擎失效，尚未完成的请求以该错误结束，并抛出异常
+		/// </para>
+		/// </summary>
+		void Submit();
+		/// <summary>
+		/// 当前引擎是否在使用 io_uring
+		/// </summary>
+		bool IsUsingUring() const;
+	private:
+		struct Impl;
+		Impl* impl = nullptr;
+	};
+}
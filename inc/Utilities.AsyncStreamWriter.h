@@ -0,0 +1,167 @@
+/**
+ @file
+ @brief 通用IO库 异步写入流接口定义
+
+ @author 司马坑
+ @date 2026/10/17
+*/
+#pragma once
+#include "Utilities.Stream.h"
+
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace Utilities
+{
+	/**
+		使用方式：
+		@code
+			FileStream fs(L"telemetry.log", Stream::Type::WriteOnly, false);
+			AsyncStreamWriter async(fs, 1024 * 1024, AsyncStreamWriter::OverflowPolicy::Drop);
+
+			// 在帧循环中写入只需要一次内存复制
+			auto sw = StreamWriter(async);
+			sw.Format("{} {} {:.3}\n", frame, name, elapsed);
+
+			// 等待所有数据写入并提交到磁盘
+			async.Flush();
+		@endcode
+	*/
+	/// <summary>
+	/// 异步写入流对象
+	/// <para>
+	/// 包装一个流对象，写入只把数据复制到前台缓冲区；前台缓冲区写满后与后台缓冲区交换，
+	/// 由后台线程把数据写入被包装的流，调用者不会等待被包装的流的写入
+	/// </para>
+	/// <para>
+	/// 后台线程仍在写入上一个缓冲区而前台缓冲区又已写满时，按 OverflowPolicy 等待或丢弃本次写入；
+	/// 被包装的流的写入失败时，异常在之后的 Write / Flush / Close 中抛出
+	/// </para>
+	/// <para>
+	/// 该流只能写入，可以在多个线程中同时写入；不超过缓冲区大小的单次写入不会与其他线程的数据交错
+	/// </para>
+	/// </summary>
+	class AsyncStreamWriter final : public Stream
+	{
+	public:
+		//! 缺省的缓冲区大小
+		static constexpr size_t DefaultBufferSize = 1024 * 1024;
+
+		/// <summary>
+		/// 两个缓冲区都已写满时的处理方式
+		/// </summary>
+		enum class OverflowPolicy
+		{
+			Block,	//!< 等待后台线程写完上一个缓冲区
+			Drop,	//!< 丢弃本次写入的全部数据，超过缓冲区大小的单次写入也会被丢弃
+		};
+		/// <summary>
+		/// 把被包装的流中的数据提交到磁盘的回调，在后台线程中调用
+		/// </summary>
+		using SyncCallback = std::function<void(Stream&)>;
+	public:
+		/// <summary>
+		/// 为一个流对象创建异步写入流，并启动后台线程
+		/// <para>
+		/// 被包装的流对象的生命周期必须长于异步写入流，创建后不能再直接写入被包装的流
+		/// </para>
+		/// </summary>
+		/// <param name="stream">被包装的流对象</param>
+		/// <param name="bufferSize">每个缓冲区的大小</param>
+		/// <param name="policy">两个缓冲区都已写满时的处理方式</param>
+		/// <param name="sync">Flush 时在被包装的流的 Flush 之后调用，为空且被包装的流是 FileStream 时调用 FileStream::Sync</param>
+		AsyncStreamWriter(Stream& stream, size_t bufferSize = DefaultBufferSize, OverflowPolicy policy = OverflowPolicy::Block,
+			SyncCallback sync = nullptr);
+		AsyncStreamWriter(const AsyncStreamWriter&) = delete;
+		AsyncStreamWriter& operator=(const AsyncStreamWriter&) = delete;
+		/// <summary>
+		/// 析构函数
+		/// <para>
+		/// 析构时会等待所有数据写入并停止后台线程，但不会关闭被包装的流
+		/// </para>
+		/// </summary>
+		virtual ~AsyncStreamWriter();
+	public:
+		/// <summary>
+		/// 该流只能写入，调用时抛出异常
+		/// </summary>
+		virtual void Read(size_t len, void* data) override;
+		/// <summary>
+		/// 流对象写入接口
+		/// <para>
+		/// 通常只是一次内存复制；只有两个缓冲区都已写满时才会按 OverflowPolicy 等待或丢弃
+		/// </para>
+		/// </summary>
+		/// <param name="len">要写入的数据长度</param>
+		/// <param name="data">数据</param>
+		virtual void Write(size_t len, const void* data) override;
+		/// <summary>
+		/// 等待所有数据写入并同步后停止后台线程，并关闭被包装的流
+		/// </summary>
+		virtual void Close() override;
+		/// <summary>
+		/// 检测流对象是否可用
+		/// </summary>
+		virtual bool IsVaild() override;
+		/// <summary>
+		/// 等待此前写入的所有数据交给被包装的流，并在后台线程中调用被包装的流的 Flush 与同步回调
+		/// <para>
+		/// 被包装的流是 FileStream 或指定了同步回调时，返回时数据已经提交到磁盘
+		/// </para>
+		/// </summary>
+		virtual void Flush() override;
+	public:
+		/// <summary>
+		/// 获取每个缓冲区的大小
+		/// </summary>
+		size_t GetBufferSize() const { return bufferSize; }
+		/// <summary>
+		/// 获取按 OverflowPolicy::Drop 丢弃的数据量
+		/// </summary>
+		uint64_t GetDroppedBytes();
+		/// <summary>
+		/// 获取写入因后台线程未完成而等待的次数
+		/// </summary>
+		uint64_t GetStallCount();
+	private:
+		void Run();
+		void Submit(std::unique_lock<std::mutex>& lock);
+		void WaitFlushed(std::unique_lock<std::mutex>& lock);
+		void Stop(std::unique_lock<std::mutex>& lock);
+		void ThrowIfFailed();
+	private:
+		Stream& stream;
+		size_t bufferSize;
+		OverflowPolicy policy;
+		SyncCallback sync;
+
+		std::mutex mutex;
+		//! 后台线程有新的工作
+		std::condition_variable work;
+		//! 后台线程完成了一项工作
+		std::condition_variable done;
+
+		//! 前台缓冲区，由写入方填充
+		std::unique_ptr<uint8[]> front;
+		size_t frontLength = 0;
+		//! 后台缓冲区，backBusy 为 true 时由后台线程写入被包装的流
+		std::unique_ptr<uint8[]> back;
+		size_t backLength = 0;
+		bool backBusy = false;
+
+		//! Flush 请求的序号与后台线程已完成的序号
+		uint64_t flushRequested = 0;
+		uint64_t flushCompleted = 0;
+
+		bool stopping = false;
+		bool closed = false;
+		std::exception_ptr error;
+		uint64_t droppedBytes = 0;
+		uint64_t stallCount = 0;
+		std::thread worker;
+	};
+}
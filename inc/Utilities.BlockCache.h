@@ -0,0 +1,180 @@
+/**
+ @file
+ @brief 通用IO库 块缓存接口定义
+
+ @author 司马坑
+ @date 2026/10/17
+*/
+#pragma once
+#include "Utilities.Stream.h"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace Utilities
+{
+	class CachedStream;
+
+	/**
+		使用方式：
+		@code
+			// 所有包文件共享 64 MB 的缓存
+			BlockCache cache(64 * 1024 * 1024);
+
+			FileStream pack(L"assets.pak", Stream::Type::ReadOnly, false);
+			CachedStream cs(pack, cache);
+			cs.SetPosition(indexOffset);
+			auto entry = StreamReader(cs).Read<IndexEntry>();
+
+			auto statistics = cache.GetStatistics();
+		@endcode
+	*/
+	/// <summary>
+	/// 块缓存对象
+	/// <para>
+	/// 以固定大小的块缓存流中的数据，可以被多个 CachedStream 共享；
+	/// 块以被包装的流对象为键，包装同一个流的多个 CachedStream 共享其中的块，经过任何一个写入都会使其他的看到新数据；
+	/// 一个流的最后一个 CachedStream 关闭时丢弃该流的所有块
+	/// 缓存按块的键分为多个分片，每个分片有独立的锁与 CLOCK 淘汰指针，不同分片上的读取互不阻塞
+	/// </para>
+	/// <para>
+	/// 未命中时在锁外从流中读取整块数据，读取完成后再放入缓存，慢速的读取不会阻塞同一分片上的命中
+	/// </para>
+	/// </summary>
+	class BlockCache
+	{
+		friend class CachedStream;
+	public:
+		//! 缺省的块大小
+		static constexpr size_t DefaultBlockSize = 4096;
+		//! 缺省的分片个数
+		static constexpr size_t DefaultShardCount = 16;
+
+		/// <summary>
+		/// 缓存的统计结果
+		/// </summary>
+		struct Statistics
+		{
+			uint64_t hits = 0;		//!< 命中次数
+			uint64_t misses = 0;	//!< 未命中次数
+			uint64_t evictions = 0;	//!< 淘汰的块数
+		};
+	public:
+		/// <summary>
+		/// 创建块缓存
+		/// <para>
+		/// 内存预算按块大小与分片个数向下取整，每个分片至少保留一块
+		/// </para>
+		/// </summary>
+		/// <param name="capacity">内存预算(字节)</param>
+		/// <param name="blockSize">块大小</param>
+		/// <param name="shardCount">分片个数</param>
+		BlockCache(size_t capacity, size_t blockSize = DefaultBlockSize, size_t shardCount = DefaultShardCount);
+		BlockCache(const BlockCache&) = delete;
+		BlockCache& operator=(const BlockCache&) = delete;
+		~BlockCache();
+	public:
+		/// <summary>
+		/// 获取块大小
+		/// </summary>
+		size_t GetBlockSize() const { return blockSize; }
+		/// <summary>
+		/// 获取缓存最多容纳的块数
+		/// </summary>
+		size_t GetBlockCount() const { return shardCapacity * shards.size(); }
+		/// <summary>
+		/// 获取到目前为止的统计结果
+		/// </summary>
+		Statistics GetStatistics() const;
+		/// <summary>
+		/// 清空缓存中的所有块，不影响统计结果
+		/// </summary>
+		void Clear();
+	private:
+		struct Key
+		{
+			uint64_t source;
+			uint64_t index;
+			bool operator==(const Key& rhs) const { return source == rhs.source && index == rhs.index; }
+		};
+		struct KeyHash
+		{
+			size_t operator()(const Key& key) const;
+		};
+		struct Slot
+		{
+			Key key;
+			std::unique_ptr<uint8_t[]> data;
+			size_t size = 0;
+			bool referenced = false;
+		};
+		struct Shard
+		{
+			std::mutex mutex;
+			std::unordered_map<Key, size_t, KeyHash> map;
+			std::vector<Slot> slots;
+			//! 被 Invalidate 清空的槽
+			std::vector<size_t> free;
+			size_t hand = 0;
+			//! 每次 Invalidate 加一，未命中的读取完成时据此判断读到的数据是否已经过时
+			uint64_t generation = 0;
+		};
+		struct Source
+		{
+			uint64_t id = 0;
+			//! 包装该流的 CachedStream 个数
+			size_t references = 0;
+			//! 流的长度，由包装该流的所有 CachedStream 共享，随其中任何一个的写入增长
+			std::atomic<uint64_t> length{ 0 };
+		};
+		/// <summary>
+		/// 取得流对象的数据源，该流已被其他 CachedStream 包装时返回同一个数据源
+		/// <para>
+		/// 返回的引用在对应的 ReleaseSource 之前一直有效
+		/// </para>
+		/// </summary>
+		/// <param name="stream">被包装的流</param>
+		/// <param name="length">流的长度，仅在首次登记时使用</param>
+		Source& AcquireSource(Stream& stream, uint64_t length);
+		/// <summary>
+		/// 释放流对象的数据源编号，最后一个引用释放时丢弃该数据源的所有块
+		/// </summary>
+		void ReleaseSource(Stream& stream);
+		/// <summary>
+		/// 从第 index 块的 offset 处复制 len 字节到 dst ，未命中时从 stream 中读取整块
+		/// </summary>
+		/// <param name="source">数据源编号</param>
+		/// <param name="index">块序号</param>
+		/// <param name="stream">数据源</param>
+		/// <param name="blockLength">该块的有效长度，最后一块可能不足 blockSize</param>
+		/// <param name="offset">块内偏移量</param>
+		/// <param name="len">复制的长度</param>
+		/// <param name="dst">目标缓冲区</param>
+		void Read(uint64_t source, uint64_t index, Stream& stream, size_t blockLength, size_t offset, size_t len, void* dst);
+		/// <summary>
+		/// 丢弃数据源中 [first, last] 的块
+		/// </summary>
+		void Invalidate(uint64_t source, uint64_t first, uint64_t last);
+		/// <summary>
+		/// 丢弃数据源的所有块
+		/// </summary>
+		void Invalidate(uint64_t source);
+		Shard& GetShard(const Key& key);
+		static void Discard(Shard& shard, std::unordered_map<Key, size_t, KeyHash>::iterator it);
+	private:
+		size_t blockSize;
+		size_t shardCapacity;
+		std::vector<std::unique_ptr<Shard>> shards;
+		std::mutex sourceMutex;
+		//! 正在被 CachedStream 包装的流对象，流的地址可能被重用，因此每次重新登记都分配新的编号
+		std::unordered_map<Stream*, Source> sources;
+		uint64_t nextSource = 0;
+		std::atomic<uint64_t> hits{ 0 };
+		std::atomic<uint64_t> misses{ 0 };
+		std::atomic<uint64_t> evictions{ 0 };
+	};
+}
@@ -0,0 +1,161 @@
+/**
+ @file
+ @brief 通用IO库 缓冲流接口定义
+
+ @author 司马坑
+ @date 2026/10/17
+*/
+#pragma once
+#include "Utilities.Stream.h"
+
+#include <cstring>
+
+namespace Utilities
+{
+	/**
+		使用方式：
+		@code
+			FileStream fs(L"records.bin", Stream::Type::ReadOnly, false);
+			BufferedStream bs(fs, 64 * 1024);
+
+			// StreamReader<BufferedStream> 在缓冲区命中时不经过虚函数分派
+			auto sr = StreamReader(bs);
+			auto id = sr.Read<uint32>();
+			auto value = sr.Read<float>();
+		@endcode
+	*/
+	/// <summary>
+	/// 缓冲流对象
+	/// <para>
+	/// 包装任意一个流对象，为其提供预读缓冲和延迟写入缓冲，把大量小块读写合并为少量大块读写
+	/// </para>
+	/// <para>
+	/// 该类型为 final，缓冲区命中时的读写路径在头文件中内联实现，
+	/// 以 BufferedStream 类型实例化的 StreamReader / StreamWriter 不会产生虚函数调用
+	/// </para>
+	/// </summary>
+	class BufferedStream final : public Stream
+	{
+	public:
+		//! 缺省的缓冲区大小
+		static constexpr size_t DefaultBufferSize = 64 * 1024;
+	public:
+		/// <summary>
+		/// 为一个流对象创建缓冲流
+		/// <para>
+		/// 被包装的流对象的生命周期必须长于缓冲流
+		/// </para>
+		/// </summary>
+		/// <param name="stream">被包装的流对象</param>
+		/// <param name="bufferSize">缓冲区大小</param>
+		BufferedStream(Stream& stream, size_t bufferSize = DefaultBufferSize);
+		BufferedStream(const BufferedStream&) = delete;
+		BufferedStream& operator=(const BufferedStream&) = delete;
+		/// <summary>
+		/// 析构函数
+		/// <para>
+		/// 析构时会提交尚未写入的数据，但不会关闭被包装的流
+		/// </para>
+		/// </summary>
+		virtual ~BufferedStream();
+	public:
+		/// <summary>
+		/// 流对象读取接口
+		/// </summary>
+		/// <param name="len">要读取的数据长度</param>
+		/// <param name="data">数据写入的目标缓冲区</param>
+		virtual void Read(size_t len, void* data) override
+		{
+			if (len <= readLength - readPosition)
+			{
+				memcpy(data, buffer + readPosition, len);
+				readPosition += len;
+				return;
+			}
+			ReadSlow(len, data);
+		}
+		/// <summary>
+		/// 流对象写入接口
+		/// </summary>
+		/// <param name="len">要写入的数据长度</param>
+		/// <param name="data">数据</param>
+		virtual void Write(size_t len, const void* data) override
+		{
+			if (readLength == 0 && len <= bufferSize - writeLength)
+			{
+				memcpy(buffer + writeLength, data, len);
+				writeLength += len;
+				return;
+			}
+			WriteSlow(len, data);
+		}
+		/// <summary>
+		/// 提交缓冲区中的数据并关闭被包装的流
+		/// </summary>
+		virtual void Close() override;
+		/// <summary>
+		/// 检测被包装的流是否可用
+		/// </summary>
+		virtual bool IsVaild() override;
+		/// <summary>
+		/// 读取至多 maxLen 字节的数据
+		/// </summary>
+		/// <param name="maxLen">最多读取的数据长度</param>
+		/// <param name="data">数据写入的目标缓冲区</param>
+		/// <returns>实际读取的数据长度</returns>
+		virtual size_t ReadSome(size_t maxLen, void* data) override;
+		/// <summary>
+		/// 将写入缓冲区中的数据写入被包装的流，并调用被包装的流的 Flush
+		/// <para>
+		/// 预读的数据保留在缓冲区中，不会移动被包装的流的读写指针
+		/// </para>
+		/// </summary>
+		virtual void Flush() override;
+	public:
+		/// <summary>
+		/// 获取流的长度
+		/// </summary>
+		virtual uint64_t GetLength() override;
+		/// <summary>
+		/// 获取当前读写指针的位置
+		/// </summary>
+		virtual uint64_t GetPosition() override;
+		/// <summary>
+		/// 设置当前读写指针的位置
+		/// <para>
+		/// 目标位置仍在预读缓冲区内时不会访问被包装的流
+		/// </para>
+		/// </summary>
+		/// <param name="pos"></param>
+		virtual void SetPosition(uint64_t pos) override;
+		/// <summary>
+		/// 移动当前读写指针的位置
+		/// </summary>
+		/// <param name="offset">偏移量</param>
+		virtual void Seek(int64_t offset) override;
+	public:
+		/// <summary>
+		/// 获取缓冲区的大小
+		/// </summary>
+		size_t GetBufferSize() const { return bufferSize; }
+		/// <summary>
+		/// 获取预读缓冲区中尚未被读取的数据长度
+		/// </summary>
+		size_t GetBufferedLength() const { return readLength - readPosition; }
+	private:
+		void ReadSlow(size_t len, void* data);
+		void WriteSlow(size_t len, const void* data);
+		void FlushWrite();
+		void DiscardRead();
+	private:
+		Stream& stream;
+		uint8* buffer = nullptr;
+		size_t bufferSize = 0;
+		//! 预读缓冲区中有效数据的长度
+		size_t readLength = 0;
+		//! 预读缓冲区中下一个要读取的字节
+		size_t readPosition = 0;
+		//! 写入缓冲区中尚未提交的数据长度
+		size_t writeLength = 0;
+	};
+}
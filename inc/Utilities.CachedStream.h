@@ -0,0 +1,123 @@
+/**
+ @file
+ @brief 通用IO库 缓存流接口定义
+
+ @author 司马坑
+ @date 2026/10/17
+*/
+#pragma once
+#include "Utilities.Stream.h"
+#include "Utilities.BlockCache.h"
+
+namespace Utilities
+{
+	/// <summary>
+	/// 缓存流对象
+	/// <para>
+	/// 包装一个支持定位的流对象，所有读取按块经过 BlockCache ，命中时直接从用户态内存复制，不产生系统调用；
+	/// 未命中时通过被包装的流的 ReadAt 读取整块，适合索引查找等随机读取
+	/// </para>
+	/// <para>
+	/// 缓存流有自己的读写指针，只通过 ReadAt / WriteAt 访问被包装的流；
+	/// 写入直接交给被包装的流，并丢弃缓存中被覆盖的块。包装同一个流的多个缓存流共享缓存中的块，
+	/// 经过其中任何一个写入的数据与增长的长度对其他缓存流立即可见；流的长度在第一个缓存流创建时取得，
+	/// 之后只随经过缓存流的写入增长，被包装的流不能再通过缓存流以外的途径改写
+	/// </para>
+	/// </summary>
+	class CachedStream final : public Stream
+	{
+	public:
+		/// <summary>
+		/// 为一个流对象创建缓存流
+		/// <para>
+		/// 被包装的流对象与缓存的生命周期必须长于缓存流
+		/// </para>
+		/// </summary>
+		/// <param name="stream">被包装的流对象，必须支持 GetLength 与 ReadAt</param>
+		/// <param name="cache">使用的块缓存</param>
+		CachedStream(Stream& stream, BlockCache& cache);
+		CachedStream(const CachedStream&) = delete;
+		CachedStream& operator=(const CachedStream&) = delete;
+		/// <summary>
+		/// 析构函数，关闭缓存流
+		/// </summary>
+		virtual ~CachedStream();
+	public:
+		/// <summary>
+		/// 流对象读取接口
+		/// </summary>
+		/// <param name="len">要读取的数据长度</param>
+		/// <param name="data">数据写入的目标缓冲区</param>
+		virtual void Read(size_t len, void* data) override;
+		/// <summary>
+		/// 流对象写入接口
+		/// </summary>
+		/// <param name="len">要写入的数据长度</param>
+		/// <param name="data">数据</param>
+		virtual void Write(size_t len, const void* data) override;
+		/// <summary>
+		/// 关闭缓存流，不影响被包装的流
+		/// <para>
+		/// 该流的最后一个缓存流关闭时丢弃缓存中该流的所有块
+		/// </para>
+		/// </summary>
+		virtual void Close() override;
+		/// <summary>
+		/// 检测流对象是否可用
+		/// </summary>
+		virtual bool IsVaild() override;
+		/// <summary>
+		/// 调用被包装的流的 Flush
+		/// </summary>
+		virtual void Flush() override;
+		/// <summary>
+		/// 读取至多 maxLen 字节的数据
+		/// </summary>
+		/// <param name="maxLen">最多读取的数据长度</param>
+		/// <param name="data">数据写入的目标缓冲区</param>
+		/// <returns>实际读取的数据长度</returns>
+		virtual size_t ReadSome(size_t maxLen, void* data) override;
+		/// <summary>
+		/// 从指定位置读取数据，不改变当前读写指针
+		/// <para>
+		/// 可以在多个线程中并发调用
+		/// </para>
+		/// </summary>
+		/// <param name="offset">流中的偏移量</param>
+		/// <param name="len">要读取的数据长度</param>
+		/// <param name="data">数据写入的目标缓冲区</param>
+		virtual void ReadAt(uint64_t offset, size_t len, void* data) override;
+		/// <summary>
+		/// 向指定位置写入数据，不改变当前读写指针
+		/// </summary>
+		/// <param name="offset">流中的偏移量</param>
+		/// <param name="len">要写入的数据长度</param>
+		/// <param name="data">数据</param>
+		virtual void WriteAt(uint64_t offset, size_t len, const void* data) override;
+	public:
+		/// <summary>
+		/// 获取流的长度
+		/// </summary>
+		virtual uint64_t GetLength() override;
+		/// <summary>
+		/// 获取当前读写指针的位置
+		/// </summary>
+		virtual uint64_t GetPosition() override;
+		/// <summary>
+		/// 设置当前读写指针的位置
+		/// </summary>
+		/// <param name="pos">新的位置</param>
+		virtual void SetPosition(uint64_t pos) override;
+		/// <summary>
+		/// 移动当前读写指针的位置
+		/// </summary>
+		/// <param name="offset">偏移量</param>
+		virtual void Seek(int64_t offset) override;
+	private:
+		Stream& stream;
+		BlockCache& cache;
+		BlockCache::Source& source;
+		uint64_t position = 0;
+		bool closed = false;
+	};
+}
@@ -0,0 +1,295 @@
+/**
+ @file
+ @brief 通用IO流 可等待的 CoStreamReader 与 CoStreamWriter 接口定义
+
+ 仅在编译器支持 C++20 协程时可用
+
+ @author 司马坑
+ @date 2026/10/17
+*/
+#pragma once
+#include "Utilities.Coroutine.h"
+
+#ifdef UTILITIES_HAS_COROUTINE
+#include "Utilities.AsyncIO.h"
+#include "Utilities.Common.Span.h"
+
+#include <vector>
+#include <type_traits>
+
+namespace Utilities
+{
+	class CoStreamReader;
+	class CoStreamWriter;
+
+	namespace _private
+	{
+		/// <summary>
+		/// 一次可能需要等待IO完成的读写操作
+		/// <para>
+		/// 缓冲区能够满足请求时不挂起；否则发起异步IO并挂起，
+		/// 由完成回调在后台线程上继续推进，全部完成后把协程交还给调度器
+		/// </para>
+		/// </summary>
+		class CoTransfer
+		{
+		public:
+			bool await_ready();
+			bool await_suspend(std::coroutine_handle<> handle);
+			void await_resume();
+		protected:
+			CoTransfer(CoStreamReader* reader, CoStreamWriter* writer, uint8* data, size_t len, bool flush = false)
+				: reader(reader), writer(writer), data(data), remaining(len), flush(flush) { }
+		private:
+			bool Step();
+			bool StepRead();
+			bool StepWrite();
+			/// <summary>
+			/// 在调度器的线程上继续传输，完成后恢复协程
+			/// </summary>
+			void Continue();
+			void Resume(std::exception_ptr error);
+		private:
+			CoStreamReader* reader;
+			CoStreamWriter* writer;
+			uint8* data;
+			size_t remaining;
+			//! 写出缓冲区中的全部数据后才算完成
+			bool flush;
+			std::coroutine_handle<> handle;
+			std::exception_ptr error;
+		};
+
+		/// <summary>
+		/// 读取单个值的等待对象
+		/// </summary>
+		template<typename T>
+		class CoReadValue : public CoTransfer
+		{
+		public:
+			CoReadValue(CoStreamReader* reader) : CoTransfer(reader, nullptr, reinterpret_cast<uint8*>(&value), sizeof(T)) { }
+			CoReadValue(const CoReadValue&) = delete;
+			T await_resume()
+			{
+				CoTransfer::await_resume();
+				return value;
+			}
+		private:
+			T value;
+		};
+
+		/// <summary>
+		/// 批量读写的等待对象
+		/// </summary>
+		class CoBytes : public CoTransfer
+		{
+		public:
+			CoBytes(CoStreamReader* reader, CoStreamWriter* writer, uint8* data, size_t len, bool flush = false)
+				: CoTransfer(reader, writer, data, len, flush) { }
+			CoBytes(const CoBytes&) = delete;
+		};
+
+		/// <summary>
+		/// 写入单个值的等待对象
+		/// </summary>
+		template<typename T>
+		class CoWriteValue : public CoTransfer
+		{
+		public:
+			CoWriteValue(CoStreamWriter* writer, const T& v) : CoTransfer(nullptr, writer, reinterpret_cast<uint8*>(&value), sizeof(T)), value(v) { }
+			CoWriteValue(const CoWriteValue&) = delete;
+		private:
+			T value;
+		};
+	}
+
+	/**
+		使用方式：
+		@code
+			Coroutine::Task<void> LoadMesh(Coroutine::Executor& ex, FileStream& fs, Mesh& mesh)
+			{
+				CoStreamReader sr(fs, ex);
+				auto count = co_await sr.Read<uint32_t>();
+				mesh.vertices.resize(count);
+				co_await sr.ReadArray(mesh.vertices.data(), count);
+			}
+		@endcode
+	*/
+	/// <summary>
+	/// 可等待的流读取器
+	/// <para>
+	/// 在自己的缓冲区中预读文件内容，缓冲区耗尽时通过 AsyncIOEngine 发起读取并挂起当前协程，
+	/// 读取完成后协程由调度器恢复。大量读取器可以复用同一个调度器的少数几个线程
+	/// </para>
+	/// <para>
+	/// 读取器从构造时文件流的读写指针处开始读取，使用定位读取，不改变文件流的读写指针；
+	/// 读取期间文件的长度不应改变
+	/// </para>
+	/// </summary>
+	class CoStreamReader
+	{
+	public:
+		/// <summary>
+		/// 创建一个可等待的流读取器
+		/// </summary>
+		/// <param name="stream">文件流</param>
+		/// <param name="executor">恢复协程的调度器</param>
+		/// <param name="bufferSize">预读缓冲区的大小</param>
+		/// <param name="engine">执行IO的引擎</param>
+		CoStreamReader(FileStream& stream, Coroutine::Executor& executor, size_t bufferSize = 64 * 1024,
+			AsyncIOEngine& engine = AsyncIOEngine::Default());
+		CoStreamReader(const CoStreamReader&) = delete;
+		CoStreamReader& operator=(const CoStreamReader&) = delete;
+	public:
+		/// <summary>
+		/// 读取指定类型的数据
+		/// <para>
+		/// 用法： auto v = co_await sr.Read&lt;int&gt;();
+		/// </para>
+		/// </summary>
+		template<typename DataType>
+		_private::CoReadValue<DataType> Read()
+		{
+			static_assert(std::is_pod_v<DataType>, "Object must be pod!");
+			return _private::CoReadValue<DataType>(this);
+		}
+		/// <summary>
+		/// 读取 count 个指定类型的数据到 dst 中
+		/// <para>
+		/// 超过缓冲区大小的部分直接读入 dst ，不经过缓冲区
+		/// </para>
+		/// </summary>
+		/// <param name="dst">目标数组</param>
+		/// <param name="count">元素个数</param>
+		template<typename DataType>
+		_private::CoBytes ReadArray(DataType* dst, size_t count)
+		{
+			static_assert(std::is_pod_v<DataType>, "Object must be pod!");
+			if (count > SIZE_MAX / sizeof(DataType))
+				throw Exception(u8"Error occured when reading stream : Length_Overflow");
+			return _private::CoBytes(this, nullptr, reinterpret_cast<uint8*>(dst), count * sizeof(DataType));
+		}
+		/// <summary>
+		/// 读取数据填满 dst
+		/// </summary>
+		/// <param name="dst">目标数组</param>
+		template<typename DataType>
+		_private::CoBytes ReadArray(Common::Span<DataType> dst)
+		{
+			return ReadArray(dst.data(), dst.size());
+		}
+		/// <summary>
+		/// 获取下一次读取的位置
+		/// </summary>
+		uint64_t GetPosition() const { return filePosition - (bufferEnd - bufferBegin); }
+	private:
+		friend class _private::CoTransfer;
+		FileStream& stream;
+		Coroutine::Executor& executor;
+		AsyncIOEngine& engine;
+		std::vector<uint8> buffer;
+		size_t bufferBegin = 0;
+		size_t bufferEnd = 0;
+		//! 下一次从文件读取的位置
+		uint64_t filePosition;
+		uint64_t fileLength;
+	};
+
+	/**
+		使用方式：
+		@code
+			Coroutine::Task<void> SaveMesh(Coroutine::Executor& ex, FileStream& fs, const Mesh& mesh)
+			{
+				CoStreamWriter sw(fs, ex);
+				co_await sw.Write<uint32_t>(mesh.vertices.size());
+				co_await sw.WriteArray(mesh.vertices.data(), mesh.vertices.size());
+				co_await sw.Flush();
+			}
+		@endcode
+	*/
+	/// <summary>
+	/// 可等待的流写入器
+	/// <para>
+	/// 数据先写入自己的缓冲区，缓冲区写满时通过 AsyncIOEngine 写出并挂起当前协程
+	/// </para>
+	/// <para>
+	/// 写入器从构造时文件流的读写指针处开始写入，使用定位写入，不改变文件流的读写指针；
+	/// 结束前应当 co_await Flush() ，析构时剩余的数据会被同步写出
+	/// </para>
+	/// </summary>
+	class CoStreamWriter
+	{
+	public:
+		/// <summary>
+		/// 创建一个可等待的流写入器
+		/// </summary>
+		/// <param name="stream">文件流</param>
+		/// <param name="executor">恢复协程的调度器</param>
+		/// <param name="bufferSize">写缓冲区的大小</param>
+		/// <param name="engine">执行IO的引擎</param>
+		CoStreamWriter(FileStream& stream, Coroutine::Executor& executor, size_t bufferSize = 64 * 1024,
+			AsyncIOEngine& engine = AsyncIOEngine::Default());
+		~CoStreamWriter();
+		CoStreamWriter(const CoStreamWriter&) = delete;
+		CoStreamWriter& operator=(const CoStreamWriter&) = delete;
+	public:
+		/// <summary>
+		/// 写入指定类型的数据
+		/// <para>
+		/// 用法： co_await sw.Write(v);
+		/// </para>
+		/// </summary>
+		template<typename DataType>
+		_private::CoWriteValue<DataType> Write(const DataType& v)
+		{
+			static_assert(std::is_pod_v<DataType>, "Object must be pod!");
+			return _private::CoWriteValue<DataType>(this, v);
+		}
+		/// <summary>
+		/// 写入 count 个指定类型的数据
+		/// <para>
+		/// 等待结束前 src 必须保持有效
+		/// </para>
+		/// </summary>
+		/// <param name="src">源数组</param>
+		/// <param name="count">元素个数</param>
+		template<typename DataType>
+		_private::CoBytes WriteArray(const DataType* src, size_t count)
+		{
+			static_assert(std::is_pod_v<DataType>, "Object must be pod!");
+			if (count > SIZE_MAX / sizeof(DataType))
+				throw Exception(u8"Error occured when writing stream : Length_Overflow");
+			return _private::CoBytes(nullptr, this, reinterpret_cast<uint8*>(const_cast<DataType*>(src)), count * sizeof(DataType));
+		}
+		/// <summary>
+		/// 写入 src 中的全部数据
+		/// </summary>
+		/// <param name="src">源数组</param>
+		template<typename DataType>
+		_private::CoBytes WriteArray(Common::Span<DataType> src)
+		{
+			return WriteArray(src.data(), src.size());
+		}
+		/// <summary>
+		/// 写出缓冲区中的数据
+		/// </summary>
+		_private::CoBytes Flush()
+		{
+			return _private::CoBytes(nullptr, this, nullptr, 0, true);
+		}
+		/// <summary>
+		/// 获取下一次写入的位置
+		/// </summary>
+		uint64_t GetPosition() const { return filePosition + bufferEnd; }
+	private:
+		friend class _private::CoTransfer;
+		FileStream& stream;
+		Coroutine::Executor& executor;
+		AsyncIOEngine& engine;
+		std::vector<uint8> buffer;
+		size_t bufferEnd = 0;
+		//! 缓冲区第一个字节对应的文件位置
+		uint64_t filePosition;
+	};
+}
+#endif
@@ -0,0 +1,106 @@
+/**
+	 @file
+	 @brief 通用模板库 对齐内存分配器的实现
+
+	 这个文件里面是按指定边界对齐的内存分配函数以及与 STL 容器配合使用的分配器
+	 直接IO要求缓冲区地址按扇区大小对齐，SIMD 指令也偏好按缓存行对齐的数据
+
+	@code
+		Common::AlignedVector<uint8> block(64 * 1024);
+		// block.data() 按 4096 字节对齐
+	@endcode
+
+	 @author 司马坑
+	 @date 2026/10/17
+*/
+
+/**
+	@addtogroup Utilities_Common
+	@{
+*/
+#pragma once
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+namespace Utilities::Common
+{
+	/// <summary>
+	/// 分配一段按 alignment 字节对齐的内存
+	/// <para>
+	/// 返回的内存必须使用 AlignedFree 释放，分配失败时抛出 std::bad_alloc
+	/// </para>
+	/// </summary>
+	/// <param name="size">字节数</param>
+	/// <param name="alignment">对齐边界，必须是 2 的整数次幂</param>
+	inline void* AlignedAlloc(size_t size, size_t alignment)
+	{
+		if (alignment < sizeof(void*))
+			alignment = sizeof(void*);
+		if (size == 0)
+			size = alignment;
+#ifdef _WIN32
+		auto p = _aligned_malloc(size, alignment);
+#else
+		void* p = nullptr;
+		if (posix_memalign(&p, alignment, size) != 0)
+			p = nullptr;
+#endif
+		if (p == nullptr)
+			throw std::bad_alloc();
+		return p;
+	}
+	/// <summary>
+	/// 释放由 AlignedAlloc 分配的内存
+	/// </summary>
+	inline void AlignedFree(void* p) noexcept
+	{
+#ifdef _WIN32
+		_aligned_free(p);
+#else
+		free(p);
+#endif
+	}
+
+	/// <summary>
+	/// 按 Alignment 字节对齐分配内存的 STL 分配器
+	/// </summary>
+	/// <typeparam name="T">元素类型</typeparam>
+	/// <typeparam name="Alignment">对齐边界，必须是 2 的整数次幂</typeparam>
+	template<typename T, size_t Alignment = 4096>
+	class AlignedAllocator
+	{
+		static_assert((Alignment & (Alignment - 1)) == 0, "Alignment must be a power of 2");
+	public:
+		using value_type = T;
+		template<typename U>
+		struct rebind { using other = AlignedAllocator<U, Alignment>; };
+	public:
+		AlignedAllocator() noexcept = default;
+		template<typename U>
+		AlignedAllocator(const AlignedAllocator<U, Alignment>&) noexcept {};
+	public:
+		T* allocate(size_t n)
+		{
+			if (n > static_cast<size_t>(-1) / sizeof(T))
+				throw std::bad_alloc();
+			return static_cast<T*>(AlignedAlloc(n * sizeof(T), Alignment));
+		}
+		void deallocate(T* p, size_t) noexcept { AlignedFree(p); }
+		template<typename U>
+		bool operator==(const AlignedAllocator<U, Alignment>&) const noexcept { return true; }
+		template<typename U>
+		bool operator!=(const AlignedAllocator<U, Alignment>&) const noexcept { return false; }
+	};
+
+	/// <summary>
+	/// 数据按 Alignment 字节对齐的 std::vector
+	/// </summary>
+	template<typename T, size_t Alignment = 4096>
+	using AlignedVector = std::vector<T, AlignedAllocator<T, Alignment>>;
+};
+
+/**
+@}
+*/
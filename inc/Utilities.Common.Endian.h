@@ -0,0 +1,186 @@
+/**
+	 @file
+	 @brief 通用模板库 字节序转换的实现
+
+	 这个文件里面是主机字节序与大端/小端字节序之间的转换函数
+	 单个数值的转换在编译期决定，与主机字节序相同时不产生任何代码；
+	 数组的批量转换在运行时选择 AVX2 / SSSE3 的字节重排指令，不支持时退回逐个元素转换
+
+	@code
+		auto magic = Common::ConvertEndian<Common::Endian::Big>(header.magic);
+
+		std::vector<uint32> samples = ...;
+		Common::ConvertEndianArray<Common::Endian::Big>(samples.data(), samples.size());
+	@endcode
+
+	 @author 司马坑
+	 @date 2026/10/17
+*/
+
+/**
+	@addtogroup Utilities_Common
+	@{
+*/
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#ifdef _MSC_VER
+#include <stdlib.h>
+#endif
+
+namespace Utilities::Common
+{
+	/// <summary>
+	/// 字节序
+	/// </summary>
+	enum class Endian
+	{
+		//! 小端字节序
+		Little,
+		//! 大端字节序
+		Big,
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+		//! 主机字节序
+		Native = Big
+#else
+		//! 主机字节序
+		Native = Little
+#endif
+	};
+
+	namespace _private
+	{
+		inline uint16_t ByteSwap16(uint16_t v)
+		{
+#ifdef _MSC_VER
+			return _byteswap_ushort(v);
+#else
+			return __builtin_bswap16(v);
+#endif
+		}
+		inline uint32_t ByteSwap32(uint32_t v)
+		{
+#ifdef _MSC_VER
+			return _byteswap_ulong(v);
+#else
+			return __builtin_bswap32(v);
+#endif
+		}
+		inline uint64_t ByteSwap64(uint64_t v)
+		{
+#ifdef _MSC_VER
+			return _byteswap_uint64(v);
+#else
+			return __builtin_bswap64(v);
+#endif
+		}
+	}
+
+	/// <summary>
+	/// 检查类型是否可以进行字节序转换
+	/// <para>
+	/// 只有长度为 1、2、4、8 字节的算术类型和枚举类型有确定的字节序
+	/// </para>
+	/// </summary>
+	template<typename T>
+	constexpr bool IsEndianConvertible = (std::is_arithmetic_v<T> || std::is_enum_v<T>) &&
+		(sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8);
+
+	/// <summary>
+	/// 反转数值的字节顺序
+	/// </summary>
+	/// <param name="value">数值</param>
+	template<typename T>
+	T ByteSwap(T value)
+	{
+		static_assert(IsEndianConvertible<T>, "Type must be an arithmetic or enum type of 1, 2, 4 or 8 bytes!");
+		if constexpr (sizeof(T) == 1)
+		{
+			return value;
+		}
+		else
+		{
+			using Bits = std::conditional_t<sizeof(T) == 2, uint16_t, std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>>;
+			Bits bits;
+			memcpy(&bits, &value, sizeof(T));
+			if constexpr (sizeof(T) == 2)
+				bits = _private::ByteSwap16(bits);
+			else if constexpr (sizeof(T) == 4)
+				bits = _private::ByteSwap32(bits);
+			else
+				bits = _private::ByteSwap64(bits);
+			memcpy(&value, &bits, sizeof(T));
+			return value;
+		}
+	}
+
+	/// <summary>
+	/// 在主机字节序与 Order 字节序之间转换数值
+	/// <para>
+	/// 转换是对称的，读取和写入都使用这个函数；Order 与主机字节序相同时直接返回
+	/// </para>
+	/// </summary>
+	/// <typeparam name="Order">数据的字节序</typeparam>
+	/// <param name="value">数值</param>
+	template<Endian Order, typename T>
+	T ConvertEndian(T value)
+	{
+		static_assert(IsEndianConvertible<T>, "Type must be an arithmetic or enum type of 1, 2, 4 or 8 bytes!");
+		if constexpr (Order == Endian::Native)
+			return value;
+		else
+			return ByteSwap(value);
+	}
+
+	/// <summary>
+	/// 反转 count 个长度为 elementSize 的元素各自的字节顺序，结果写入 dst
+	/// <para>
+	/// dst 与 src 可以是同一块内存，但不能部分重叠
+	/// </para>
+	/// <para>
+	/// elementSize 为 2、4、8 时使用 SIMD 字节重排指令批量处理
+	/// </para>
+	/// </summary>
+	/// <param name="dst">目标缓冲区</param>
+	/// <param name="src">源数据</param>
+	/// <param name="count">元素个数</param>
+	/// <param name="elementSize">每个元素的字节数</param>
+	void ByteSwapBuffer(void* dst, const void* src, size_t count, size_t elementSize);
+
+	/// <summary>
+	/// 原地反转数组中每一个元素的字节顺序
+	/// </summary>
+	/// <param name="data">数组</param>
+	/// <param name="count">元素个数</param>
+	template<typename T>
+	void ByteSwapArray(T* data, size_t count)
+	{
+		static_assert(IsEndianConvertible<T>, "Type must be an arithmetic or enum type of 1, 2, 4 or 8 bytes!");
+		if constexpr (sizeof(T) != 1)
+			ByteSwapBuffer(data, data, count, sizeof(T));
+	}
+
+	/// <summary>
+	/// 原地在主机字节序与 Order 字节序之间转换数组
+	/// <para>
+	/// Order 与主机字节序相同时不做任何事
+	/// </para>
+	/// </summary>
+	/// <typeparam name="Order">数据的字节序</typeparam>
+	/// <param name="data">数组</param>
+	/// <param name="count">元素个数</param>
+	template<Endian Order, typename T>
+	void ConvertEndianArray(T* data, size_t count)
+	{
+		static_assert(IsEndianConvertible<T>, "Type must be an arithmetic or enum type of 1, 2, 4 or 8 bytes!");
+		if constexpr (Order != Endian::Native)
+			ByteSwapArray(data, count);
+	}
+}
+
+/**
+@}
+*/
@@ -0,0 +1,172 @@
+/**
+	 @file
+	 @brief 通用模板库 文本格式化的实现
+
+	 这个文件里面是不经过 iostream 的数值格式化函数以及一个简单的 "{}" 格式化
+	 数值转换建立在 std::to_chars 之上：不查询区域设置，不分配堆内存，结果直接写入调用者提供的缓冲区
+
+	@code
+		char buf[Common::MaxNumberChars];
+		auto end = Common::FormatInt(buf, -42);			// "-42"
+		end = Common::FormatHex(buf, 0x414fa339u, 8);	// "414fa339"
+		end = Common::FormatFloat(buf, 0.1);			// "0.1"
+	@endcode
+
+	 @author 司马坑
+	 @date 2026/10/17
+*/
+
+/**
+	@addtogroup Utilities_Common
+	@{
+*/
+#pragma once
+#include "Utilities.h"
+
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace Utilities::Common
+{
+	//! 任意一个整数或浮点数格式化后的最大字符数
+	constexpr size_t MaxNumberChars = 32;
+
+	/// <summary>
+	/// 把整数格式化为十进制文本
+	/// </summary>
+	/// <param name="out">输出缓冲区，至少 MaxNumberChars 字节</param>
+	/// <param name="value">整数</param>
+	/// <returns>写入的最后一个字符之后的位置</returns>
+	template<typename T>
+	char* FormatInt(char* out, T value)
+	{
+		static_assert(std::is_integral_v<T> && !std::is_same_v<T, bool>, "Type must be an integer type!");
+		return std::to_chars(out, out + MaxNumberChars, value).ptr;
+	}
+
+	/// <summary>
+	/// 把整数格式化为十六进制文本
+	/// <para>
+	/// 负数按其二进制补码输出
+	/// </para>
+	/// </summary>
+	/// <param name="out">输出缓冲区，至少 MaxNumberChars 字节</param>
+	/// <param name="value">整数</param>
+	/// <param name="width">最小宽度，不足时在前面补 0 ，最大为 2 * sizeof(T)</param>
+	/// <param name="upper">是否使用大写字母</param>
+	/// <returns>写入的最后一个字符之后的位置</returns>
+	template<typename T>
+	char* FormatHex(char* out, T value, size_t width = 0, bool upper = false)
+	{
+		static_assert(std::is_integral_v<T> && !std::is_same_v<T, bool>, "Type must be an integer type!");
+		const char* digits = upper ? "0123456789ABCDEF" : "0123456789abcdef";
+		auto v = static_cast<std::make_unsigned_t<T>>(value);
+		char temp[sizeof(T) * 2];
+		size_t n = 0;
+		do
+		{
+			temp[sizeof(temp) - ++n] = digits[v & 0xF];
+			v = static_cast<decltype(v)>(v >> 4);
+		} while (v != 0);
+		if (width > sizeof(temp))
+			width = sizeof(temp);
+		for (; n < width; n++)
+			temp[sizeof(temp) - n - 1] = '0';
+		for (size_t i = 0; i < n; i++)
+			out[i] = temp[sizeof(temp) - n + i];
+		return out + n;
+	}
+
+	/// <summary>
+	/// 以能够精确还原的最短形式格式化浮点数
+	/// </summary>
+	/// <param name="out">输出缓冲区，至少 MaxNumberChars 字节</param>
+	/// <param name="value">浮点数</param>
+	/// <returns>写入的最后一个字符之后的位置</returns>
+	char* FormatFloat(char* out, double value);
+	/// <summary>
+	/// 以能够精确还原的最短形式格式化单精度浮点数
+	/// </summary>
+	char* FormatFloat(char* out, float value);
+	/// <summary>
+	/// 以固定的小数位数格式化浮点数
+	/// <para>
+	/// 结果超过 MaxNumberChars 时(例如非常大的数)改用科学计数法
+	/// </para>
+	/// </summary>
+	/// <param name="out">输出缓冲区，至少 MaxNumberChars 字节</param>
+	/// <param name="value">浮点数</param>
+	/// <param name="precision">小数位数</param>
+	/// <returns>写入的最后一个字符之后的位置</returns>
+	char* FormatFloat(char* out, double value, int precision);
+
+	/// <summary>
+	/// Format 的一个参数，保存参数的类型与值
+	/// </summary>
+	struct FormatArg
+	{
+		enum class Kind : uint8_t
+		{
+			None, Bool, Char, Int, UInt, Float, Double, String
+		};
+		struct StringRef
+		{
+			const char* data;
+			size_t size;
+		};
+		Kind kind = Kind::None;
+		union
+		{
+			bool b;
+			char c;
+			int64_t i;
+			uint64_t u;
+			float f;
+			double d;
+			StringRef s;
+		};
+
+		FormatArg() : u(0) { }
+		FormatArg(bool value) : kind(Kind::Bool), b(value) { }
+		FormatArg(char value) : kind(Kind::Char), c(value) { }
+		FormatArg(float value) : kind(Kind::Float), f(value) { }
+		FormatArg(double value) : kind(Kind::Double), d(value) { }
+		FormatArg(const char* value) : kind(Kind::String), s{ value, std::char_traits<char>::length(value) } { }
+		FormatArg(std::string_view value) : kind(Kind::String), s{ value.data(), value.size() } { }
+		FormatArg(const std::string& value) : kind(Kind::String), s{ value.data(), value.size() } { }
+		template<typename T, std::enable_if_t<std::is_integral_v<T> && std::is_signed_v<T>, int> = 0>
+		FormatArg(T value) : kind(Kind::Int), i(value) { }
+		template<typename T, std::enable_if_t<std::is_integral_v<T> && std::is_unsigned_v<T>, int> = 0>
+		FormatArg(T value) : kind(Kind::UInt), u(value) { }
+	};
+
+	/// <summary>
+	/// 接收格式化结果的回调，每次传入一段连续的文本
+	/// </summary>
+	using FormatOutput = void(*)(void* context, const char* data, size_t len);
+
+	/// <summary>
+	/// 按格式字符串格式化参数
+	/// <para>
+	/// 格式字符串中的 "{}" 依次被参数替换，"{{" 与 "}}" 输出花括号本身；
+	/// "{:x}" / "{:X}" 以十六进制输出整数，"{:.N}" 以 N 位小数输出浮点数
+	/// </para>
+	/// <para>
+	/// 结果先写入栈上的缓冲区，缓冲区满或格式化结束时才调用 output
+	/// </para>
+	/// </summary>
+	/// <param name="format">格式字符串</param>
+	/// <param name="args">参数</param>
+	/// <param name="count">参数个数</param>
+	/// <param name="output">接收结果的回调</param>
+	/// <param name="context">传给回调的上下文</param>
+	void FormatTo(std::string_view format, const FormatArg* args, size_t count, FormatOutput output, void* context);
+}
+
+/**
+@}
+*/
@@ -21,6 +21,11 @@
 	该模块包含了通用工具模板
 	- 工具列表
 		- Utilities::Common::Range
+		- Utilities::Common::Span
+		- Utilities::Common::AlignedAllocator
+		- Utilities::Common::ConvertEndian
+		- Utilities::Common::EncodeVarint
+		- Utilities::Common::FormatTo
 	@{
 */
 #pragma once
@@ -0,0 +1,40 @@
+/**
+	 @file
+	 @brief 通用模板库 字节查找的实现
+
+	 这个文件里面是在一段内存中查找指定字节的函数，作用与 memchr 相同
+	 在 x86 上每次比较 16 字节(SSE2)，支持 AVX2 时每次比较 64 字节，用比较掩码直接定位第一个命中的字节
+
+	@code
+		auto end = text + size;
+		auto eol = Common::FindByte(text, end, '\n');
+		if (eol != end)
+			...
+	@endcode
+
+	 @author 司马坑
+	 @date 2026/10/17
+*/
+
+/**
+	@addtogroup Utilities_Common
+	@{
+*/
+#pragma once
+#include <cstddef>
+
+namespace Utilities::Common
+{
+	/// <summary>
+	/// 在 [first, last) 中查找第一个等于 value 的字节
+	/// </summary>
+	/// <param name="first">起始位置</param>
+	/// <param name="last">结束位置</param>
+	/// <param name="value">要查找的字节</param>
+	/// <returns>第一个命中的位置，找不到时返回 last</returns>
+	const char* FindByte(const char* first, const char* last, char value);
+}
+
+/**
+@}
+*/
@@ -0,0 +1,124 @@
+/**
+	 @file
+	 @brief 通用模板库 Span 对象的实现
+
+	 这个文件里面是通用模板库 Span 对象的实现
+	 Span 是对一段连续内存的非占有式引用，其行为与 C++20 中的 std::span 相似
+	 用于在不发生复制的情况下把缓冲区交给其他模块使用
+
+	@code
+		MemoryStream ms;
+		// ... 写入数据
+		auto view = ms.View();
+		Encryption::CRC32 crc(view.data(), view.size());
+	@endcode
+
+	 @author 司马坑
+	 @date 2026/10/17
+*/
+
+/**
+	@addtogroup Utilities_Common
+	@{
+*/
+#pragma once
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+namespace Utilities::Common
+{
+	/**
+		例子：
+		@code
+			std::vector<float> v(100);
+			Span<float> s = v;
+			for(auto& f : s)
+			{
+				// ...  do things
+			}
+		@endcode
+	*/
+	/// <summary>
+	/// 连续内存视图 Span
+	/// <para>
+	/// 该对象不持有内存，使用者需要保证其引用的内存在 Span 的生命周期内有效
+	/// </para>
+	/// </summary>
+	/// <typeparam name="T">元素类型</typeparam>
+	template<typename T>
+	class Span
+	{
+	private:
+		T* _data = nullptr;
+		size_t _size = 0;
+	public:
+		using value_type = std::remove_cv_t<T>;
+		using element_type = T;
+		using iterator = T*;
+		using const_iterator = const T*;
+	public:
+		Span() = default;
+		~Span() = default;
+		/// <summary>
+		/// 使用指针和元素个数构造一个 Span
+		/// </summary>
+		/// <param name="data">首元素地址</param>
+		/// <param name="size">元素个数</param>
+		Span(T* data, size_t size) : _data(data), _size(size) {};
+		/// <summary>
+		/// 使用数组构造一个 Span
+		/// </summary>
+		template<size_t N>
+		Span(T(&arr)[N]) : _data(arr), _size(N) {};
+		/// <summary>
+		/// 使用 std::vector 构造一个 Span
+		/// </summary>
+		template<typename U, typename A, typename = std::enable_if_t<std::is_same_v<std::remove_cv_t<T>, U>>>
+		Span(std::vector<U, A>& v) : _data(v.data()), _size(v.size()) {};
+		/// <summary>
+		/// 使用 const std::vector 构造一个只读 Span
+		/// </summary>
+		template<typename U, typename A, typename = std::enable_if_t<std::is_const_v<T> && std::is_same_v<std::remove_cv_t<T>, U>>>
+		Span(const std::vector<U, A>& v) : _data(v.data()), _size(v.size()) {};
+		/// <summary>
+		/// 由 Span&lt;T&gt; 隐式转换为 Span&lt;const T&gt;
+		/// </summary>
+		template<typename U, typename = std::enable_if_t<std::is_same_v<const U, T>>>
+		Span(const Span<U>& rhs) : _data(rhs.data()), _size(rhs.size()) {};
+	public:
+		//! 首元素地址
+		T* data() const { return _data; }
+		//! 元素个数
+		size_t size() const { return _size; }
+		//! 以字节为单位的长度
+		size_t size_bytes() const { return _size * sizeof(T); }
+		//! 是否为空
+		bool empty() const { return _size == 0; }
+		//! 指向首元素的迭代器
+		T* begin() const { return _data; }
+		//! 指向尾后元素的迭代器
+		T* end() const { return _data + _size; }
+		//! 访问第 i 个元素
+		T& operator[](size_t i) const { return _data[i]; }
+		/// <summary>
+		/// 取该 Span 的一个子区间 [ offset , offset + count )
+		/// <para>
+		/// 超出范围的部分会被截断
+		/// </para>
+		/// </summary>
+		/// <param name="offset">起始位置</param>
+		/// <param name="count">元素个数</param>
+		Span SubSpan(size_t offset, size_t count = static_cast<size_t>(-1)) const
+		{
+			if (offset > _size)
+				offset = _size;
+			if (count > _size - offset)
+				count = _size - offset;
+			return Span(_data + offset, count);
+		}
+	};
+};
+
+/**
+@}
+*/
@@ -0,0 +1,128 @@
+/**
+	 @file
+	 @brief 通用模板库 变长整数编码的实现
+
+	 这个文件里面是无符号 LEB128 变长整数以及有符号整数的 zigzag 映射
+	 每个字节保存 7 位数据，最高位为 1 表示后面还有字节，小的数值只占用 1 到 2 个字节
+
+	@code
+		uint8 buffer[Common::MaxVarintLength];
+		auto len = Common::EncodeVarint(Common::ToVarint<int32>(-3), buffer);	// len == 1
+
+		uint64 values[256];
+		size_t consumed;
+		auto n = Common::DecodeVarints(data, size, values, 256, consumed);
+	@endcode
+
+	 @author 司马坑
+	 @date 2026/10/17
+*/
+
+/**
+	@addtogroup Utilities_Common
+	@{
+*/
+#pragma once
+#include "Utilities.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+namespace Utilities::Common
+{
+	//! 一个 64 位变长整数编码后的最大字节数
+	constexpr size_t MaxVarintLength = 10;
+
+	/// <summary>
+	/// 把有符号整数映射为无符号整数，绝对值小的负数也映射为小的数值
+	/// <para>
+	/// 0, -1, 1, -2, 2 ... 依次映射为 0, 1, 2, 3, 4 ...
+	/// </para>
+	/// </summary>
+	constexpr uint64_t ZigZagEncode(int64_t value)
+	{
+		return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+	}
+	/// <summary>
+	/// ZigZagEncode 的逆变换
+	/// </summary>
+	constexpr int64_t ZigZagDecode(uint64_t value)
+	{
+		return static_cast<int64_t>((value >> 1) ^ (~(value & 1) + 1));
+	}
+
+	/// <summary>
+	/// 把整数转换为待编码的无符号数值，有符号整数使用 zigzag 映射
+	/// </summary>
+	template<typename T>
+	constexpr uint64_t ToVarint(T value)
+	{
+		static_assert(std::is_integral_v<T> && !std::is_same_v<T, bool>, "Type must be an integer type!");
+		if constexpr (std::is_signed_v<T>)
+			return ZigZagEncode(static_cast<int64_t>(value));
+		else
+			return static_cast<uint64_t>(value);
+	}
+	/// <summary>
+	/// 把解码得到的无符号数值转换回整数，超出 T 的表示范围时抛出异常
+	/// </summary>
+	template<typename T>
+	T FromVarint(uint64_t value)
+	{
+		static_assert(std::is_integral_v<T> && !std::is_same_v<T, bool>, "Type must be an integer type!");
+		if constexpr (std::is_signed_v<T>)
+		{
+			auto v = ZigZagDecode(value);
+			if (v < static_cast<int64_t>(std::numeric_limits<T>::min()) || v > static_cast<int64_t>(std::numeric_limits<T>::max()))
+				throw Exception(u8"Error occured when decoding varint : Value_Out_Of_Range");
+			return static_cast<T>(v);
+		}
+		else
+		{
+			if (value > static_cast<uint64_t>(std::numeric_limits<T>::max()))
+				throw Exception(u8"Error occured when decoding varint : Value_Out_Of_Range");
+			return static_cast<T>(value);
+		}
+	}
+
+	/// <summary>
+	/// 以 LEB128 编码一个无符号整数
+	/// </summary>
+	/// <param name="value">数值</param>
+	/// <param name="out">输出缓冲区，至少 MaxVarintLength 字节</param>
+	/// <returns>编码后的字节数</returns>
+	inline size_t EncodeVarint(uint64_t value, uint8_t* out)
+	{
+		size_t n = 0;
+		while (value >= 0x80)
+		{
+			out[n++] = static_cast<uint8_t>(value) | 0x80;
+			value >>= 7;
+		}
+		out[n++] = static_cast<uint8_t>(value);
+		return n;
+	}
+
+	/// <summary>
+	/// 批量解码 LEB128 编码的无符号整数
+	/// <para>
+	/// 在末尾遇到不完整的编码时停止，不完整的部分不计入 consumed ，补齐数据后可以从该处继续解码
+	/// </para>
+	/// <para>
+	/// 超过 MaxVarintLength 字节或超出 64 位范围的编码会抛出异常
+	/// </para>
+	/// </summary>
+	/// <param name="src">编码数据</param>
+	/// <param name="len">编码数据长度</param>
+	/// <param name="out">解码结果</param>
+	/// <param name="count">最多解码的个数</param>
+	/// <param name="consumed">返回已解码的数据占用的字节数</param>
+	/// <returns>解码得到的整数个数</returns>
+	size_t DecodeVarints(const uint8_t* src, size_t len, uint64_t* out, size_t count, size_t& consumed);
+}
+
+/**
+@}
+*/
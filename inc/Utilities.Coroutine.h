@@ -0,0 +1,230 @@
+/**
+ @file
+ @brief 通用协程库 Task 与 Executor 接口定义
+
+ 仅在编译器支持 C++20 协程时可用
+
+ @author 司马坑
+ @date 2026/10/17
+*/
+#pragma once
+#include "Utilities.h"
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+#define UTILITIES_HAS_COROUTINE 1
+
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <utility>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+
+namespace Utilities::Coroutine
+{
+	template<typename T>
+	class Task;
+
+	namespace _private
+	{
+		/// <summary>
+		/// Task 结束时把控制权交还给等待它的协程
+		/// </summary>
+		struct FinalAwaiter
+		{
+			bool await_ready() noexcept { return false; }
+			template<typename Promise>
+			std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept
+			{
+				auto continuation = handle.promise().continuation;
+				return continuation ? continuation : std::noop_coroutine();
+			}
+			void await_resume() noexcept { }
+		};
+
+		struct PromiseBase
+		{
+			std::coroutine_handle<> continuation;
+			std::exception_ptr error;
+
+			std::suspend_always initial_suspend() noexcept { return {}; }
+			FinalAwaiter final_suspend() noexcept { return {}; }
+			void unhandled_exception() noexcept { error = std::current_exception(); }
+		};
+
+		template<typename T>
+		struct Promise : PromiseBase
+		{
+			std::optional<T> value;
+
+			Task<T> get_return_object() noexcept;
+			template<typename U>
+			void return_value(U&& v) { value.emplace(std::forward<U>(v)); }
+			T Result()
+			{
+				if (error)
+					std::rethrow_exception(error);
+				return std::move(*value);
+			}
+		};
+
+		template<>
+		struct Promise<void> : PromiseBase
+		{
+			Task<void> get_return_object() noexcept;
+			void return_void() noexcept { }
+			void Result()
+			{
+				if (error)
+					std::rethrow_exception(error);
+			}
+		};
+	}
+
+	/**
+		使用方式：
+		@code
+			Task<int> Answer() { co_return 42; }
+			Task<void> Main()
+			{
+				int v = co_await Answer();
+			}
+		@endcode
+	*/
+	/// <summary>
+	/// 惰性启动的协程任务
+	/// <para>
+	/// 创建时不执行，被 co_await 或交给 Executor::Spawn 时才开始执行；
+	/// 结束时直接恢复等待它的协程，不经过调度器
+	/// </para>
+	/// </summary>
+	/// <typeparam name="T">返回值类型</typeparam>
+	template<typename T = void>
+	class Task
+	{
+	public:
+		using promise_type = _private::Promise<T>;
+	public:
+		Task() = default;
+		explicit Task(std::coroutine_handle<promise_type> handle) : handle(handle) { }
+		Task(Task&& other) noexcept : handle(std::exchange(other.handle, nullptr)) { }
+		Task& operator=(Task&& other) noexcept
+		{
+			if (this != &other)
+			{
+				if (handle)
+					handle.destroy();
+				handle = std::exchange(other.handle, nullptr);
+			}
+			return *this;
+		}
+		Task(const Task&) = delete;
+		Task& operator=(const Task&) = delete;
+		~Task()
+		{
+			if (handle)
+				handle.destroy();
+		}
+	public:
+		bool await_ready() const noexcept { return !handle || handle.done(); }
+		std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept
+		{
+			handle.promise().continuation = awaiting;
+			return handle;
+		}
+		T await_resume() { return handle.promise().Result(); }
+	private:
+		std::coroutine_handle<promise_type> handle;
+	};
+
+	namespace _private
+	{
+		template<typename T>
+		inline Task<T> Promise<T>::get_return_object() noexcept
+		{
+			return Task<T>(std::coroutine_handle<Promise<T>>::from_promise(*this));
+		}
+		inline Task<void> Promise<void>::get_return_object() noexcept
+		{
+			return Task<void>(std::coroutine_handle<Promise<void>>::from_promise(*this));
+		}
+	}
+
+	/**
+		使用方式：
+		@code
+			Executor ex;
+			for (auto& asset : assets)
+				ex.Spawn(LoadAsset(ex, asset));
+			ex.Run();	// 所有任务结束后返回，任务抛出的第一个异常在这里重新抛出
+		@endcode
+	*/
+	/// <summary>
+	/// 最小化的协程调度器
+	/// <para>
+	/// 维护一个待恢复协程与待执行任务的队列，由调用 Run 的线程依次执行；
+	/// Post 可以在任意线程上调用，IO 完成回调借此把协程或后续工作交还给调度器。
+	/// 多个线程可以同时调用 Run，共同消化同一个队列
+	/// </para>
+	/// </summary>
+	class Executor
+	{
+	public:
+		Executor() = default;
+		Executor(const Executor&) = delete;
+		Executor& operator=(const Executor&) = delete;
+	public:
+		/// <summary>
+		/// 把一个挂起的协程放入队列
+		/// </summary>
+		/// <param name="handle">协程句柄</param>
+		void Post(std::coroutine_handle<> handle);
+		/// <summary>
+		/// 把一个任务放入队列，由调用 Run 的线程执行
+		/// <para>
+		/// 任务不计入 Run 等待结束的任务，只能在有任务尚未结束时使用
+		/// </para>
+		/// </summary>
+		/// <param name="work">要执行的任务，不能抛出异常</param>
+		void Post(std::function<void()> work);
+		/// <summary>
+		/// 启动一个任务，任务由调度器持有直至结束
+		/// </summary>
+		/// <param name="task">任务</param>
+		void Spawn(Task<void> task);
+		/// <summary>
+		/// 恢复队列中的协程，直至所有通过 Spawn 启动的任务结束
+		/// </summary>
+		void Run();
+		/// <summary>
+		/// 让出执行权，协程重新排到队列末尾
+		/// <para>
+		/// 用法： co_await ex.Schedule();
+		/// </para>
+		/// </summary>
+		auto Schedule()
+		{
+			struct Awaiter
+			{
+				Executor& ex;
+				bool await_ready() const noexcept { return false; }
+				void await_suspend(std::coroutine_handle<> handle) { ex.Post(handle); }
+				void await_resume() const noexcept { }
+			};
+			return Awaiter{ *this };
+		}
+	private:
+		struct Detached;
+		static Detached Drive(Executor& ex, Task<void> task);
+		void Finish(std::exception_ptr error);
+	private:
+		std::mutex lock;
+		std::condition_variable ready;
+		std::deque<std::function<void()>> queue;
+		size_t running = 0;
+		std::exception_ptr firstError;
+	};
+}
+#endif
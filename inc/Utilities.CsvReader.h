@@ -0,0 +1,109 @@
+/**
+ @file
+ @brief 通用IO库 CSV / TSV 读取器接口定义
+
+ @author 司马坑
+ @date 2026/10/17
+*/
+#pragma once
+#include "Utilities.Stream.h"
+#include "Utilities.Common.Span.h"
+
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace Utilities
+{
+	/**
+		使用方式：
+		@code
+			FileStream fs(L"export.csv", Stream::Type::ReadOnly, false);
+			CsvReader csv(fs);
+			while (auto row = csv.ReadRow())
+			{
+				for (auto field : *row)
+					Consume(field);
+			}
+
+			// TSV 文件通常不使用引号
+			CsvReader tsv(fs, '\t', '\0');
+		@endcode
+	*/
+	/// <summary>
+	/// CSV / TSV 读取器
+	/// <para>
+	/// 逐行从流中读取并拆分字段，按 RFC 4180 处理引号：以引号开头的字段可以包含分隔符与换行符，
+	/// 字段中的两个连续引号表示一个引号字符；行以 "\n" 或 "\r\n" 结束
+	/// </para>
+	/// <para>
+	/// 与 RFC 4180 一致，引号只能出现在字段开头或引号字段内部；未加引号的字段中出现引号时，其后的字段边界无法正确识别
+	/// </para>
+	/// <para>
+	/// 每次以 64 字节为一块，用 SIMD 比较得到引号、分隔符与换行符的位掩码，
+	/// 由引号掩码的前缀异或得到引号内的区域，剩下的分隔符与换行符逐位取出即为字段边界
+	/// </para>
+	/// <para>
+	/// 返回的字段是指向读取器内部缓冲区的视图，在下一次调用 ReadRow 前有效；
+	/// 带引号的字段在缓冲区中原地去掉引号，缓冲区与字段数组在读取过程中重复使用，稳定后每行不再分配内存
+	/// </para>
+	/// </summary>
+	class CsvReader
+	{
+	public:
+		/// <summary>
+		/// 在流上创建读取器
+		/// <para>
+		/// 读取器会预读数据，流的生命周期必须长于读取器，读取过程中不要再直接读取流
+		/// </para>
+		/// </summary>
+		/// <param name="stream">要读取的流</param>
+		/// <param name="delimiter">字段分隔符，TSV 使用 '\t'</param>
+		/// <param name="quote">引号字符，为 '\0' 时不处理引号</param>
+		CsvReader(Stream& stream, char delimiter = ',', char quote = '"');
+		CsvReader(const CsvReader&) = delete;
+		CsvReader& operator=(const CsvReader&) = delete;
+	public:
+		/// <summary>
+		/// 读取下一行
+		/// <para>
+		/// 空行返回只有一个空字段的行；最后一行可以没有换行符；
+		/// 流结束时仍在引号内则抛出异常
+		/// </para>
+		/// </summary>
+		/// <returns>该行的字段；流已结束时返回 std::nullopt</returns>
+		std::optional<Common::Span<const std::string_view>> ReadRow();
+		/// <summary>
+		/// 获取已读取的行数
+		/// </summary>
+		uint64_t GetRowCount() const { return rows; }
+	private:
+		void Refill();
+		void ClassifyBlock();
+		void EndField(size_t end, bool lastInRow);
+		Common::Span<const std::string_view> MakeRow();
+	private:
+		Stream& stream;
+		char delimiter;
+		char quote;
+		//! 缓冲区有效数据为 [head, tail)，末尾多分配 64 字节以便整块加载
+		std::vector<char> buffer;
+		size_t head = 0;
+		size_t tail = 0;
+		//! 当前行的字段开始位置
+		size_t fieldStart = 0;
+		//! 下一个待分类的块的开始位置
+		size_t next = 0;
+		//! 最近分类的块的开始位置
+		size_t block = 0;
+		//! 该块中尚未处理的字段边界，第 i 位对应 block + i
+		uint64_t structural = 0;
+		//! 该块中换行符的位置，用于区分字段边界是分隔符还是行尾
+		uint64_t newlines = 0;
+		//! 已分类的数据末尾是否处在引号内
+		bool inQuote = false;
+		bool eof = false;
+		uint64_t rows = 0;
+		std::vector<std::string_view> fields;
+	};
+}
@@ -0,0 +1,140 @@
+/**
+ @file
+ @brief 通用IO库 直接IO文件流接口定义
+
+ @author 司马坑
+ @date 2026/10/17
+*/
+#pragma once
+#include "Utilities.Stream.h"
+
+#include <cstdint>
+
+namespace Utilities
+{
+	/**
+		使用方式：
+		@code
+			// 导出大文件时不经过页缓存，不会挤掉其他服务的热数据
+			DirectFileStream fs(L"export.bin", Stream::Type::WriteOnly);
+			auto sw = StreamWriter(fs);
+			sw.Write<uint32_t>(magic);
+			sw.WriteArray(records);
+
+			// 按 Alignment 对齐且不小于缓冲区大小的数据直接写入文件，不经过内部缓冲区
+			Common::AlignedVector<uint8> block(DirectFileStream::DefaultBufferSize);
+			fs.Write(block.size(), block.data());
+			fs.Close();
+		@endcode
+	*/
+	/// <summary>
+	/// 直接IO文件流对象
+	/// <para>
+	/// Linux 下以 O_DIRECT 打开文件，Windows 下使用 FILE_FLAG_NO_BUFFERING ，数据不经过操作系统的页缓存，
+	/// 适合大块的一次性顺序读写
+	/// </para>
+	/// <para>
+	/// 直接IO要求地址、偏移量、长度均按扇区对齐，流内部维护一个对齐的缓冲区处理不对齐的头尾部分，
+	/// 因此可以像普通的流一样以任意长度读写；写出时不足一个扇区的尾部以 0 填充，在 Flush 或 Close 时截断回实际长度
+	/// </para>
+	/// <para>
+	/// 文件系统不支持直接IO时(例如 tmpfs)退化为普通的带缓存IO，可以通过 IsDirect 查询
+	/// </para>
+	/// </summary>
+	class DirectFileStream final : public Stream
+	{
+	public:
+		//! 地址、偏移量以及长度的对齐要求
+		static constexpr size_t Alignment = 4096;
+		//! 缺省的内部缓冲区大小
+		static constexpr size_t DefaultBufferSize = 1024 * 1024;
+	public:
+		/// <summary>
+		/// 以直接IO方式打开一个文件
+		/// </summary>
+		/// <param name="fileName">文件名</param>
+		/// <param name="ioType">操作类型 以 Type::WriteOnly 打开时清空文件，以 Type::ReadWrite 打开不存在的文件时会创建该文件</param>
+		/// <param name="bufferSize">内部缓冲区大小，向上取整到 Alignment 的整数倍</param>
+		DirectFileStream(const wchar_t* fileName, const Type& ioType, size_t bufferSize = DefaultBufferSize);
+		/// <summary>
+		/// 析构函数 写出缓冲区中剩余的数据并关闭文件
+		/// </summary>
+		virtual ~DirectFileStream();
+	public:
+		/// <summary>
+		/// 流对象读取接口
+		/// </summary>
+		/// <param name="len">要读取的数据长度</param>
+		/// <param name="data">数据写入的目标缓冲区</param>
+		virtual void Read(size_t len, void* data) override;
+		/// <summary>
+		/// 流对象写入接口
+		/// </summary>
+		/// <param name="len">要写入的数据长度</param>
+		/// <param name="data">数据</param>
+		virtual void Write(size_t len, const void* data) override;
+		/// <summary>
+		/// 写出剩余数据并关闭流对象
+		/// </summary>
+		virtual void Close() override;
+		/// <summary>
+		/// 检测流对象是否可用
+		/// </summary>
+		virtual bool IsVaild() override;
+		/// <summary>
+		/// 读取至多 maxLen 字节的数据
+		/// </summary>
+		/// <param name="maxLen">最多读取的数据长度</param>
+		/// <param name="data">数据写入的目标缓冲区</param>
+		/// <returns>实际读取的数据长度</returns>
+		virtual size_t ReadSome(size_t maxLen, void* data) override;
+		/// <summary>
+		/// 写出缓冲区中的数据，并把文件截断回实际长度
+		/// </summary>
+		virtual void Flush() override;
+	public:
+		/// <summary>
+		/// 获取文件的长度
+		/// </summary>
+		virtual uint64_t GetLength() override;
+		/// <summary>
+		/// 获取当前读写指针的位置
+		/// </summary>
+		virtual uint64_t GetPosition() override;
+		/// <summary>
+		/// 设置当前读写指针的位置
+		/// </summary>
+		/// <param name="pos"></param>
+		virtual void SetPosition(uint64_t pos) override;
+		/// <summary>
+		/// 移动当前读写指针的位置
+		/// </summary>
+		/// <param name="offset">偏移量</param>
+		virtual void Seek(int64_t offset) override;
+	public:
+		/// <summary>
+		/// 文件是否确实以直接IO方式打开
+		/// </summary>
+		bool IsDirect() const { return direct; }
+	private:
+		void LoadWindow(uint64_t pos);
+		void FlushWindow();
+		bool CanBypass(const void* data, size_t len) const;
+	private:
+		//! 文件描述符，Windows 下为文件句柄
+		intptr_t file = -1;
+		bool direct = false;
+		uint8* buffer = nullptr;
+		size_t bufferSize = 0;
+		//! 缓冲区对应的文件位置，总是按 Alignment 对齐
+		uint64_t bufferOffset = 0;
+		//! 缓冲区中有效数据的长度
+		size_t bufferValid = 0;
+		//! 缓冲区中有尚未写出的数据
+		bool dirty = false;
+		//! 文件尾部写入了填充数据，需要截断
+		bool padded = false;
+		uint64_t length = 0;
+		uint64_t position = 0;
+	};
+}
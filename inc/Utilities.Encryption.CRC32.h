@@ -15,10 +15,10 @@
 
 
 #pragma once
+#include "Utilities.Common.Format.h"
+
 #include <numeric>
 #include <string>
-#include <sstream>
-#include <iomanip>
 #include <algorithm>
 #include <locale>
 #include <cctype>
@@ -107,9 +107,9 @@ namespace Utilities::Encryption
 				/// </summary>
 				explicit operator std::string()
 				{
-					std::ostringstream res;
-					res << std::hex << std::setfill('0') << std::setw(8) << HashData;
-					return res.str();
+					char res[sizeof(HashType) * 2];
+					Common::FormatHex(res, HashData, sizeof(res));
+					return std::string(res, sizeof(res));
 				}
 
 				/// <summary>
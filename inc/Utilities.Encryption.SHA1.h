@@ -14,12 +14,12 @@
 */
 
 #pragma once
+#include "Utilities.Common.Format.h"
+
 #include <string>
 #include <numeric>
 #include <algorithm>
 #include <locale>
-#include <iomanip>
-#include <sstream>
 
 namespace Utilities::Encryption
 {
@@ -92,9 +92,10 @@ namespace Utilities::Encryption
 				{
 					uint32_t data[5] = { 0 };
 					memcpy(data, HashData, sizeof(uint32_t[5]));
-					std::ostringstream result;
-					for (const auto& i : data) result << std::hex << std::setfill('0') << std::setw(8) << i;
-					return result.str();
+					char result[40];
+					for (size_t i = 0; i < 5; i++)
+						Common::FormatHex(result + i * 8, data[i], 8);
+					return std::string(result, sizeof(result));
 				}
 
 				/// <summary>
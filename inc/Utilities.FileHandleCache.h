@@ -0,0 +1,195 @@
+/**
+ @file
+ @brief 通用IO库 文件句柄缓存接口定义
+
+ @author 司马坑
+ @date 2026/10/17
+*/
+#pragma once
+#include "Utilities.FileStream.h"
+
+#include <atomic>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Utilities
+{
+	/**
+		使用方式：
+		@code
+			// 最多同时打开 256 个文件
+			FileHandleCache cache(256);
+
+			for (auto& request : requests)
+			{
+				// 热点文件直接复用已打开的文件流，不再调用 open / close
+				auto lease = cache.Acquire(request.path.c_str(), Stream::Type::ReadOnly, false);
+				lease->ReadAt(request.offset, request.size, buffer);
+			}
+
+			auto statistics = cache.GetStatistics();
+		@endcode
+	*/
+	/// <summary>
+	/// 文件句柄缓存对象
+	/// <para>
+	/// 以文件名、操作类型与文本模式为键缓存已打开的 FileStream ，租借归还后保持打开，下次租借同一个键时直接复用；
+	/// 打开的文件流总数超过容量时按最近最少使用的顺序关闭空闲的文件流
+	/// </para>
+	/// <para>
+	/// 每个文件流同一时间只租借给一个调用者；同一个键的文件流都被租借出去时会再打开一个新的文件流。
+	/// 所有文件流都被租借出去时总数可以暂时超过容量，多出的文件流在归还时关闭
+	/// </para>
+	/// <para>
+	/// 复用的文件流在租借时把读写指针移到文件开头，与新打开的文件流一致；
+	/// 以 Stream::Type::WriteOnly 打开的文件流在打开时截断文件，不能复用，归还时直接关闭。
+	/// 文件被删除或改名后应调用 Invalidate 关闭对应的空闲文件流
+	/// </para>
+	/// <para>
+	/// 可以在多个线程中同时租借与归还；打开与关闭文件都在锁外进行
+	/// </para>
+	/// </summary>
+	class FileHandleCache
+	{
+		struct Entry;
+	public:
+		//! 缺省的容量
+		static constexpr size_t DefaultCapacity = 64;
+
+		/// <summary>
+		/// 缓存的统计结果
+		/// </summary>
+		struct Statistics
+		{
+			uint64_t hits = 0;		//!< 复用已打开的文件流的次数
+			uint64_t misses = 0;	//!< 打开新文件流的次数
+			uint64_t evictions = 0;	//!< 因超过容量而关闭的文件流个数
+		};
+
+		/// <summary>
+		/// 租借的文件流，析构时归还给缓存
+		/// </summary>
+		class Lease
+		{
+			friend class FileHandleCache;
+		public:
+			Lease() = default;
+			Lease(Lease&& rhs) noexcept;
+			Lease& operator=(Lease&& rhs) noexcept;
+			Lease(const Lease&) = delete;
+			Lease& operator=(const Lease&) = delete;
+			~Lease();
+		public:
+			FileStream& operator*() const { return *entry->stream; }
+			FileStream* operator->() const { return entry->stream.get(); }
+			/// <summary>
+			/// 获取租借的文件流
+			/// </summary>
+			FileStream& Get() const { return *entry->stream; }
+			/// <summary>
+			/// 立即归还文件流，之后该对象不再持有文件流
+			/// </summary>
+			void Release();
+		private:
+			Lease(FileHandleCache* cache, std::unique_ptr<Entry> entry) : cache(cache), entry(std::move(entry)) { }
+		private:
+			FileHandleCache* cache = nullptr;
+			std::unique_ptr<Entry> entry;
+		};
+	public:
+		/// <summary>
+		/// 创建文件句柄缓存
+		/// </summary>
+		/// <param name="capacity">同时打开的文件流个数上限，至少为 1</param>
+		FileHandleCache(size_t capacity = DefaultCapacity);
+		FileHandleCache(const FileHandleCache&) = delete;
+		FileHandleCache& operator=(const FileHandleCache&) = delete;
+		/// <summary>
+		/// 析构函数
+		/// <para>
+		/// 关闭所有空闲的文件流，所有租借必须在此之前归还
+		/// </para>
+		/// </summary>
+		~FileHandleCache();
+	public:
+		/// <summary>
+		/// 租借一个文件流，参数与 FileStream 的构造函数相同
+		/// <para>
+		/// 有空闲的同键文件流时把读写指针移到文件开头后返回，否则打开一个新的文件流，打开失败时抛出异常
+		/// </para>
+		/// </summary>
+		/// <param name="fileName">文件名</param>
+		/// <param name="ioType">操作类型</param>
+		/// <param name="isTextMode">是否以文本模式打开</param>
+		Lease Acquire(const wchar_t* fileName, Stream::Type ioType, bool isTextMode = true);
+		/// <summary>
+		/// 关闭指定文件的所有空闲文件流，已租借的文件流在归还时关闭
+		/// </summary>
+		/// <param name="fileName">文件名</param>
+		void Invalidate(const wchar_t* fileName);
+		/// <summary>
+		/// 关闭所有空闲的文件流，不影响统计结果
+		/// </summary>
+		void Clear();
+	public:
+		/// <summary>
+		/// 获取容量
+		/// </summary>
+		size_t GetCapacity() const { return capacity; }
+		/// <summary>
+		/// 获取当前打开的文件流个数，包括已租借的
+		/// </summary>
+		size_t GetOpenCount();
+		/// <summary>
+		/// 获取到目前为止的统计结果
+		/// </summary>
+		Statistics GetStatistics() const;
+	private:
+		struct Key
+		{
+			std::wstring fileName;
+			Stream::Type ioType;
+			bool isTextMode;
+			bool operator==(const Key& rhs) const { return fileName == rhs.fileName && ioType == rhs.ioType && isTextMode == rhs.isTextMode; }
+		};
+		struct KeyHash
+		{
+			size_t operator()(const Key& key) const;
+		};
+		struct Entry
+		{
+			Key key;
+			std::unique_ptr<FileStream> stream;
+			//! 租借期间对该文件调用过 Invalidate ，归还时关闭
+			uint64_t generation = 0;
+		};
+		using LruList = std::list<std::unique_ptr<Entry>>;
+		/// <summary>
+		/// 归还一个文件流，只写、超过容量或已失效时关闭
+		/// </summary>
+		void Return(std::unique_ptr<Entry> entry);
+		/// <summary>
+		/// 从空闲列表中移除 it ，返回其中的文件流以便在锁外关闭
+		/// </summary>
+		std::unique_ptr<Entry> Remove(LruList::iterator it);
+	private:
+		size_t capacity;
+
+		std::mutex mutex;
+		//! 空闲的文件流，最近归还的在前面
+		LruList lru;
+		//! 每个键对应的空闲文件流
+		std::unordered_map<Key, std::vector<LruList::iterator>, KeyHash> idle;
+		//! 每个文件的 Invalidate 次数，只记录调用过的文件
+		std::unordered_map<std::wstring, uint64_t> generations;
+		size_t openCount = 0;
+
+		std::atomic<uint64_t> hits{ 0 };
+		std::atomic<uint64_t> misses{ 0 };
+		std::atomic<uint64_t> evictions{ 0 };
+	};
+}
@@ -8,10 +8,27 @@
 #pragma once
 #include "Utilities.Stream.h"
 
+#include <future>
+#ifdef _WIN32
+#include <mutex>
+#endif
+
 namespace Utilities
 {
+	/**
+		多线程随机读取：
+		@code
+			FileStream fs(L"assets.pak", Stream::Type::ReadOnly, false);
+			// 各个线程使用自己的偏移量，互不影响，也不改变 fs 的读写指针
+			fs.ReadAt(entry.offset, entry.size, buffer);
+		@endcode
+	*/
 	/// <summary>
 	/// 文件流对象
+	/// <para>
+	/// Windows 下建立在 C 运行库的 FILE* 之上；其他平台上直接使用文件描述符，
+	/// 没有用户态缓冲，大量小块读写时应配合 BufferedStream 使用
+	/// </para>
 	/// </summary>
 	class FileStream : public Stream
 	{
@@ -20,7 +37,7 @@ namespace Utilities
 		/// 实例化一个文件流对象以访问文件
 		/// </summary>
 		/// <param name="fileName">文件名</param>
-		/// <param name="ioType">操作类型</param>
+		/// <param name="ioType">操作类型 以 Type::ReadWrite 打开不存在的文件时会创建该文件</param>
 		/// <param name="IstextMode">是否以文本模式打开</param>
 		FileStream(const wchar_t* fileName, const Type& ioType, bool IstextMode = true);
 		/// <summary>
@@ -41,6 +58,26 @@ namespace Utilities
 		/// <param name="data">数据</param>
 		virtual void Write(size_t len, const void* data) override;
 		/// <summary>
+		/// 分散读取接口
+		/// <para>
+		/// 非 Windows 平台上从当前读写指针处循环调用 readv ，每次至多 IOV_MAX 个缓冲区，直到读满所有缓冲区；
+		/// 不足时抛出异常。Windows 下依次读取每个缓冲区
+		/// </para>
+		/// </summary>
+		/// <param name="count">缓冲区个数</param>
+		/// <param name="segments">缓冲区数组</param>
+		virtual void ReadV(size_t count, const Segment* segments) override;
+		/// <summary>
+		/// 聚集写入接口
+		/// <para>
+		/// 非 Windows 平台上在当前读写指针处循环调用 writev ，每次至多 IOV_MAX 个缓冲区，不需要把各段数据拼接到一起；
+		/// Windows 下依次写入每个缓冲区
+		/// </para>
+		/// </summary>
+		/// <param name="count">缓冲区个数</param>
+		/// <param name="segments">缓冲区数组</param>
+		virtual void WriteV(size_t count, const ConstSegment* segments) override;
+		/// <summary>
 		/// 关闭流对象
 		/// </summary>
 		virtual void Close() override;
@@ -48,37 +85,151 @@ namespace Utilities
 		/// 检测流对象是否可用
 		/// </summary>
 		virtual bool IsVaild() override;
+		/// <summary>
+		/// 读取至多 maxLen 字节的数据
+		/// </summary>
+		/// <param name="maxLen">最多读取的数据长度</param>
+		/// <param name="data">数据写入的目标缓冲区</param>
+		/// <returns>实际读取的数据长度</returns>
+		virtual size_t ReadSome(size_t maxLen, void* data) override;
+		/// <summary>
+		/// 将 C 运行库缓冲的数据提交到操作系统
+		/// </summary>
+		virtual void Flush() override;
+		/// <summary>
+		/// 把已写入的数据提交到磁盘，返回后掉电也不会丢失
+		/// <para>
+		/// 先调用 Flush ，再调用 FlushFileBuffers / fdatasync ，只保证读回数据所需的元数据；macOS 下使用 F_FULLFSYNC
+		/// </para>
+		/// </summary>
+		void Sync();
+		/// <summary>
+		/// 从当前位置读取 len 字节的数据写入到 dst
+		/// <para>
+		/// dst 也是文件流时，Linux 下依次尝试 copy_file_range、sendfile、splice 在内核中完成复制，
+		/// 数据不经过用户态；内核无法处理的部分以及其他情况使用缺省实现
+		/// </para>
+		/// </summary>
+		/// <param name="dst">目标流</param>
+		/// <param name="len">要复制的数据长度</param>
+		virtual void CopyTo(Stream& dst, uint64_t len) override;
 	public:
 		/// <summary>
 		/// 获取文件流的长度
 		/// </summary>
 		/// <returns></returns>
-		uint64_t GetLength();
+		virtual uint64_t GetLength() override;
 		/// <summary>
 		/// 获取当前读取指针的位置
 		/// </summary>
 		/// <returns></returns>
-		uint64_t GetPosition();
+		virtual uint64_t GetPosition() override;
 		/// <summary>
 		/// 设置当前读取指针的位置
 		/// </summary>
 		/// <param name="pos"></param>
-		void SetPosition(uint64_t pos);
+		virtual void SetPosition(uint64_t pos) override;
 		/// <summary>
 		/// 移动当前读取指针的位置
 		/// </summary>
 		/// <param name="offset">偏移量</param>
-		void Seek(int64_t offset);
+		virtual void Seek(int64_t offset) override;
+	public:
+		/// <summary>
+		/// 从指定位置读取数据
+		/// <para>
+		/// 不使用也不改变当前读写指针，可以被多个线程同时调用
+		/// Linux 下以 pread 实现；Windows 下各次调用之间互斥
+		/// </para>
+		/// </summary>
+		/// <param name="offset">文件中的偏移量</param>
+		/// <param name="len">要读取的数据长度</param>
+		/// <param name="data">数据写入的目标缓冲区</param>
+		virtual void ReadAt(uint64_t offset, size_t len, void* data) override;
+		/// <summary>
+		/// 向指定位置写入数据
+		/// <para>
+		/// 不使用也不改变当前读写指针，可以被多个线程同时调用
+		/// Linux 下以 pwrite 实现；Windows 下各次调用之间互斥
+		/// </para>
+		/// </summary>
+		/// <param name="offset">文件中的偏移量</param>
+		/// <param name="len">要写入的数据长度</param>
+		/// <param name="data">数据</param>
+		virtual void WriteAt(uint64_t offset, size_t len, const void* data) override;
+		/// <summary>
+		/// 从指定位置异步读取数据
+		/// <para>
+		/// 由 AsyncIOEngine::Default() 执行，请求完成前对象本身以及缓冲区都必须保持有效
+		/// </para>
+		/// </summary>
+		/// <param name="offset">文件中的偏移量</param>
+		/// <param name="len">要读取的数据长度</param>
+		/// <param name="data">数据写入的目标缓冲区</param>
+		/// <returns>请求完成时就绪，失败或读到文件末尾时携带异常</returns>
+		std::future<void> ReadAsync(uint64_t offset, size_t len, void* data);
+		/// <summary>
+		/// 向指定位置异步写入数据
+		/// <para>
+		/// 由 AsyncIOEngine::Default() 执行，请求完成前对象本身以及缓冲区都必须保持有效
+		/// </para>
+		/// </summary>
+		/// <param name="offset">文件中的偏移量</param>
+		/// <param name="len">要写入的数据长度</param>
+		/// <param name="data">数据</param>
+		/// <returns>请求完成时就绪，失败时携带异常</returns>
+		std::future<void> WriteAsync(uint64_t offset, size_t len, const void* data);
+	public:
+		/// <summary>
+		/// 告知操作系统 [offset, offset + len) 将被如何访问
+		/// <para>
+		/// 以 posix_fadvise 实现，macOS 下以 fcntl 的 F_RDAHEAD / F_RDADVISE 实现；
+		/// Windows 下 C 运行库的 FILE* 没有对应的接口，调用不产生任何效果。
+		/// 提示只是建议，文件类型不支持时被忽略
+		/// </para>
+		/// </summary>
+		/// <param name="hint">访问方式</param>
+		/// <param name="offset">文件中的偏移量</param>
+		/// <param name="len">长度，为 0 时直到文件末尾</param>
+		void Advise(AccessHint hint, uint64_t offset = 0, uint64_t len = 0);
+		/// <summary>
+		/// 在后台把 [offset, offset + len) 读入页缓存，不等待读取完成
+		/// <para>
+		/// 与 Advise(AccessHint::WillNeed, offset, len) 相同，适合在处理当前数据时预读下一段
+		/// </para>
+		/// </summary>
+		/// <param name="offset">文件中的偏移量</param>
+		/// <param name="len">长度，为 0 时直到文件末尾</param>
+		void Prefetch(uint64_t offset, uint64_t len);
 	public:
 		/// <summary>
 		/// 获取由系统维护的文件句柄
 		/// <para>
-		/// 该返回值在 Winodows 操作系统下即为 File *
+		/// 该返回值在 Winodows 操作系统下即为 File * ，在其他系统下为文件描述符；流已关闭时返回空指针
+		/// </para>
+		/// <para>
+		/// 其他系统下描述符 0 同样表示为空指针，需要文件描述符时应使用 GetDescriptor
 		/// </para>
 		/// </summary>
 		/// <returns></returns>
 		Handle GetHandle();
+		/// <summary>
+		/// 获取文件描述符
+		/// <para>
+		/// Winodows 操作系统下为 File * 对应的 CRT 文件描述符；流已关闭时返回 -1
+		/// </para>
+		/// </summary>
+		int GetDescriptor();
+	private:
+#ifdef _WIN32
+		void SwitchDirection(bool isWrite);
 	private:
 		Handle handle = nullptr;
+		bool lastWasWrite = false;
+		//! FILE* 只有一个共享的读写指针，使用或改变读写指针的操作都需要持有
+		std::mutex positionalLock;
+#else
+		int fd = -1;
+#endif
 	};
 }
\ No newline at end of file
@@ -0,0 +1,175 @@
+/**
+ @file
+ @brief 通用IO库 散列流接口定义及实现
+
+ @author 司马坑
+ @date 2026/10/17
+*/
+#pragma once
+#include "Utilities.Stream.h"
+#include "Utilities.Encryption.CRC32.h"
+#include "Utilities.Encryption.SHA1.h"
+
+#include <tuple>
+#include <utility>
+
+namespace Utilities
+{
+	/**
+		使用方式：
+		@code
+			FileStream fs(L"artifact.bin", Stream::Type::WriteOnly, false);
+			HashingStream<Encryption::CRC32::Core, Encryption::SHA1::Core> hs(fs);
+
+			auto sw = StreamWriter(hs);
+			sw.WriteArray(payload);
+
+			// 数据写入的同时完成散列计算，不需要再读一遍文件
+			auto crc = hs.Get<0>().ToString();
+			auto sha1 = hs.Get<Encryption::SHA1::Core>().ToString();
+		@endcode
+	*/
+	/// <summary>
+	/// 散列流对象
+	/// <para>
+	/// 包装任意一个流对象，所有经过它读出或写入的数据都会被依次送入每一个散列核心，
+	/// 任何时候都可以取得到目前为止的散列值
+	/// </para>
+	/// <para>
+	/// 散列核心需要提供 AppendData(const void*, size) 、Reset() 以及不改变状态的 Get() ，
+	/// 例如 Encryption::CRC32::Core 与 Encryption::SHA1::Core
+	/// </para>
+	/// <para>
+	/// 散列值只对连续的数据有意义，因此该流不支持改变读写指针
+	/// </para>
+	/// </summary>
+	/// <typeparam name="Cores">散列核心类型</typeparam>
+	template<typename... Cores>
+	class HashingStream final : public Stream
+	{
+		static_assert(sizeof...(Cores) != 0, "At least one hash core is required");
+	public:
+		/// <summary>
+		/// 为一个流对象创建散列流
+		/// <para>
+		/// 被包装的流对象的生命周期必须长于散列流
+		/// </para>
+		/// </summary>
+		/// <param name="stream">被包装的流对象</param>
+		HashingStream(Stream& stream) : Stream(stream.GetStreamType()), stream(stream) { }
+		HashingStream(const HashingStream&) = delete;
+		HashingStream& operator=(const HashingStream&) = delete;
+	public:
+		/// <summary>
+		/// 流对象读取接口
+		/// </summary>
+		/// <param name="len">要读取的数据长度</param>
+		/// <param name="data">数据写入的目标缓冲区</param>
+		virtual void Read(size_t len, void* data) override
+		{
+			stream.Read(len, data);
+			Append(data, len);
+		}
+		/// <summary>
+		/// 流对象写入接口
+		/// </summary>
+		/// <param name="len">要写入的数据长度</param>
+		/// <param name="data">数据</param>
+		virtual void Write(size_t len, const void* data) override
+		{
+			stream.Write(len, data);
+			Append(data, len);
+		}
+		/// <summary>
+		/// 读取至多 maxLen 字节的数据
+		/// </summary>
+		/// <param name="maxLen">最多读取的数据长度</param>
+		/// <param name="data">数据写入的目标缓冲区</param>
+		/// <returns>实际读取的数据长度</returns>
+		virtual size_t ReadSome(size_t maxLen, void* data) override
+		{
+			auto len = stream.ReadSome(maxLen, data);
+			Append(data, len);
+			return len;
+		}
+		/// <summary>
+		/// 分散读取接口
+		/// </summary>
+		/// <param name="count">缓冲区个数</param>
+		/// <param name="segments">缓冲区数组</param>
+		virtual void ReadV(size_t count, const Segment* segments) override
+		{
+			stream.ReadV(count, segments);
+			for (size_t i = 0; i < count; i++)
+				Append(segments[i].data, segments[i].len);
+		}
+		/// <summary>
+		/// 聚集写入接口
+		/// </summary>
+		/// <param name="count">缓冲区个数</param>
+		/// <param name="segments">缓冲区数组</param>
+		virtual void WriteV(size_t count, const ConstSegment* segments) override
+		{
+			stream.WriteV(count, segments);
+			for (size_t i = 0; i < count; i++)
+				Append(segments[i].data, segments[i].len);
+		}
+		/// <summary>
+		/// 关闭被包装的流对象
+		/// </summary>
+		virtual void Close() override { stream.Close(); }
+		/// <summary>
+		/// 检测流对象是否可用
+		/// </summary>
+		virtual bool IsVaild() override { return stream.IsVaild(); }
+		/// <summary>
+		/// 提交被包装的流对象中缓冲的数据
+		/// </summary>
+		virtual void Flush() override { stream.Flush(); }
+		/// <summary>
+		/// 获取被包装的流的长度
+		/// </summary>
+		virtual uint64_t GetLength() override { return stream.GetLength(); }
+		/// <summary>
+		/// 获取被包装的流的读写指针位置
+		/// </summary>
+		virtual uint64_t GetPosition() override { return stream.GetPosition(); }
+	public:
+		/// <summary>
+		/// 获取第 I 个散列核心
+		/// </summary>
+		template<size_t I>
+		auto& GetCore() { return std::get<I>(cores); }
+		/// <summary>
+		/// 获取类型为 Core 的散列核心
+		/// </summary>
+		template<typename Core>
+		Core& GetCore() { return std::get<Core>(cores); }
+		/// <summary>
+		/// 获取第 I 个散列核心到目前为止的散列值
+		/// </summary>
+		template<size_t I>
+		auto Get() const { return std::get<I>(cores).Get(); }
+		/// <summary>
+		/// 获取类型为 Core 的散列核心到目前为止的散列值
+		/// </summary>
+		template<typename Core>
+		auto Get() const { return std::get<Core>(cores).Get(); }
+		/// <summary>
+		/// 重置所有散列核心
+		/// </summary>
+		void Reset()
+		{
+			std::apply([](auto&... core) { (core.Reset(), ...); }, cores);
+		}
+	private:
+		void Append(const void* data, size_t len)
+		{
+			if (len != 0)
+				std::apply([data, len](auto&... core) { (core.AppendData(data, len), ...); }, cores);
+		}
+	private:
+		Stream& stream;
+		std::tuple<Cores...> cores;
+	};
+}
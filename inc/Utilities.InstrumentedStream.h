@@ -0,0 +1,214 @@
+/**
+ @file
+ @brief 通用IO库 统计流接口定义
+
+ @author 司马坑
+ @date 2026/10/17
+*/
+#pragma once
+#include "Utilities.Stream.h"
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+namespace Utilities
+{
+	/**
+		使用方式：
+		@code
+			FileStream fs(L"input.bin", Stream::Type::ReadOnly, false);
+			InstrumentedStream is(fs, "input.bin");
+			auto sr = StreamReader(is);
+			// ... 通过 is 读取
+
+			auto read = is.GetStatistics(InstrumentedStream::Operation::Read);
+			if (read.calls != 0 && read.bytes / read.calls < 512)
+				; // 大量的小块读取，应当加一层 BufferedStream
+
+			// 输出所有存活的统计流
+			MemoryStream report;
+			InstrumentedStream::DumpAll(report);
+		@endcode
+	*/
+	/// <summary>
+	/// 统计流对象
+	/// <para>
+	/// 包装任意一个流对象，按操作类型记录调用次数、数据量、累计耗时以及按 2 的幂分桶的耗时直方图，
+	/// 用于定位大量小块读写、频繁定位等低效的访问模式
+	/// </para>
+	/// <para>
+	/// 统计是可选的：只有经过统计流的操作才会计时，未包装的流没有任何额外开销。
+	/// 计数器均为原子变量，被包装的流支持并发读取时(例如 ReadAt)统计流也可以并发使用
+	/// </para>
+	/// <para>
+	/// 每个统计流在生命周期内登记在全局表中，DumpAll 可以随时输出所有存活的统计流
+	/// </para>
+	/// </summary>
+	class InstrumentedStream final : public Stream
+	{
+	public:
+		/// <summary>
+		/// 统计的操作类型
+		/// </summary>
+		enum class Operation
+		{
+			Read,		//!< Read / ReadSome / ReadV / ReadAt
+			Write,		//!< Write / WriteV / WriteAt
+			Seek,		//!< SetPosition / Seek
+			Flush,		//!< Flush
+		};
+		//! 操作类型的个数
+		static constexpr size_t OperationCount = 4;
+		//! 耗时直方图的桶数，第 i 个桶记录耗时在 [2^i, 2^(i+1)) 纳秒内的调用，最后一个桶包含所有更长的调用
+		static constexpr size_t LatencyBucketCount = 32;
+
+		/// <summary>
+		/// 一类操作的统计结果
+		/// </summary>
+		struct Statistics
+		{
+			uint64_t calls = 0;							//!< 调用次数
+			uint64_t bytes = 0;							//!< 数据量
+			uint64_t nanoseconds = 0;					//!< 累计耗时
+			uint64_t latency[LatencyBucketCount] = {};	//!< 耗时直方图
+
+			/// <summary>
+			/// 估算耗时的分位数
+			/// </summary>
+			/// <param name="ratio">分位，例如 0.99</param>
+			/// <returns>分位数所在桶的上界(纳秒)，没有调用时返回 0</returns>
+			uint64_t Percentile(double ratio) const;
+		};
+	public:
+		/// <summary>
+		/// 为一个流对象创建统计流
+		/// <para>
+		/// 被包装的流对象的生命周期必须长于统计流
+		/// </para>
+		/// </summary>
+		/// <param name="stream">被包装的流对象</param>
+		/// <param name="name">输出统计结果时使用的名称</param>
+		InstrumentedStream(Stream& stream, std::string name);
+		InstrumentedStream(const InstrumentedStream&) = delete;
+		InstrumentedStream& operator=(const InstrumentedStream&) = delete;
+		virtual ~InstrumentedStream();
+	public:
+		/// <summary>
+		/// 流对象读取接口
+		/// </summary>
+		/// <param name="len">要读取的数据长度</param>
+		/// <param name="data">数据写入的目标缓冲区</param>
+		virtual void Read(size_t len, void* data) override;
+		/// <summary>
+		/// 流对象写入接口
+		/// </summary>
+		/// <param name="len">要写入的数据长度</param>
+		/// <param name="data">数据</param>
+		virtual void Write(size_t len, const void* data) override;
+		/// <summary>
+		/// 关闭被包装的流对象
+		/// </summary>
+		virtual void Close() override;
+		/// <summary>
+		/// 检测流对象是否可用
+		/// </summary>
+		virtual bool IsVaild() override;
+		/// <summary>
+		/// 读取至多 maxLen 字节的数据
+		/// </summary>
+		/// <param name="maxLen">最多读取的数据长度</param>
+		/// <param name="data">数据写入的目标缓冲区</param>
+		/// <returns>实际读取的数据长度</returns>
+		virtual size_t ReadSome(size_t maxLen, void* data) override;
+		/// <summary>
+		/// 分散读取接口，整体记为一次读取
+		/// </summary>
+		/// <param name="count">缓冲区个数</param>
+		/// <param name="segments">缓冲区数组</param>
+		virtual void ReadV(size_t count, const Segment* segments) override;
+		/// <summary>
+		/// 聚集写入接口，整体记为一次写入
+		/// </summary>
+		/// <param name="count">缓冲区个数</param>
+		/// <param name="segments">缓冲区数组</param>
+		virtual void WriteV(size_t count, const ConstSegment* segments) override;
+		/// <summary>
+		/// 提交被包装的流对象中缓冲的数据
+		/// </summary>
+		virtual void Flush() override;
+		/// <summary>
+		/// 从指定位置读取数据，不改变当前读写指针
+		/// </summary>
+		/// <param name="offset">流中的偏移量</param>
+		/// <param name="len">要读取的数据长度</param>
+		/// <param name="data">数据写入的目标缓冲区</param>
+		virtual void ReadAt(uint64_t offset, size_t len, void* data) override;
+		/// <summary>
+		/// 向指定位置写入数据，不改变当前读写指针
+		/// </summary>
+		/// <param name="offset">流中的偏移量</param>
+		/// <param name="len">要写入的数据长度</param>
+		/// <param name="data">数据</param>
+		virtual void WriteAt(uint64_t offset, size_t len, const void* data) override;
+	public:
+		/// <summary>
+		/// 获取被包装的流的长度
+		/// </summary>
+		virtual uint64_t GetLength() override;
+		/// <summary>
+		/// 获取被包装的流的读写指针位置
+		/// </summary>
+		virtual uint64_t GetPosition() override;
+		/// <summary>
+		/// 设置被包装的流的读写指针位置
+		/// </summary>
+		/// <param name="pos">新的位置</param>
+		virtual void SetPosition(uint64_t pos) override;
+		/// <summary>
+		/// 移动被包装的流的读写指针位置
+		/// </summary>
+		/// <param name="offset">偏移量</param>
+		virtual void Seek(int64_t offset) override;
+	public:
+		/// <summary>
+		/// 获取统计流的名称
+		/// </summary>
+		const std::string& GetName() const { return name; }
+		/// <summary>
+		/// 获取一类操作到目前为止的统计结果
+		/// </summary>
+		/// <param name="operation">操作类型</param>
+		Statistics GetStatistics(Operation operation) const;
+		/// <summary>
+		/// 清空所有统计结果
+		/// </summary>
+		void ResetStatistics();
+		/// <summary>
+		/// 以文本形式输出该流的统计结果
+		/// </summary>
+		/// <param name="output">输出的目标流</param>
+		void Dump(Stream& output) const;
+		/// <summary>
+		/// 以文本形式输出所有存活的统计流的统计结果
+		/// <para>
+		/// 输出期间登记表被锁定，其他线程中统计流的创建与析构会等待输出完成
+		/// </para>
+		/// </summary>
+		/// <param name="output">输出的目标流</param>
+		static void DumpAll(Stream& output);
+	private:
+		struct Counters
+		{
+			std::atomic<uint64_t> calls{ 0 };
+			std::atomic<uint64_t> bytes{ 0 };
+			std::atomic<uint64_t> nanoseconds{ 0 };
+			std::atomic<uint64_t> latency[LatencyBucketCount] = {};
+		};
+		void Record(Operation operation, uint64_t bytes, uint64_t start);
+	private:
+		Stream& stream;
+		std::string name;
+		Counters counters[OperationCount];
+	};
+}
@@ -0,0 +1,166 @@
+/**
+ @file
+ @brief 通用IO库 内存映射文件流接口定义
+
+ @author 司马坑
+ @date 2026/10/17
+*/
+#pragma once
+#include "Utilities.Stream.h"
+#include "Utilities.Common.Span.h"
+
+#include <cstring>
+
+namespace Utilities
+{
+	/**
+		使用方式：
+		@code
+			MappedFileStream fs(L"assets.pak");
+
+			// 与 FileStream 相同的读取方式
+			auto sr = StreamReader(fs);
+			auto magic = sr.Read<uint32>();
+
+			// 直接在映射的内存上计算校验值，不发生复制
+			auto view = fs.View();
+			Encryption::CRC32 crc(view.data(), view.size());
+
+			// 从当前位置取出一段数据的视图并移动读取指针
+			auto entry = fs.ReadView(1024);
+		@endcode
+	*/
+	/// <summary>
+	/// 内存映射文件流对象
+	/// <para>
+	/// 以只读方式将整个文件映射到进程地址空间，读取操作只是一次内存复制，
+	/// 随机访问的代价为一次缺页中断而非一次系统调用
+	/// </para>
+	/// </summary>
+	class MappedFileStream final : public Stream
+	{
+	public:
+		/// <summary>
+		/// 以只读方式映射一个文件
+		/// </summary>
+		/// <param name="fileName">文件名</param>
+		MappedFileStream(const wchar_t* fileName);
+		/// <summary>
+		/// 析构函数
+		/// </summary>
+		virtual ~MappedFileStream();
+	public:
+		/// <summary>
+		/// 流对象读取接口
+		/// <para>
+		/// 数据足够时直接在头文件中内联完成，通过 MappedFileStream 类型调用时不经过虚函数分派
+		/// </para>
+		/// </summary>
+		/// <param name="len">要读取的数据长度</param>
+		/// <param name="data">数据写入的目标缓冲区</param>
+		virtual void Read(size_t len, void* data) override
+		{
+			if (mapped != nullptr && len <= length - position)
+			{
+				memcpy(data, mapped + position, len);
+				position += len;
+				return;
+			}
+			ReadSlow(len);
+		}
+		/// <summary>
+		/// 流对象写入接口
+		/// <para>
+		/// 内存映射文件流是只读的，调用该函数会抛出异常
+		/// </para>
+		/// </summary>
+		virtual void Write(size_t len, const void* data) override;
+		/// <summary>
+		/// 关闭流对象 并解除映射
+		/// </summary>
+		virtual void Close() override;
+		/// <summary>
+		/// 检测流对象是否可用
+		/// </summary>
+		virtual bool IsVaild() override;
+		/// <summary>
+		/// 读取至多 maxLen 字节的数据
+		/// </summary>
+		/// <param name="maxLen">最多读取的数据长度</param>
+		/// <param name="data">数据写入的目标缓冲区</param>
+		/// <returns>实际读取的数据长度</returns>
+		virtual size_t ReadSome(size_t maxLen, void* data) override;
+		/// <summary>
+		/// 从当前位置读取 len 字节的数据写入到 dst
+		/// <para>
+		/// 直接以映射的内存调用一次 dst.Write ，不经过中间缓冲区
+		/// </para>
+		/// </summary>
+		/// <param name="dst">目标流</param>
+		/// <param name="len">要复制的数据长度</param>
+		virtual void CopyTo(Stream& dst, uint64_t len) override;
+		/// <summary>
+		/// 从指定位置读取数据，不改变当前读写指针
+		/// <para>
+		/// 只是一次内存复制，可以被多个线程同时调用
+		/// </para>
+		/// </summary>
+		/// <param name="offset">流中的偏移量</param>
+		/// <param name="len">要读取的数据长度</param>
+		/// <param name="data">数据写入的目标缓冲区</param>
+		virtual void ReadAt(uint64_t offset, size_t len, void* data) override;
+	public:
+		/// <summary>
+		/// 获取文件的长度
+		/// </summary>
+		virtual uint64_t GetLength() override;
+		/// <summary>
+		/// 获取当前读取指针的位置
+		/// </summary>
+		virtual uint64_t GetPosition() override;
+		/// <summary>
+		/// 设置当前读取指针的位置
+		/// </summary>
+		/// <param name="pos"></param>
+		virtual void SetPosition(uint64_t pos) override;
+		/// <summary>
+		/// 移动当前读取指针的位置
+		/// </summary>
+		/// <param name="offset">偏移量</param>
+		virtual void Seek(int64_t offset) override;
+	public:
+		/// <summary>
+		/// 获取整个映射区域的只读视图
+		/// <para>
+		/// 该视图在流关闭后失效
+		/// </para>
+		/// </summary>
+		Common::Span<const uint8> View() const;
+		/// <summary>
+		/// 获取从当前位置开始 len 字节的只读视图，并将读取指针向后移动 len 字节
+		/// <para>
+		/// 剩余数据不足 len 字节时抛出异常
+		/// </para>
+		/// </summary>
+		/// <param name="len">视图长度</param>
+		Common::Span<const uint8> ReadView(size_t len);
+		/// <summary>
+		/// 告知操作系统映射区域中 [offset, offset + len) 将被如何访问
+		/// <para>
+		/// 以 madvise 实现，范围向外扩展到页边界；Windows 下只支持 AccessHint::WillNeed (PrefetchVirtualMemory)。
+		/// 映射是只读的，AccessHint::DontNeed 丢弃的页在下次访问时重新从文件读入
+		/// </para>
+		/// </summary>
+		/// <param name="hint">访问方式</param>
+		/// <param name="offset">文件中的偏移量</param>
+		/// <param name="len">长度，为 0 时直到文件末尾</param>
+		void Advise(AccessHint hint, uint64_t offset = 0, uint64_t len = 0);
+	private:
+		void ReadSlow(size_t len);
+	private:
+		const uint8* mapped = nullptr;
+		uint64_t length = 0;
+		uint64_t position = 0;
+		bool closed = false;
+	};
+}
@@ -0,0 +1,166 @@
+/**
+ @file
+ @brief 通用IO库 内存流接口定义
+
+ @author 司马坑
+ @date 2026/10/17
+*/
+#pragma once
+#include "Utilities.Stream.h"
+#include "Utilities.Common.Span.h"
+
+namespace Utilities
+{
+	/**
+		使用方式：
+		@code
+			MemoryStream ms;
+			auto sw = StreamWriter(ms);
+			sw.Write(125);
+			sw.Write(124.5);
+
+			auto view = ms.View();	// 不发生复制
+			Encryption::CRC32 crc(view.data(), view.size());
+		@endcode
+
+		使用外部提供的缓冲区(例如帧内存池):
+		@code
+			uint8 arena[4096];
+			MemoryStream ms{ Common::Span<uint8>(arena) };
+			// 写入量超过 4096 字节后自动切换到堆内存
+		@endcode
+	*/
+	/// <summary>
+	/// 内存流对象
+	/// <para>
+	/// 数据保存在一块按倍数增长的连续内存中，读写接口与 FileStream 保持一致
+	/// </para>
+	/// </summary>
+	class MemoryStream : public Stream
+	{
+	public:
+		/// <summary>
+		/// 实例化一个可读写的内存流对象
+		/// </summary>
+		/// <param name="initialCapacity">预分配的容量</param>
+		MemoryStream(size_t initialCapacity = 0);
+		/// <summary>
+		/// 实例化一个使用外部缓冲区的可读写内存流对象
+		/// <para>
+		/// 外部缓冲区由调用者持有，写入量超过其容量后内存流会将数据迁移到自己分配的内存中
+		/// </para>
+		/// </summary>
+		/// <param name="arena">外部缓冲区</param>
+		explicit MemoryStream(Common::Span<uint8> arena);
+		/// <summary>
+		/// 实例化一个引用现有数据的只读内存流对象
+		/// <para>
+		/// 数据不会被复制，调用者需要保证数据在内存流的生命周期内有效
+		/// </para>
+		/// </summary>
+		/// <param name="data">数据</param>
+		/// <param name="length">数据长度</param>
+		MemoryStream(const void* data, size_t length);
+		//! 移动构造函数
+		MemoryStream(MemoryStream&& rhs) noexcept;
+		/// <summary>
+		/// 析构函数
+		/// </summary>
+		virtual ~MemoryStream();
+	public:
+		/// <summary>
+		/// 流对象读取接口
+		/// </summary>
+		/// <param name="len">要读取的数据长度</param>
+		/// <param name="data">数据写入的目标缓冲区</param>
+		virtual void Read(size_t len, void* data) override;
+		/// <summary>
+		/// 流对象写入接口
+		/// </summary>
+		/// <param name="len">要写入的数据长度</param>
+		/// <param name="data">数据</param>
+		virtual void Write(size_t len, const void* data) override;
+		/// <summary>
+		/// 关闭流对象 并释放内存流所持有的内存
+		/// </summary>
+		virtual void Close() override;
+		/// <summary>
+		/// 检测流对象是否可用
+		/// </summary>
+		virtual bool IsVaild() override;
+		/// <summary>
+		/// 读取至多 maxLen 字节的数据
+		/// </summary>
+		/// <param name="maxLen">最多读取的数据长度</param>
+		/// <param name="data">数据写入的目标缓冲区</param>
+		/// <returns>实际读取的数据长度</returns>
+		virtual size_t ReadSome(size_t maxLen, void* data) override;
+		/// <summary>
+		/// 从当前位置读取 len 字节的数据写入到 dst
+		/// <para>
+		/// 直接以内部缓冲区调用一次 dst.Write ，不经过中间缓冲区
+		/// </para>
+		/// </summary>
+		/// <param name="dst">目标流</param>
+		/// <param name="len">要复制的数据长度</param>
+		virtual void CopyTo(Stream& dst, uint64_t len) override;
+		/// <summary>
+		/// 从指定位置读取数据，不改变当前读写指针
+		/// <para>
+		/// 只是一次内存复制，可以被多个线程同时调用
+		/// </para>
+		/// </summary>
+		/// <param name="offset">流中的偏移量</param>
+		/// <param name="len">要读取的数据长度</param>
+		/// <param name="data">数据写入的目标缓冲区</param>
+		virtual void ReadAt(uint64_t offset, size_t len, void* data) override;
+	public:
+		/// <summary>
+		/// 获取内存流中数据的长度
+		/// </summary>
+		virtual uint64_t GetLength() override;
+		/// <summary>
+		/// 获取当前读写指针的位置
+		/// </summary>
+		virtual uint64_t GetPosition() override;
+		/// <summary>
+		/// 设置当前读写指针的位置
+		/// <para>
+		/// 位置可以超过数据末尾，之后的写入会以 0 填充中间的空隙
+		/// </para>
+		/// </summary>
+		/// <param name="pos"></param>
+		virtual void SetPosition(uint64_t pos) override;
+		/// <summary>
+		/// 移动当前读写指针的位置
+		/// </summary>
+		/// <param name="offset">偏移量</param>
+		virtual void Seek(int64_t offset) override;
+	public:
+		/// <summary>
+		/// 获取已写入数据的只读视图
+		/// <para>
+		/// 该视图直接引用内存流内部的缓冲区，在下一次写入或关闭之后失效
+		/// </para>
+		/// </summary>
+		Common::Span<const uint8> View() const;
+		/// <summary>
+		/// 获取当前缓冲区的容量
+		/// </summary>
+		size_t GetCapacity() const;
+		/// <summary>
+		/// 确保缓冲区至少可以容纳 capacity 字节而无需再次分配
+		/// </summary>
+		/// <param name="capacity">期望的容量</param>
+		void Reserve(size_t capacity);
+	private:
+		void Grow(size_t required);
+	private:
+		uint8* buffer = nullptr;
+		size_t capacity = 0;
+		size_t length = 0;
+		size_t position = 0;
+		bool ownsBuffer = false;
+		bool closed = false;
+	};
+}
@@ -0,0 +1,158 @@
+/**
+ @file
+ @brief 通用IO库 管道流接口定义
+
+ @author 司马坑
+ @date 2026/10/17
+*/
+#pragma once
+#include "Utilities.Stream.h"
+
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+
+namespace Utilities
+{
+	/**
+		使用方式：
+		@code
+			PipeStream pipe(256 * 1024);
+			std::thread producer([&]()
+				{
+					auto sw = StreamWriter(pipe);
+					while (Decompress(block))
+						sw.WriteArray(block.data(), block.size());
+					pipe.Close();
+				});
+
+			auto sr = StreamReader(pipe);
+			while (pipe.IsVaild())
+				Parse(sr);
+			producer.join();
+		@endcode
+	*/
+	/// <summary>
+	/// 进程内管道流对象
+	/// <para>
+	/// 建立在一个有界的单生产者单消费者环形缓冲区之上，一个线程写入、另一个线程读取，
+	/// 数据路径上没有锁，读写索引分别位于独立的缓存行上以避免伪共享
+	/// </para>
+	/// <para>
+	/// Read / Write 在数据或空间不足时阻塞：先短暂自旋，之后才在条件变量上休眠；
+	/// TryRead / TryWrite 从不阻塞
+	/// </para>
+	/// <para>
+	/// 任意一端调用 Close 后，写入会抛出异常，读取在取完剩余数据后到达流末尾
+	/// </para>
+	/// </summary>
+	class PipeStream final : public Stream
+	{
+	public:
+		//! 缓存行大小
+		static constexpr size_t CacheLineSize = 64;
+		//! 缺省的缓冲区大小
+		static constexpr size_t DefaultCapacity = 64 * 1024;
+	public:
+		/// <summary>
+		/// 创建一个管道流
+		/// </summary>
+		/// <param name="capacity">环形缓冲区大小，向上取整到 2 的整数次幂</param>
+		explicit PipeStream(size_t capacity = DefaultCapacity);
+		PipeStream(const PipeStream&) = delete;
+		PipeStream& operator=(const PipeStream&) = delete;
+		/// <summary>
+		/// 析构函数
+		/// </summary>
+		virtual ~PipeStream();
+	public:
+		/// <summary>
+		/// 流对象读取接口
+		/// <para>
+		/// 阻塞直至读满 len 字节；管道关闭且剩余数据不足时抛出异常
+		/// </para>
+		/// </summary>
+		/// <param name="len">要读取的数据长度</param>
+		/// <param name="data">数据写入的目标缓冲区</param>
+		virtual void Read(size_t len, void* data) override;
+		/// <summary>
+		/// 流对象写入接口
+		/// <para>
+		/// 阻塞直至全部写入；管道已关闭时抛出异常
+		/// </para>
+		/// </summary>
+		/// <param name="len">要写入的数据长度</param>
+		/// <param name="data">数据</param>
+		virtual void Write(size_t len, const void* data) override;
+		/// <summary>
+		/// 关闭管道并唤醒所有等待中的读写方
+		/// </summary>
+		virtual void Close() override;
+		/// <summary>
+		/// 检测流对象是否可用
+		/// <para>
+		/// 管道关闭并且剩余数据全部被读出后返回 false
+		/// </para>
+		/// </summary>
+		virtual bool IsVaild() override;
+		/// <summary>
+		/// 读取至多 maxLen 字节的数据
+		/// <para>
+		/// 阻塞直至至少有 1 字节数据可读，管道关闭且没有剩余数据时返回 0
+		/// </para>
+		/// </summary>
+		/// <param name="maxLen">最多读取的数据长度</param>
+		/// <param name="data">数据写入的目标缓冲区</param>
+		/// <returns>实际读取的数据长度</returns>
+		virtual size_t ReadSome(size_t maxLen, void* data) override;
+	public:
+		/// <summary>
+		/// 读取当前可读的数据，不阻塞
+		/// </summary>
+		/// <param name="maxLen">最多读取的数据长度</param>
+		/// <param name="data">数据写入的目标缓冲区</param>
+		/// <returns>实际读取的数据长度</returns>
+		size_t TryRead(size_t maxLen, void* data);
+		/// <summary>
+		/// 写入当前空间允许的数据，不阻塞
+		/// </summary>
+		/// <param name="maxLen">最多写入的数据长度</param>
+		/// <param name="data">数据</param>
+		/// <returns>实际写入的数据长度，管道已关闭时抛出异常</returns>
+		size_t TryWrite(size_t maxLen, const void* data);
+		/// <summary>
+		/// 获取环形缓冲区的大小
+		/// </summary>
+		size_t GetCapacity() const { return capacity; }
+		/// <summary>
+		/// 获取当前可读的数据长度
+		/// </summary>
+		size_t GetReadableLength() const { return writeIndex.load(std::memory_order_acquire) - readIndex.load(std::memory_order_acquire); }
+	private:
+		void WaitReadable();
+		void WaitWritable();
+		void WakeReader();
+		void WakeWriter();
+	private:
+		uint8* buffer = nullptr;
+		size_t capacity = 0;
+		size_t mask = 0;
+
+		//! 写入索引，只由生产者修改
+		alignas(CacheLineSize) std::atomic<size_t> writeIndex{ 0 };
+		//! 生产者最近一次看到的读取索引
+		size_t cachedReadIndex = 0;
+
+		//! 读取索引，只由消费者修改
+		alignas(CacheLineSize) std::atomic<size_t> readIndex{ 0 };
+		//! 消费者最近一次看到的写入索引
+		size_t cachedWriteIndex = 0;
+
+		alignas(CacheLineSize) std::atomic<bool> closed{ false };
+		std::atomic<bool> readerWaiting{ false };
+		std::atomic<bool> writerWaiting{ false };
+		std::mutex waitLock;
+		std::condition_variable readable;
+		std::condition_variable writable;
+	};
+}
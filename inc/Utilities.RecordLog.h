@@ -0,0 +1,183 @@
+/**
+ @file
+ @brief 通用IO库 记录日志格式接口定义
+
+ 记录日志由若干帧组成，所有整数均以小端字节序存储：
+ - 记录帧：uint32 长度、uint32 负载的 CRC32、负载
+ - 同步标记帧：uint32 0xFFFFFFFF、8 字节魔数、uint64 该标记在文件中的偏移量、uint32 前两项的 CRC32
+
+ 写入器每隔一段距离在下一条记录前插入同步标记，恢复时以同步标记为界把文件分块，各块可以独立校验
+
+ @author 司马坑
+ @date 2026/10/17
+*/
+#pragma once
+#include "Utilities.Stream.h"
+#include "Utilities.StreamWriter.h"
+#include "Utilities.Common.Span.h"
+
+#include <optional>
+#include <vector>
+
+namespace Utilities
+{
+	/**
+		使用方式：
+		@code
+			FileStream fs(L"journal.log", Stream::Type::WriteOnly, false);
+			RecordWriter writer(fs);
+			writer.Write(entry.size(), entry.data());
+		@endcode
+	*/
+	/// <summary>
+	/// 记录日志写入器
+	/// <para>
+	/// 每条记录在写入时计算 CRC32，帧头与不超过 64 KB 的负载合并为一次写入调用；
+	/// 写入的第一条记录前，以及距离上一个同步标记超过 syncInterval 字节后的下一条记录前会插入同步标记
+	/// </para>
+	/// </summary>
+	class RecordWriter
+	{
+	public:
+		//! 缺省的同步标记间隔
+		static constexpr size_t DefaultSyncInterval = 256 * 1024;
+	public:
+		/// <summary>
+		/// 在流上创建写入器
+		/// </summary>
+		/// <param name="stream">要写入的流</param>
+		/// <param name="offset">流的当前位置在文件中的偏移量，在已有文件末尾继续写入时传入文件长度</param>
+		/// <param name="syncInterval">同步标记间隔</param>
+		RecordWriter(Stream& stream, uint64_t offset = 0, size_t syncInterval = DefaultSyncInterval);
+		RecordWriter(const RecordWriter&) = delete;
+		RecordWriter& operator=(const RecordWriter&) = delete;
+	public:
+		/// <summary>
+		/// 写入一条记录
+		/// </summary>
+		/// <param name="len">负载长度，不能超过 RecordReader::MaxRecordLength</param>
+		/// <param name="data">负载</param>
+		void Write(size_t len, const void* data);
+		/// <summary>
+		/// 在下一条记录前插入同步标记
+		/// </summary>
+		void WriteSyncMarker();
+		/// <summary>
+		/// 获取下一帧在文件中的偏移量
+		/// </summary>
+		uint64_t GetOffset() const { return offset; }
+	private:
+		void AppendSyncMarker();
+	private:
+		StreamWriter<> writer;
+		uint64_t offset;
+		size_t syncInterval;
+		//! 上一个同步标记的偏移量，还未写入时为 nullopt
+		std::optional<uint64_t> lastMarker;
+		//! 待写入的帧，复用以避免每条记录分配内存
+		std::vector<uint8_t> frame;
+	};
+
+	/**
+		使用方式：
+		@code
+			FileStream fs(L"journal.log", Stream::Type::ReadOnly, false);
+			BufferedStream bs(fs);
+			RecordReader reader(bs);
+			while (auto record = reader.Read())
+				Replay(record->data(), record->size());
+
+			// 崩溃后并行扫描整个文件，跳过损坏的部分
+			auto result = RecordReader::Recover(fs);
+			for (auto& record : result.records)
+				...
+		@endcode
+	*/
+	/// <summary>
+	/// 记录日志读取器
+	/// <para>
+	/// 顺序读取记录并校验 CRC32 与同步标记；每条记录至少产生两次读取调用，对无缓冲的流请先用 BufferedStream 包装
+	/// </para>
+	/// </summary>
+	class RecordReader
+	{
+	public:
+		//! 单条记录的最大长度，更长的长度字段视为损坏
+		static constexpr uint32_t MaxRecordLength = 0x10000000;
+		//! 同步标记帧的长度
+		static constexpr size_t SyncMarkerSize = 24;
+		//! 记录帧头的长度
+		static constexpr size_t HeaderSize = 8;
+
+		/// <summary>
+		/// 一条记录的负载在文件中的位置
+		/// </summary>
+		struct RecordLocation
+		{
+			uint64_t offset;	//!< 负载的偏移量
+			uint32_t length;	//!< 负载的长度
+		};
+		/// <summary>
+		/// 被跳过的损坏区域 [begin, end)
+		/// </summary>
+		struct DamagedRange
+		{
+			uint64_t begin;
+			uint64_t end;
+		};
+		/// <summary>
+		/// 恢复扫描的结果
+		/// </summary>
+		struct RecoveryResult
+		{
+			//! 所有通过校验的记录，按文件中的顺序排列
+			std::vector<RecordLocation> records;
+			//! 损坏的区域，每个区域从校验失败的帧开始，到下一个同步标记为止
+			std::vector<DamagedRange> damaged;
+			//! 文件中最后一个有效帧的结尾，继续写入前应把文件截断到这里
+			uint64_t validLength = 0;
+		};
+	public:
+		/// <summary>
+		/// 在流上创建读取器
+		/// </summary>
+		/// <param name="stream">要读取的流</param>
+		/// <param name="offset">流的当前位置在文件中的偏移量</param>
+		RecordReader(Stream& stream, uint64_t offset = 0);
+		RecordReader(const RecordReader&) = delete;
+		RecordReader& operator=(const RecordReader&) = delete;
+	public:
+		/// <summary>
+		/// 读取下一条记录
+		/// <para>
+		/// 同步标记会被校验后跳过；记录不完整、长度非法或校验失败时抛出异常
+		/// </para>
+		/// </summary>
+		/// <returns>记录的负载，在下一次调用 Read 前有效；流在帧边界处结束时返回 std::nullopt</returns>
+		std::optional<Common::Span<const uint8_t>> Read();
+		/// <summary>
+		/// 获取下一帧在文件中的偏移量
+		/// </summary>
+		uint64_t GetOffset() const { return offset; }
+	public:
+		/// <summary>
+		/// 并行扫描整个流，找出所有通过校验的记录
+		/// <para>
+		/// 先把流分为若干段并行查找有效的同步标记，再以同步标记为界分块，在多个线程中独立校验各块；
+		/// 某一块中校验失败的帧之后直到下一个同步标记的数据被跳过，其余块不受影响
+		/// </para>
+		/// <para>
+		/// 流需要支持 GetLength 与可以并发调用的 ReadAt (例如 FileStream 、 MappedFileStream)
+		/// </para>
+		/// </summary>
+		/// <param name="stream">要扫描的流</param>
+		/// <param name="threadCount">线程数，为 0 时使用硬件线程数</param>
+		static RecoveryResult Recover(Stream& stream, size_t threadCount = 0);
+	private:
+		size_t ReadFully(size_t len, void* data);
+	private:
+		Stream& stream;
+		uint64_t offset;
+		std::vector<uint8_t> payload;
+	};
+}
@@ -0,0 +1,175 @@
+/**
+ @file
+ @brief 通用IO库 分段日志流接口定义
+
+ @author 司马坑
+ @date 2026/10/17
+*/
+#pragma once
+#include "Utilities.FileStream.h"
+
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace Utilities
+{
+	/**
+		使用方式：
+		@code
+			// 生成 journal.00000000 、 journal.00000001 ... ，每段 64 MB
+			SegmentedLogStream log(L"journal", 64 * 1024 * 1024);
+
+			// 在多个线程中同时提交记录，返回时记录已经落盘；
+			// 同一时间等待的所有记录共用一次 fdatasync
+			log.Commit(record.size(), record.data());
+
+			// 或者先写入，稍后再等待
+			auto lsn = log.Append(record.size(), record.data());
+			log.WaitDurable(lsn);
+		@endcode
+	*/
+	/// <summary>
+	/// 分段日志流对象
+	/// <para>
+	/// 只追加写入的日志文件，当前段的长度达到阈值后滚动到下一个段文件；
+	/// 段文件名为 basePath 加上 '.' 与 8 位十进制的段序号，段序号从 0 开始连续编号，打开时从已有的最后一个段继续追加
+	/// </para>
+	/// <para>
+	/// 每条记录写入后得到一个日志序号(LSN)，即写入该记录后此对象累计写入的字节数；
+	/// 等待记录落盘时，同一时间等待的所有线程中只有一个线程调用 fdatasync (Windows 下为 FlushFileBuffers)，
+	/// 其余线程等待它完成，一次同步覆盖调用时已经写入的所有记录(组提交)
+	/// </para>
+	/// <para>
+	/// 该流只能写入，可以在多个线程中同时写入；单条记录不会跨越两个段，也不会与其他线程的记录交错
+	/// </para>
+	/// </summary>
+	class SegmentedLogStream final : public Stream
+	{
+	public:
+		//! 缺省的段大小阈值
+		static constexpr uint64_t DefaultSegmentSize = 64 * 1024 * 1024;
+	public:
+		/// <summary>
+		/// 打开或创建分段日志
+		/// </summary>
+		/// <param name="basePath">段文件名的前缀</param>
+		/// <param name="segmentSize">段大小阈值，超过一个段的记录单独占用一个段</param>
+		SegmentedLogStream(const wchar_t* basePath, uint64_t segmentSize = DefaultSegmentSize);
+		SegmentedLogStream(const SegmentedLogStream&) = delete;
+		SegmentedLogStream& operator=(const SegmentedLogStream&) = delete;
+		/// <summary>
+		/// 析构函数
+		/// <para>
+		/// 析构时会同步所有已写入的记录并关闭当前段
+		/// </para>
+		/// </summary>
+		virtual ~SegmentedLogStream();
+	public:
+		/// <summary>
+		/// 该流只能写入，调用时抛出异常
+		/// </summary>
+		virtual void Read(size_t len, void* data) override;
+		/// <summary>
+		/// 写入一条记录，不等待落盘
+		/// </summary>
+		/// <param name="len">要写入的数据长度</param>
+		/// <param name="data">数据</param>
+		virtual void Write(size_t len, const void* data) override;
+		/// <summary>
+		/// 同步所有已写入的记录并关闭当前段
+		/// <para>
+		/// 同步失败时抛出异常，流保持打开
+		/// </para>
+		/// </summary>
+		virtual void Close() override;
+		/// <summary>
+		/// 检测流对象是否可用
+		/// </summary>
+		virtual bool IsVaild() override;
+		/// <summary>
+		/// 等待此前写入的所有记录落盘
+		/// </summary>
+		virtual void Flush() override;
+	public:
+		/// <summary>
+		/// 写入一条记录，不等待落盘
+		/// <para>
+		/// 当前段加上该记录超过段大小阈值时先滚动到下一个段
+		/// </para>
+		/// </summary>
+		/// <param name="len">要写入的数据长度</param>
+		/// <param name="data">数据</param>
+		/// <returns>该记录的日志序号，用于 WaitDurable</returns>
+		uint64_t Append(size_t len, const void* data);
+		/// <summary>
+		/// 等待日志序号不大于 lsn 的所有记录落盘
+		/// <para>
+		/// 没有其他线程正在同步时由当前线程同步，否则等待正在进行的同步完成，
+		/// 仍未覆盖 lsn 时再由其中一个等待的线程发起下一次同步
+		/// </para>
+		/// <para>
+		/// 同步失败后无法确定哪些记录已经落盘，失败会一直保留：
+		/// 正在等待以及之后的 WaitDurable 与 Append 都抛出该异常，不再重试
+		/// </para>
+		/// </summary>
+		/// <param name="lsn">Append 返回的日志序号，不能大于 GetWrittenLength()</param>
+		void WaitDurable(uint64_t lsn);
+		/// <summary>
+		/// 写入一条记录并等待其落盘
+		/// </summary>
+		/// <param name="len">要写入的数据长度</param>
+		/// <param name="data">数据</param>
+		/// <returns>该记录的日志序号</returns>
+		uint64_t Commit(size_t len, const void* data);
+	public:
+		/// <summary>
+		/// 获取此对象累计写入的字节数，即最后一条记录的日志序号
+		/// </summary>
+		uint64_t GetWrittenLength();
+		/// <summary>
+		/// 获取已经落盘的日志序号
+		/// </summary>
+		uint64_t GetDurableLength();
+		/// <summary>
+		/// 获取当前段的序号
+		/// </summary>
+		uint64_t GetSegmentIndex();
+		/// <summary>
+		/// 获取到目前为止的同步次数，不含滚动段时的同步
+		/// </summary>
+		uint64_t GetSyncCount();
+		/// <summary>
+		/// 获取指定序号的段文件名
+		/// </summary>
+		std::wstring GetSegmentPath(uint64_t index) const;
+	private:
+		void OpenSegment(uint64_t index);
+		void Rotate();
+		//! 记录同步失败，调用时持有 appendMutex
+		void Fail(std::exception_ptr error);
+	private:
+		std::wstring basePath;
+		uint64_t segmentSize;
+
+		//! 保护当前段与写入位置，写入时持有
+		std::mutex appendMutex;
+		//! 滚动时旧段仍可能被正在同步的线程持有
+		std::shared_ptr<FileStream> segment;
+		uint64_t segmentIndex = 0;
+		uint64_t segmentLength = 0;
+		uint64_t written = 0;
+		bool closed = false;
+
+		//! 保护同步状态，持有时不能再获取 appendMutex
+		std::mutex syncMutex;
+		std::condition_variable synced;
+		uint64_t durable = 0;
+		bool syncing = false;
+		uint64_t syncCount = 0;
+		//! 第一次同步失败的异常，同时持有两个锁时写入，持有任一个锁时可读
+		std::exception_ptr failure;
+	};
+}
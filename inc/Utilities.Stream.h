@@ -15,11 +15,23 @@
 	类列表：
 	- 已完成
 		- Utilities::Stream 通用IO流
-		- Utilities::FileStream 文件流
+		- Utilities::FileStream 文件流(配合 Utilities::FileHandleCache 文件句柄缓存)
+		- Utilities::MappedFileStream 内存映射文件流
+		- Utilities::BufferedStream 缓冲流
+		- Utilities::AsyncStreamWriter 异步写入流
+		- Utilities::CachedStream 缓存流(配合 Utilities::BlockCache 块缓存)
+		- Utilities::DirectFileStream 直接IO文件流
+		- Utilities::SegmentedLogStream 分段日志流
+		- Utilities::HashingStream 散列流
+		- Utilities::InstrumentedStream 统计流
+		- Utilities::SubStream 子流
 		- Utiliteis::StreamWriter 流读取器
 		- Utiliteis::StreamReader 流写入器
-	- 计划中
+		- Utilities::RecordWriter / Utilities::RecordReader 记录日志写入器与读取器
+		- Utilities::CsvReader CSV / TSV 读取器
 		- Utilities::MemoryStream 内存流
+		- Utilities::PipeStream 进程内管道流
+	- 计划中
 		- Utilities::NetworkStream 网络流
 */
 
@@ -46,6 +58,33 @@ namespace Utilities
 			ReadWrite,  //!< 可读写流
 			Unkonwn     //!< 未知流
 		};
+		/// <summary>
+		/// 分散读取使用的缓冲区描述
+		/// </summary>
+		struct Segment
+		{
+			void* data;		//!< 缓冲区地址
+			size_t len;		//!< 缓冲区长度
+		};
+		/// <summary>
+		/// 聚集写入使用的缓冲区描述
+		/// </summary>
+		struct ConstSegment
+		{
+			const void* data;	//!< 数据地址
+			size_t len;			//!< 数据长度
+		};
+		/// <summary>
+		/// 告知操作系统一段数据将被如何访问，由支持的流使用
+		/// </summary>
+		enum class AccessHint
+		{
+			Normal,		//!< 恢复缺省的预读行为
+			Sequential,	//!< 将顺序读取，加大预读
+			Random,		//!< 将随机读取，关闭预读
+			WillNeed,	//!< 即将读取，在后台提前读入
+			DontNeed,	//!< 不再读取，可以从页缓存中丢弃
+		};
 	public:
 		Stream() = delete;
 		Stream(const Stream&) = delete;
@@ -75,6 +114,105 @@ namespace Utilities
 		/// </summary>
 		/// <returns>可操作 : true | 不可操作 : false</returns>
 		virtual bool IsVaild() = 0;
+		/// <summary>
+		/// 读取至多 maxLen 字节的数据
+		/// <para>
+		/// 与 Read 不同，剩余数据不足时不会抛出异常，而是返回实际读取的长度。
+		/// 缺省实现对支持定位的流按 GetLength() - GetPosition() 截断后调用一次 Read ，
+		/// 对不支持定位的流逐字节调用 Read 直到读满或到达末尾，派生类应当提供更高效的实现
+		/// </para>
+		/// </summary>
+		/// <param name="maxLen">最多读取的数据长度</param>
+		/// <param name="data">数据写入的目标缓冲区</param>
+		/// <returns>实际读取的数据长度，返回 0 表示已到达流末尾</returns>
+		virtual size_t ReadSome(size_t maxLen, void* data);
+		/// <summary>
+		/// 分散读取接口
+		/// <para>
+		/// 按顺序读取数据依次填满每一个缓冲区，缺省实现对每个缓冲区调用一次 Read
+		/// </para>
+		/// </summary>
+		/// <param name="count">缓冲区个数</param>
+		/// <param name="segments">缓冲区数组</param>
+		virtual void ReadV(size_t count, const Segment* segments);
+		/// <summary>
+		/// 聚集写入接口
+		/// <para>
+		/// 按顺序写入每一个缓冲区中的数据，缺省实现对每个缓冲区调用一次 Write
+		/// </para>
+		/// </summary>
+		/// <param name="count">缓冲区个数</param>
+		/// <param name="segments">缓冲区数组</param>
+		virtual void WriteV(size_t count, const ConstSegment* segments);
+		/// <summary>
+		/// 将流内部缓冲的数据提交到下层设备
+		/// <para>
+		/// 缺省实现不做任何操作
+		/// </para>
+		/// </summary>
+		virtual void Flush();
+		/// <summary>
+		/// 从当前位置读取 len 字节的数据写入到 dst
+		/// <para>
+		/// 缺省实现通过一个中间缓冲区循环调用 ReadSome 与 dst.Write；
+		/// 剩余数据不足 len 字节时抛出异常，此前读到的数据已经写入 dst
+		/// </para>
+		/// </summary>
+		/// <param name="dst">目标流</param>
+		/// <param name="len">要复制的数据长度</param>
+		virtual void CopyTo(Stream& dst, uint64_t len);
+		/// <summary>
+		/// 从指定位置读取数据，不改变当前读写指针
+		/// <para>
+		/// 缺省实现临时移动读写指针完成读取后再恢复，不能与其他读写操作并发；
+		/// 能够真正并发定位读取的流(例如 FileStream)会重写该函数
+		/// </para>
+		/// </summary>
+		/// <param name="offset">流中的偏移量</param>
+		/// <param name="len">要读取的数据长度</param>
+		/// <param name="data">数据写入的目标缓冲区</param>
+		virtual void ReadAt(uint64_t offset, size_t len, void* data);
+		/// <summary>
+		/// 向指定位置写入数据，不改变当前读写指针
+		/// <para>
+		/// 缺省实现临时移动读写指针完成写入后再恢复，不能与其他读写操作并发
+		/// </para>
+		/// </summary>
+		/// <param name="offset">流中的偏移量</param>
+		/// <param name="len">要写入的数据长度</param>
+		/// <param name="data">数据</param>
+		virtual void WriteAt(uint64_t offset, size_t len, const void* data);
+	public:
+		/// <summary>
+		/// 获取流的长度
+		/// <para>
+		/// 不支持定位的流会抛出异常
+		/// </para>
+		/// </summary>
+		virtual uint64_t GetLength();
+		/// <summary>
+		/// 获取当前读写指针的位置
+		/// <para>
+		/// 不支持定位的流会抛出异常
+		/// </para>
+		/// </summary>
+		virtual uint64_t GetPosition();
+		/// <summary>
+		/// 设置当前读写指针的位置
+		/// <para>
+		/// 不支持定位的流会抛出异常
+		/// </para>
+		/// </summary>
+		/// <param name="pos">新的位置</param>
+		virtual void SetPosition(uint64_t pos);
+		/// <summary>
+		/// 移动当前读写指针的位置
+		/// <para>
+		/// 不支持定位的流会抛出异常
+		/// </para>
+		/// </summary>
+		/// <param name="offset">偏移量</param>
+		virtual void Seek(int64_t offset);
 	private:
 		Type streamType = Type::Unkonwn;
 	public:
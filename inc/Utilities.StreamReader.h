@@ -1,5 +1,15 @@
 #pragma once
 #include "Utilities.Stream.h"
+#include "Utilities.Common.Span.h"
+#include "Utilities.Common.Endian.h"
+#include "Utilities.Common.Varint.h"
+#include "Utilities.Common.Scan.h"
+
+#include <cstring>
+#include <optional>
+#include <string_view>
+#include <vector>
+#include <type_traits>
 /**
  @file
  @brief 通用IO流 StreamReader 接口定义及实现
@@ -20,6 +30,24 @@ namespace Utilities
 		int i = sr.read<int>();
 		float f = sr.read<float>();
 		double d = sr.read<double>();
+
+		// 批量读取，只产生一次对流的读取调用
+		float samples[256];
+		sr.ReadArray(samples, 256);
+		auto vertices = sr.ReadVector<Vertex>(vertexCount);
+
+		// 按指定字节序读取，与主机字节序相同时没有额外开销
+		auto magic = sr.ReadBE<uint32>();
+		auto samples = sr.ReadVectorBE<int16>(sampleCount);
+
+		// 变长整数
+		auto id = sr.ReadVarint<uint32>();
+		std::vector<uint64> offsets(entryCount);
+		sr.ReadVarints(offsets.data(), entryCount);
+
+		// 按行读取，返回的视图指向读取器内部的缓冲区
+		while (auto line = sr.ReadLine())
+			Parse(*line);
 	@endcode
 	*/
 	/// <summary>
@@ -31,6 +59,11 @@ namespace Utilities
 	{
 	private:
 		StreamType& rs;
+		//! ReadLine / ReadUntil 预读的数据，有效部分为 [head, tail)
+		std::vector<char> buffer;
+		size_t head = 0;
+		size_t tail = 0;
+		static constexpr size_t LineBufferSize = 64 * 1024;
 	public:
 		StreamReader(StreamType& stream) : rs(stream) { };
 		~StreamReader() { };
@@ -52,12 +85,266 @@ namespace Utilities
 		{
 			static_assert(std::is_pod_v<DataType>, "Object must be pod!");
 			DataType t;
-			rs.Read(sizeof(DataType), &t);
+			ReadRaw(sizeof(DataType), &t);
 			return t;
 		}
+		/// <summary>
+		/// 从流中读取 count 个指定类型的数据到 dst 中
+		/// <para>
+		/// 无论 count 为多少都只会产生一次对流的读取调用
+		/// </para>
+		/// </summary>
+		/// <param name="dst">目标数组</param>
+		/// <param name="count">元素个数</param>
+		template<typename DataType>
+		void ReadArray(DataType* dst, size_t count)
+		{
+			static_assert(std::is_pod_v<DataType>, "Object must be pod!");
+			if (count > SIZE_MAX / sizeof(DataType))
+				throw Exception(u8"Error occured when reading stream : Length_Overflow");
+			ReadRaw(sizeof(DataType) * count, dst);
+		}
+		/// <summary>
+		/// 从流中读取数据填满 dst
+		/// </summary>
+		template<typename DataType>
+		void ReadArray(Common::Span<DataType> dst)
+		{
+			ReadArray(dst.data(), dst.size());
+		}
+		/// <summary>
+		/// 从流中读取 count 个指定类型的数据并以 std::vector 返回
+		/// </summary>
+		/// <param name="count">元素个数</param>
+		template<typename DataType>
+		std::vector<DataType> ReadVector(size_t count)
+		{
+			std::vector<DataType> v(count);
+			ReadArray(v.data(), count);
+			return v;
+		}
+	public:
+		/// <summary>
+		/// 从流中读取以小端字节序存储的数值
+		/// </summary>
+		template<typename DataType>
+		DataType ReadLE()
+		{
+			return Common::ConvertEndian<Common::Endian::Little>(Read<DataType>());
+		}
+		/// <summary>
+		/// 从流中读取以大端字节序存储的数值
+		/// </summary>
+		template<typename DataType>
+		DataType ReadBE()
+		{
+			return Common::ConvertEndian<Common::Endian::Big>(Read<DataType>());
+		}
+		/// <summary>
+		/// 从流中读取 count 个以小端字节序存储的数值到 dst 中
+		/// <para>
+		/// 字节序与主机不同时在读取后对整个数组做一次批量转换
+		/// </para>
+		/// </summary>
+		/// <param name="dst">目标数组</param>
+		/// <param name="count">元素个数</param>
+		template<typename DataType>
+		void ReadArrayLE(DataType* dst, size_t count)
+		{
+			ReadArray(dst, count);
+			Common::ConvertEndianArray<Common::Endian::Little>(dst, count);
+		}
+		/// <summary>
+		/// 从流中读取 count 个以大端字节序存储的数值到 dst 中
+		/// <para>
+		/// 字节序与主机不同时在读取后对整个数组做一次批量转换
+		/// </para>
+		/// </summary>
+		/// <param name="dst">目标数组</param>
+		/// <param name="count">元素个数</param>
+		template<typename DataType>
+		void ReadArrayBE(DataType* dst, size_t count)
+		{
+			ReadArray(dst, count);
+			Common::ConvertEndianArray<Common::Endian::Big>(dst, count);
+		}
+		/// <summary>
+		/// 从流中读取 count 个以小端字节序存储的数值并以 std::vector 返回
+		/// </summary>
+		/// <param name="count">元素个数</param>
+		template<typename DataType>
+		std::vector<DataType> ReadVectorLE(size_t count)
+		{
+			std::vector<DataType> v(count);
+			ReadArrayLE(v.data(), count);
+			return v;
+		}
+		/// <summary>
+		/// 从流中读取 count 个以大端字节序存储的数值并以 std::vector 返回
+		/// </summary>
+		/// <param name="count">元素个数</param>
+		template<typename DataType>
+		std::vector<DataType> ReadVectorBE(size_t count)
+		{
+			std::vector<DataType> v(count);
+			ReadArrayBE(v.data(), count);
+			return v;
+		}
+	public:
+		/// <summary>
+		/// 从流中读取一个变长整数
+		/// <para>
+		/// 有符号类型按 zigzag 映射解码，数值超出 DataType 的范围时抛出异常
+		/// </para>
+		/// <para>
+		/// 编码长度事先未知，只能逐字节读取；对无缓冲的流请先用 BufferedStream 包装
+		/// </para>
+		/// </summary>
+		template<typename DataType>
+		DataType ReadVarint()
+		{
+			uint64_t value = 0;
+			for (size_t i = 0; i < Common::MaxVarintLength; i++)
+			{
+				uint8_t b;
+				ReadRaw(1, &b);
+				if (i == Common::MaxVarintLength - 1 && b > 1)
+					break;
+				value |= static_cast<uint64_t>(b & 0x7F) << (7 * i);
+				if ((b & 0x80) == 0)
+					return Common::FromVarint<DataType>(value);
+			}
+			throw Exception(u8"Error occured when reading stream : Varint_Overflow");
+		}
+		/// <summary>
+		/// 从流中读取 count 个无符号变长整数到 dst 中
+		/// <para>
+		/// 分块读取并批量解码；剩下的每个值至少还有 1 字节，按剩余个数读取不会越过最后一个值
+		/// </para>
+		/// </summary>
+		/// <param name="dst">目标数组</param>
+		/// <param name="count">元素个数</param>
+		void ReadVarints(uint64_t* dst, size_t count)
+		{
+			constexpr size_t ChunkSize = 4096;
+			uint8_t buffer[ChunkSize + Common::MaxVarintLength];
+			size_t pending = 0;
+			while (count != 0)
+			{
+				auto len = count < ChunkSize ? count : ChunkSize;
+				ReadRaw(len, buffer + pending);
+				size_t consumed;
+				auto n = Common::DecodeVarints(buffer, pending + len, dst, count, consumed);
+				dst += n;
+				count -= n;
+				// 不完整的编码最多 MaxVarintLength - 1 字节，留到下一轮继续解码
+				pending = pending + len - consumed;
+				memmove(buffer, buffer + consumed, pending);
+			}
+		}
+		/// <summary>
+		/// 从流中读取 count 个按 zigzag 映射编码的有符号变长整数到 dst 中
+		/// </summary>
+		/// <param name="dst">目标数组</param>
+		/// <param name="count">元素个数</param>
+		void ReadVarints(int64_t* dst, size_t count)
+		{
+			auto raw = reinterpret_cast<uint64_t*>(dst);
+			ReadVarints(raw, count);
+			for (size_t i = 0; i < count; i++)
+				dst[i] = Common::ZigZagDecode(raw[i]);
+		}
+	public:
+		/// <summary>
+		/// 读取直到遇到 delim 为止的数据
+		/// <para>
+		/// 返回的视图不包含 delim，指向读取器内部的缓冲区，在下一次调用 ReadLine / ReadUntil 前有效；
+		/// 一段数据跨越多次填充时会把已读部分移到缓冲区开头，超过缓冲区大小时缓冲区会扩大
+		/// </para>
+		/// <para>
+		/// 读取器会预读数据，之后的读取都应通过该读取器进行，不要再直接读取流
+		/// </para>
+		/// </summary>
+		/// <param name="delim">分隔符</param>
+		/// <returns>读到的数据；流已结束且没有剩余数据时返回 std::nullopt</returns>
+		std::optional<std::string_view> ReadUntil(char delim)
+		{
+			if (buffer.empty())
+				buffer.resize(LineBufferSize);
+			// 已经查找过的数据不再重复查找
+			size_t scanned = head;
+			while (true)
+			{
+				auto first = buffer.data() + scanned;
+				auto last = buffer.data() + tail;
+				auto hit = Common::FindByte(first, last, delim);
+				if (hit != last)
+				{
+					std::string_view result(buffer.data() + head, hit - (buffer.data() + head));
+					head = hit - buffer.data() + 1;
+					return result;
+				}
+				scanned = tail;
+
+				if (head != 0)
+				{
+					memmove(buffer.data(), buffer.data() + head, tail - head);
+					scanned -= head;
+					tail -= head;
+					head = 0;
+				}
+				if (tail == buffer.size())
+					buffer.resize(buffer.size() * 2);
+				auto n = rs.ReadSome(buffer.size() - tail, buffer.data() + tail);
+				if (n == 0)
+				{
+					if (head == tail)
+						return std::nullopt;
+					std::string_view result(buffer.data() + head, tail - head);
+					head = tail;
+					return result;
+				}
+				tail += n;
+			}
+		}
+		/// <summary>
+		/// 读取一行文本
+		/// <para>
+		/// 以 '\n' 分行，行尾的 '\r' 会被去掉；最后一行可以没有换行符
+		/// </para>
+		/// <para>
+		/// 返回的视图在下一次调用 ReadLine / ReadUntil 前有效
+		/// </para>
+		/// </summary>
+		/// <returns>读到的一行；流已结束时返回 std::nullopt</returns>
+		std::optional<std::string_view> ReadLine()
+		{
+			auto line = ReadUntil('\n');
+			if (line && !line->empty() && line->back() == '\r')
+				line->remove_suffix(1);
+			return line;
+		}
+	private:
+		/// <summary>
+		/// 先取出 ReadLine / ReadUntil 预读的数据，不足的部分再从流中读取
+		/// </summary>
+		void ReadRaw(size_t len, void* dst)
+		{
+			auto buffered = tail - head;
+			if (buffered != 0)
+			{
+				auto n = len < buffered ? len : buffered;
+				memcpy(dst, buffer.data() + head, n);
+				head += n;
+				len -= n;
+				dst = static_cast<char*>(dst) + n;
+			}
+			if (len != 0)
+				rs.Read(len, dst);
+		}
 	};
 
-#ifdef _INC_STDIO
+#if defined(_INC_STDIO) || defined(_STDIO_H)
 	template<>
 	class StreamReader<FILE*>
 	{
@@ -74,6 +361,25 @@ namespace Utilities
 			fread(&t, 1, sizeof(DataType), rs);
 			return t;
 		}
+		template<typename DataType>
+		void ReadArray(DataType* dst, size_t count)
+		{
+			static_assert(std::is_pod_v<DataType>, "Object must be pod!");
+			if (fread(dst, sizeof(DataType), count, rs) != count)
+				throw Exception(u8"Error occured when reading stream : End_Of_Stream");
+		}
+		template<typename DataType>
+		void ReadArray(Common::Span<DataType> dst)
+		{
+			ReadArray(dst.data(), dst.size());
+		}
+		template<typename DataType>
+		std::vector<DataType> ReadVector(size_t count)
+		{
+			std::vector<DataType> v(count);
+			ReadArray(v.data(), count);
+			return v;
+		}
 	};
 #endif // _INC_STDIO
 
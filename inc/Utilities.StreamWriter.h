@@ -1,5 +1,13 @@
 #pragma once
 #include "Utilities.Stream.h"
+#include "Utilities.Common.Span.h"
+#include "Utilities.Common.Endian.h"
+#include "Utilities.Common.Varint.h"
+#include "Utilities.Common.Format.h"
+
+#include <cstring>
+#include <vector>
+#include <type_traits>
 /**
  @file
  @brief 通用IO流 StreamWriter 接口定义及实现
@@ -20,6 +28,12 @@ namespace Utilities
 		sw.Write(s);
 		sw.Write(u8"hello world\n");
 
+		// 不经过 iostream 直接格式化数值
+		sw.WriteInt(-42);
+		sw.WriteHex(0x414fa339u, 8);
+		sw.WriteFloat(3.14159, 2);
+		sw.Format("{},{},{:.3}\n", id, name, score);
+
 		@endcode
 
 		二进制模式写入:
@@ -29,6 +43,15 @@ namespace Utilities
 		sw.Write(125);		//sw.write<int>()
 		sw.Write(124.5);	//sw.write<double>()
 
+		std::vector<Vertex> vertices = ...;
+		sw.WriteArray(vertices);	// 只产生一次对流的写入调用
+
+		sw.WriteBE<uint32>(0x89504E47);	// 按大端字节序写入
+		sw.WriteArrayBE(samples);
+
+		sw.WriteVarint(id);	// 小的数值只占 1 到 2 个字节
+		sw.WriteVarints(offsets);
+
 		@endcode
 	*/
 	/// <summary>
@@ -53,13 +76,217 @@ namespace Utilities
 			rs.Write(sizeof(DataType), &obj);
 		}
 		/// <summary>
+		/// 向流中写入 count 个指定类型的数据
+		/// <para>
+		/// 无论 count 为多少都只会产生一次对流的写入调用
+		/// </para>
+		/// </summary>
+		/// <param name="src">数据</param>
+		/// <param name="count">元素个数</param>
+		template<typename DataType>
+		void WriteArray(const DataType* src, size_t count)
+		{
+			static_assert(std::is_pod_v<DataType>, "Object must be pod!");
+			if (count > SIZE_MAX / sizeof(DataType))
+				throw Exception(u8"Error occured when writing stream : Length_Overflow");
+			rs.Write(sizeof(DataType) * count, src);
+		}
+		/// <summary>
+		/// 向流中写入 Span 引用的全部数据
+		/// </summary>
+		template<typename DataType>
+		void WriteArray(Common::Span<DataType> src)
+		{
+			WriteArray<std::remove_cv_t<DataType>>(src.data(), src.size());
+		}
+		/// <summary>
+		/// 向流中写入 std::vector 中的全部数据
+		/// </summary>
+		template<typename DataType>
+		void WriteArray(const std::vector<DataType>& src)
+		{
+			WriteArray(src.data(), src.size());
+		}
+		/// <summary>
+		/// 以小端字节序向流中写入数值
+		/// </summary>
+		template<typename DataType>
+		void WriteLE(DataType obj)
+		{
+			Write(Common::ConvertEndian<Common::Endian::Little>(obj));
+		}
+		/// <summary>
+		/// 以大端字节序向流中写入数值
+		/// </summary>
+		template<typename DataType>
+		void WriteBE(DataType obj)
+		{
+			Write(Common::ConvertEndian<Common::Endian::Big>(obj));
+		}
+		/// <summary>
+		/// 以小端字节序向流中写入 count 个数值
+		/// <para>
+		/// 字节序与主机相同时只产生一次写入调用；
+		/// 否则分块批量转换到临时缓冲区后写入，不修改 src
+		/// </para>
+		/// </summary>
+		/// <param name="src">数据</param>
+		/// <param name="count">元素个数</param>
+		template<typename DataType>
+		void WriteArrayLE(const DataType* src, size_t count)
+		{
+			WriteArrayEndian<Common::Endian::Little>(src, count);
+		}
+		/// <summary>
+		/// 以大端字节序向流中写入 count 个数值
+		/// <para>
+		/// 字节序与主机相同时只产生一次写入调用；
+		/// 否则分块批量转换到临时缓冲区后写入，不修改 src
+		/// </para>
+		/// </summary>
+		/// <param name="src">数据</param>
+		/// <param name="count">元素个数</param>
+		template<typename DataType>
+		void WriteArrayBE(const DataType* src, size_t count)
+		{
+			WriteArrayEndian<Common::Endian::Big>(src, count);
+		}
+		/// <summary>
+		/// 以小端字节序向流中写入 std::vector 中的全部数值
+		/// </summary>
+		template<typename DataType>
+		void WriteArrayLE(const std::vector<DataType>& src)
+		{
+			WriteArrayLE(src.data(), src.size());
+		}
+		/// <summary>
+		/// 以大端字节序向流中写入 std::vector 中的全部数值
+		/// </summary>
+		template<typename DataType>
+		void WriteArrayBE(const std::vector<DataType>& src)
+		{
+			WriteArrayBE(src.data(), src.size());
+		}
+		/// <summary>
+		/// 以变长整数编码向流中写入整数
+		/// <para>
+		/// 无符号类型使用 LEB128 编码，有符号类型先做 zigzag 映射
+		/// </para>
+		/// </summary>
+		template<typename DataType>
+		void WriteVarint(DataType value)
+		{
+			uint8_t buffer[Common::MaxVarintLength];
+			rs.Write(Common::EncodeVarint(Common::ToVarint(value), buffer), buffer);
+		}
+		/// <summary>
+		/// 以变长整数编码向流中写入 count 个整数
+		/// <para>
+		/// 先编码到临时缓冲区，每 4K 左右产生一次写入调用
+		/// </para>
+		/// </summary>
+		/// <param name="src">数据</param>
+		/// <param name="count">元素个数</param>
+		template<typename DataType>
+		void WriteVarints(const DataType* src, size_t count)
+		{
+			constexpr size_t ChunkSize = 4096;
+			uint8_t buffer[ChunkSize + Common::MaxVarintLength];
+			size_t len = 0;
+			for (size_t i = 0; i < count; i++)
+			{
+				len += Common::EncodeVarint(Common::ToVarint(src[i]), buffer + len);
+				if (len >= ChunkSize)
+				{
+					rs.Write(len, buffer);
+					len = 0;
+				}
+			}
+			if (len != 0)
+				rs.Write(len, buffer);
+		}
+		/// <summary>
+		/// 以变长整数编码向流中写入 std::vector 中的全部整数
+		/// </summary>
+		template<typename DataType>
+		void WriteVarints(const std::vector<DataType>& src)
+		{
+			WriteVarints(src.data(), src.size());
+		}
+		/// <summary>
+		/// 以十进制文本向流中写入整数
+		/// </summary>
+		template<typename DataType>
+		void WriteInt(DataType value)
+		{
+			char buffer[Common::MaxNumberChars];
+			rs.Write(Common::FormatInt(buffer, value) - buffer, buffer);
+		}
+		/// <summary>
+		/// 以十六进制文本向流中写入整数
+		/// </summary>
+		/// <param name="value">整数</param>
+		/// <param name="width">最小宽度，不足时在前面补 0</param>
+		/// <param name="upper">是否使用大写字母</param>
+		template<typename DataType>
+		void WriteHex(DataType value, size_t width = 0, bool upper = false)
+		{
+			char buffer[Common::MaxNumberChars];
+			rs.Write(Common::FormatHex(buffer, value, width, upper) - buffer, buffer);
+		}
+		/// <summary>
+		/// 以能够精确还原的最短形式向流中写入浮点数
+		/// </summary>
+		template<typename DataType>
+		void WriteFloat(DataType value)
+		{
+			static_assert(std::is_floating_point_v<DataType>, "Type must be a floating point type!");
+			char buffer[Common::MaxNumberChars];
+			rs.Write(Common::FormatFloat(buffer, value) - buffer, buffer);
+		}
+		/// <summary>
+		/// 以固定的小数位数向流中写入浮点数
+		/// </summary>
+		/// <param name="value">浮点数</param>
+		/// <param name="precision">小数位数</param>
+		void WriteFloat(double value, int precision)
+		{
+			char buffer[Common::MaxNumberChars];
+			rs.Write(Common::FormatFloat(buffer, value, precision) - buffer, buffer);
+		}
+		/**
+			例子：
+			@code
+				sw.Format("{},{},{:.2}\n", id, name, price);	// 42,apple,3.50
+				sw.Format("crc = {:x}, {{raw}}\n", crc);		// crc = 414fa339, {raw}
+			@endcode
+		*/
+		/// <summary>
+		/// 按格式字符串向流中写入文本
+		/// <para>
+		/// "{}" 依次被参数替换，参数可以是整数、浮点数、bool、char 以及字符串；
+		/// 格式化在栈上的缓冲区中完成，通常只产生一次对流的写入调用
+		/// </para>
+		/// </summary>
+		/// <param name="format">格式字符串，详见 Common::FormatTo</param>
+		/// <param name="args">参数</param>
+		template<typename... Args>
+		void Format(std::string_view format, const Args&... args)
+		{
+			const Common::FormatArg list[] = { Common::FormatArg(args)..., Common::FormatArg() };
+			Common::FormatTo(format, list, sizeof...(Args), [](void* context, const char* data, size_t len)
+				{
+					static_cast<StreamType*>(context)->Write(len, data);
+				}, &rs);
+		}
+		/// <summary>
 		/// 显式的向流中写入字符串对象
 		/// </summary>
 		template<typename StringType = u8string>
 		void WriteString(const StringType& string)
 		{
 			auto len = string.size();
-			rs.Write(sizeof(string::value_type) * len, string.data());
+			rs.Write(sizeof(typename StringType::value_type) * len, string.data());
 		}
 
 
@@ -73,13 +300,12 @@ namespace Utilities
 		}
 
 		/// <summary>
-		/// 特化模板
+		/// 字符串对象的重载
 		/// <para>
 		/// 对该函数的调用会被转发至 StreamWriter::WriteString()
 		/// </para>
 		/// </summary>
-		template<>
-		void Write<u8string>(const u8string& obj)
+		void Write(const u8string& obj)
 		{
 			WriteString(obj);
 		}
@@ -93,10 +319,33 @@ namespace Utilities
 		{
 			WriteString(string);
 		}
+	private:
+		template<Common::Endian Order, typename DataType>
+		void WriteArrayEndian(const DataType* src, size_t count)
+		{
+			static_assert(Common::IsEndianConvertible<DataType>, "Type must be an arithmetic or enum type of 1, 2, 4 or 8 bytes!");
+			if constexpr (Order == Common::Endian::Native || sizeof(DataType) == 1)
+			{
+				WriteArray(src, count);
+			}
+			else
+			{
+				constexpr size_t ChunkCount = 4096 / sizeof(DataType);
+				DataType chunk[ChunkCount];
+				while (count != 0)
+				{
+					auto n = count < ChunkCount ? count : ChunkCount;
+					Common::ByteSwapBuffer(chunk, src, n, sizeof(DataType));
+					rs.Write(sizeof(DataType) * n, chunk);
+					src += n;
+					count -= n;
+				}
+			}
+		}
 	};
 
 
-#ifdef _INC_STDIO
+#if defined(_INC_STDIO) || defined(_STDIO_H)
 	/**
 		使用案例:
 		@code
@@ -125,16 +374,31 @@ namespace Utilities
 			static_assert(std::is_pod_v<DataType>, "Object must be pod!");
 			fwrite(&obj, 1, sizeof(DataType), rs);
 		}
+		template<typename DataType>
+		void WriteArray(const DataType* src, size_t count)
+		{
+			static_assert(std::is_pod_v<DataType>, "Object must be pod!");
+			fwrite(src, sizeof(DataType), count, rs);
+		}
+		template<typename DataType>
+		void WriteArray(Common::Span<DataType> src)
+		{
+			WriteArray<std::remove_cv_t<DataType>>(src.data(), src.size());
+		}
+		template<typename DataType>
+		void WriteArray(const std::vector<DataType>& src)
+		{
+			WriteArray(src.data(), src.size());
+		}
 		template<typename StringType>
 		void WriteString(const StringType& string)
 		{
 			auto len = string.size();
-			fwrite(string.data(), 1, sizeof(string::value_type) * len, rs);
+			fwrite(string.data(), 1, sizeof(typename StringType::value_type) * len, rs);
 		}
 
 		void WriteString(const char* string);
-		template<>
-		void Write<u8string>(const u8string& obj);
+		void Write(const u8string& obj);
 		void Write(const char* string);
 	};
 
@@ -0,0 +1,126 @@
+/**
+ @file
+ @brief 通用IO库 子流接口定义
+
+ @author 司马坑
+ @date 2026/10/17
+*/
+#pragma once
+#include "Utilities.Stream.h"
+
+namespace Utilities
+{
+	/**
+		使用方式：
+		@code
+			FileStream pack(L"assets.pak", Stream::Type::ReadOnly, false);
+
+			// 每个线程读取自己的条目，互不影响，也不改变 pack 的读写指针
+			SubStream entry(pack, header.offset, header.size);
+			auto sr = StreamReader(entry);
+			auto magic = sr.Read<uint32>();
+			auto pixels = sr.ReadVector<uint8>(entry.GetLength() - sizeof(magic));
+		@endcode
+	*/
+	/// <summary>
+	/// 子流对象
+	/// <para>
+	/// 把父流中 [offset, offset + length) 的一段区域作为一个独立的流，拥有自己的读写指针和边界检查
+	/// </para>
+	/// <para>
+	/// 所有读写都通过父流的 ReadAt / WriteAt 完成，不使用也不改变父流的读写指针；
+	/// 父流支持并发定位读取时(例如 FileStream、MemoryStream)，同一父流上的多个子流可以在不同线程中同时读取
+	/// </para>
+	/// </summary>
+	class SubStream final : public Stream
+	{
+	public:
+		/// <summary>
+		/// 在父流上创建一个子流
+		/// <para>
+		/// 父流的生命周期必须长于子流，子流的读写类型与父流相同
+		/// </para>
+		/// </summary>
+		/// <param name="parent">父流</param>
+		/// <param name="offset">区域在父流中的起始位置</param>
+		/// <param name="length">区域长度</param>
+		SubStream(Stream& parent, uint64_t offset, uint64_t length);
+		SubStream(const SubStream&) = delete;
+		SubStream& operator=(const SubStream&) = delete;
+	public:
+		/// <summary>
+		/// 流对象读取接口
+		/// </summary>
+		/// <param name="len">要读取的数据长度</param>
+		/// <param name="data">数据写入的目标缓冲区</param>
+		virtual void Read(size_t len, void* data) override;
+		/// <summary>
+		/// 流对象写入接口
+		/// <para>
+		/// 子流的长度固定，写入超出区域末尾时抛出异常
+		/// </para>
+		/// </summary>
+		/// <param name="len">要写入的数据长度</param>
+		/// <param name="data">数据</param>
+		virtual void Write(size_t len, const void* data) override;
+		/// <summary>
+		/// 关闭子流，不影响父流
+		/// </summary>
+		virtual void Close() override;
+		/// <summary>
+		/// 检测流对象是否可用
+		/// </summary>
+		virtual bool IsVaild() override;
+		/// <summary>
+		/// 读取至多 maxLen 字节的数据
+		/// </summary>
+		/// <param name="maxLen">最多读取的数据长度</param>
+		/// <param name="data">数据写入的目标缓冲区</param>
+		/// <returns>实际读取的数据长度</returns>
+		virtual size_t ReadSome(size_t maxLen, void* data) override;
+		/// <summary>
+		/// 从子流中的指定位置读取数据
+		/// </summary>
+		/// <param name="offset">子流中的偏移量</param>
+		/// <param name="len">要读取的数据长度</param>
+		/// <param name="data">数据写入的目标缓冲区</param>
+		virtual void ReadAt(uint64_t offset, size_t len, void* data) override;
+		/// <summary>
+		/// 向子流中的指定位置写入数据
+		/// </summary>
+		/// <param name="offset">子流中的偏移量</param>
+		/// <param name="len">要写入的数据长度</param>
+		/// <param name="data">数据</param>
+		virtual void WriteAt(uint64_t offset, size_t len, const void* data) override;
+	public:
+		/// <summary>
+		/// 获取子流的长度
+		/// </summary>
+		virtual uint64_t GetLength() override;
+		/// <summary>
+		/// 获取当前读写指针的位置
+		/// </summary>
+		virtual uint64_t GetPosition() override;
+		/// <summary>
+		/// 设置当前读写指针的位置
+		/// </summary>
+		/// <param name="pos"></param>
+		virtual void SetPosition(uint64_t pos) override;
+		/// <summary>
+		/// 移动当前读写指针的位置
+		/// </summary>
+		/// <param name="offset">偏移量</param>
+		virtual void Seek(int64_t offset) override;
+	public:
+		/// <summary>
+		/// 获取区域在父流中的起始位置
+		/// </summary>
+		uint64_t GetOffset() const { return offset; }
+	private:
+		Stream& parent;
+		uint64_t offset;
+		uint64_t length;
+		uint64_t position = 0;
+		bool closed = false;
+	};
+}
@@ -16,6 +16,7 @@
 #include <cstdint>
 #include <string>
 #include <exception>
+#include <stdexcept>
 
 namespace Utilities 
 {
@@ -39,7 +40,22 @@ namespace Utilities
 
     using string = u32string;           //!< UCS-4 字符串类型
 
+#ifdef _MSC_VER
 	using Exception = std::exception;   //!< 异常类型
+#else
+	/// <summary>
+	/// 异常类型
+	/// <para>
+	/// MSVC 的 std::exception 可以直接携带错误信息，其他编译器上以 std::runtime_error 提供同样的构造方式
+	/// </para>
+	/// </summary>
+	class Exception : public std::runtime_error
+	{
+	public:
+		using std::runtime_error::runtime_error;
+		Exception() : std::runtime_error("") {}
+	};
+#endif
     using Handle = void*;               //!< 句柄类型
 
     struct byte
@@ -0,0 +1,605 @@
+/**
+ @file
+ @brief 通用IO库 异步IO引擎实现
+
+ io_uring 部分直接使用系统调用，不依赖 liburing：
+	- 提交队列由 sqLock 保护，多个线程可以同时发起请求
+	- 收割线程阻塞在 io_uring_enter(GETEVENTS) 上，处理完成事件并调用完成回调
+	- 读写只完成了一部分时由收割线程继续提交剩余的部分
+	- io_uring_enter 出现无法恢复的错误时引擎进入失效状态，所有未完成的请求以该错误结束，之后的请求直接抛出异常
+
+ @author 司马坑
+ @date 2026/10/17
+*/
+#include "Utilities.AsyncIO.h"
+#include "Utilities.Platform.h"
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <queue>
+#include <vector>
+#include <functional>
+#include <memory>
+#include <algorithm>
+#include <unordered_set>
+#include <cstring>
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#define UTILITIES_HAS_IO_URING 1
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace Utilities
+{
+	//! 当前线程上打开了批量提交作用域的引擎，嵌套的作用域使同一个引擎出现多次
+	static thread_local std::vector<const void*> batchScopes;
+
+	static bool InBatch(const void* impl)
+	{
+		return std::find(batchScopes.begin(), batchScopes.end(), impl) != batchScopes.end();
+	}
+
+#ifdef UTILITIES_HAS_IO_URING
+	/// <summary>
+	/// 一次 io_uring 请求的上下文，地址作为 user_data 传给内核
+	/// </summary>
+	struct UringRequest
+	{
+		AsyncIOEngine::Completion done;
+		int fd;
+		bool isWrite;
+		uint8* data;
+		size_t remaining;
+		uint64_t offset;
+	};
+#endif
+
+	struct AsyncIOEngine::Impl
+	{
+		bool useUring = false;
+#ifdef UTILITIES_HAS_IO_URING
+		int ringFd = -1;
+		void* sqRing = MAP_FAILED;
+		void* cqRing = MAP_FAILED;
+		size_t sqRingSize = 0;
+		size_t cqRingSize = 0;
+		io_uring_sqe* sqes = reinterpret_cast<io_uring_sqe*>(MAP_FAILED);
+		size_t sqesSize = 0;
+		unsigned* sqTail = nullptr;
+		unsigned* sqMask = nullptr;
+		unsigned* sqArray = nullptr;
+		unsigned* cqHead = nullptr;
+		unsigned* cqTail = nullptr;
+		unsigned* cqMask = nullptr;
+		io_uring_cqe* cqes = nullptr;
+		unsigned capacity = 0;
+
+		std::mutex sqLock;
+		std::condition_variable slotFree;
+		//! 已经放入提交队列但尚未提交给内核的请求数
+		unsigned pending = 0;
+		//! 已经放入提交队列但尚未完成的请求数
+		unsigned inflight = 0;
+		//! 尚未完成的请求，引擎失效时由此找到需要通知的请求
+		std::unordered_set<UringRequest*> requests;
+		//! 引擎失效的原因，不为空时不再接受新的请求
+		std::exception_ptr broken;
+		bool stopping = false;
+		std::thread reaper;
+
+		bool SetupUring(unsigned entries);
+		void TeardownUring();
+		void Prepare(UringRequest* request);
+		void PrepareNop();
+		void SubmitLocked();
+		void Reap();
+		void Complete(io_uring_cqe& cqe);
+		void Fail(std::unique_lock<std::mutex>& lock, std::exception_ptr error);
+#endif
+		std::vector<std::thread> workers;
+		std::queue<std::function<void()>> tasks;
+		std::mutex taskLock;
+		std::condition_variable taskReady;
+		bool stop = false;
+
+		void Start(FileStream& stream, bool isWrite, uint64_t offset, size_t len, uint8* data, Completion done);
+		void StartWorkers(unsigned count);
+		void StopWorkers();
+		void Post(std::function<void()> task);
+	};
+
+#ifdef UTILITIES_HAS_IO_URING
+	static int UringSetup(unsigned entries, io_uring_params* params)
+	{
+		return static_cast<int>(syscall(__NR_io_uring_setup, entries, params));
+	}
+	static int UringEnter(int fd, unsigned toSubmit, unsigned minComplete, unsigned flags)
+	{
+		return static_cast<int>(syscall(__NR_io_uring_enter, fd, toSubmit, minComplete, flags, nullptr, 0));
+	}
+	static int UringRegister(int fd, unsigned opcode, void* arg, unsigned count)
+	{
+		return static_cast<int>(syscall(__NR_io_uring_register, fd, opcode, arg, count));
+	}
+
+	bool AsyncIOEngine::Impl::SetupUring(unsigned entries)
+	{
+		io_uring_params params = {};
+		ringFd = UringSetup(entries, &params);
+		if (ringFd < 0)
+			return false;
+
+		sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+		cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+		if (params.features & IORING_FEAT_SINGLE_MMAP)
+		{
+			if (cqRingSize > sqRingSize)
+				sqRingSize = cqRingSize;
+			cqRingSize = sqRingSize;
+		}
+		sqRing = mmap(nullptr, sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_SQ_RING);
+		if (sqRing == MAP_FAILED)
+			return false;
+		if (params.features & IORING_FEAT_SINGLE_MMAP)
+			cqRing = sqRing;
+		else
+		{
+			cqRing = mmap(nullptr, cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_CQ_RING);
+			if (cqRing == MAP_FAILED)
+				return false;
+		}
+		sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+		sqes = static_cast<io_uring_sqe*>(mmap(nullptr, sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_SQES));
+		if (sqes == MAP_FAILED)
+			return false;
+
+		auto sq = static_cast<uint8*>(sqRing);
+		auto cq = static_cast<uint8*>(cqRing);
+		sqTail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+		sqMask = reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+		sqArray = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+		cqHead = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+		cqTail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+		cqMask = reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+		cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+		// 同时处理中的请求数不超过提交队列长度，完成队列就不会溢出
+		capacity = params.sq_entries;
+
+		// 较老的内核不支持 IORING_OP_READ / IORING_OP_WRITE
+		std::vector<uint8> probeBuffer(sizeof(io_uring_probe) + 256 * sizeof(io_uring_probe_op));
+		auto probe = reinterpret_cast<io_uring_probe*>(probeBuffer.data());
+		if (UringRegister(ringFd, IORING_REGISTER_PROBE, probe, 256) < 0)
+			return false;
+		for (auto op : { IORING_OP_READ, IORING_OP_WRITE, IORING_OP_NOP })
+			if (op > probe->last_op || !(probe->ops[op].flags & IO_URING_OP_SUPPORTED))
+				return false;
+		return true;
+	}
+	void AsyncIOEngine::Impl::TeardownUring()
+	{
+		if (sqes != MAP_FAILED)
+			munmap(sqes, sqesSize);
+		if (cqRing != MAP_FAILED && cqRing != sqRing)
+			munmap(cqRing, cqRingSize);
+		if (sqRing != MAP_FAILED)
+			munmap(sqRing, sqRingSize);
+		if (ringFd >= 0)
+			::close(ringFd);
+		sqes = reinterpret_cast<io_uring_sqe*>(MAP_FAILED);
+		sqRing = cqRing = MAP_FAILED;
+		ringFd = -1;
+	}
+	void AsyncIOEngine::Impl::Prepare(UringRequest* request)
+	{
+		// 调用者持有 sqLock 并保证队列中有空位
+		auto tail = *sqTail;
+		auto index = tail & *sqMask;
+		auto& sqe = sqes[index];
+		memset(&sqe, 0, sizeof(sqe));
+		sqe.opcode = request->isWrite ? IORING_OP_WRITE : IORING_OP_READ;
+		sqe.fd = request->fd;
+		sqe.addr = reinterpret_cast<uint64_t>(request->data);
+		sqe.len = static_cast<uint32_t>(request->remaining > 0x7FFFF000u ? 0x7FFFF000u : request->remaining);
+		sqe.off = request->offset;
+		sqe.user_data = reinterpret_cast<uint64_t>(request);
+		sqArray[index] = index;
+		__atomic_store_n(sqTail, tail + 1, __ATOMIC_RELEASE);
+		pending++;
+		inflight++;
+	}
+	void AsyncIOEngine::Impl::PrepareNop()
+	{
+		auto tail = *sqTail;
+		auto index = tail & *sqMask;
+		auto& sqe = sqes[index];
+		memset(&sqe, 0, sizeof(sqe));
+		sqe.opcode = IORING_OP_NOP;
+		sqe.user_data = 0;
+		sqArray[index] = index;
+		__atomic_store_n(sqTail, tail + 1, __ATOMIC_RELEASE);
+		pending++;
+		inflight++;
+	}
+	void AsyncIOEngine::Impl::SubmitLocked()
+	{
+		while (pending != 0)
+		{
+			auto submitted = UringEnter(ringFd, pending, 0, 0);
+			if (submitted < 0)
+			{
+				if (errno == EINTR || errno == EAGAIN || errno == EBUSY)
+					continue;
+				_private::ThrowSystemError(u8"Error occured when submitting io_uring request :");
+			}
+			pending -= static_cast<unsigned>(submitted);
+		}
+	}
+	void AsyncIOEngine::Impl::Complete(io_uring_cqe& cqe)
+	{
+		auto request = reinterpret_cast<UringRequest*>(cqe.user_data);
+		std::unique_lock<std::mutex> lock(sqLock);
+		// 失效时所有请求都已经结束并释放
+		if (broken)
+			return;
+		inflight--;
+		slotFree.notify_one();
+		if (request == nullptr)
+			return;
+
+		if (cqe.res < 0)
+		{
+			requests.erase(request);
+			lock.unlock();
+			auto errInfo = u8string(request->isWrite ? "Error occured when writing file :" : "Error occured when reading file :") + strerror(-cqe.res);
+			request->done(std::make_exception_ptr(Exception(errInfo.data())));
+			delete request;
+			return;
+		}
+		if (cqe.res == 0 && request->remaining != 0)
+		{
+			requests.erase(request);
+			lock.unlock();
+			request->done(std::make_exception_ptr(Exception(
+				request->isWrite ? u8"Error occured when writing stream : Write_Failed" : u8"Error occured when reading stream : End_Of_Stream")));
+			delete request;
+			return;
+		}
+
+		auto transferred = static_cast<size_t>(cqe.res);
+		request->data += transferred;
+		request->offset += transferred;
+		request->remaining -= transferred;
+		if (request->remaining != 0)
+		{
+			// 刚刚释放了一个位置，不需要等待
+			Prepare(request);
+			try
+			{
+				SubmitLocked();
+			}
+			catch (...)
+			{
+				Fail(lock, std::current_exception());
+			}
+			return;
+		}
+		requests.erase(request);
+		lock.unlock();
+		request->done(nullptr);
+		delete request;
+	}
+	void AsyncIOEngine::Impl::Reap()
+	{
+		while (true)
+		{
+			{
+				std::lock_guard<std::mutex> lock(sqLock);
+				if (broken || (stopping && inflight == 0))
+					return;
+			}
+			if (UringEnter(ringFd, 0, 1, IORING_ENTER_GETEVENTS) < 0 && errno != EINTR && errno != EAGAIN && errno != EBUSY)
+			{
+				auto errInfo = u8string("Error occured when waiting for io_uring completion :") + strerror(errno);
+				std::unique_lock<std::mutex> lock(sqLock);
+				Fail(lock, std::make_exception_ptr(Exception(errInfo.data())));
+				return;
+			}
+
+			auto head = *cqHead;
+			auto tail = __atomic_load_n(cqTail, __ATOMIC_ACQUIRE);
+			while (head != tail)
+			{
+				auto cqe = cqes[head & *cqMask];
+				head++;
+				__atomic_store_n(cqHead, head, __ATOMIC_RELEASE);
+				try
+				{
+					Complete(cqe);
+				}
+				catch (...)
+				{
+					// 异常不能离开收割线程，完成回调抛出的异常同样使引擎失效
+					std::unique_lock<std::mutex> lock(sqLock);
+					Fail(lock, std::current_exception());
+				}
+			}
+		}
+	}
+	void AsyncIOEngine::Impl::Fail(std::unique_lock<std::mutex>& lock, std::exception_ptr error)
+	{
+		// 调用者持有 sqLock ，返回时已经释放
+		if (!broken)
+			broken = error;
+		// 收回尚未提交给内核的请求，它们引用的上下文马上就要释放
+		__atomic_store_n(sqTail, *sqTail - pending, __ATOMIC_RELEASE);
+		pending = 0;
+		inflight = 0;
+		auto failed = std::move(requests);
+		requests.clear();
+		slotFree.notify_all();
+		lock.unlock();
+		for (auto request : failed)
+		{
+			request->done(broken);
+			delete request;
+		}
+	}
+#endif
+
+	void AsyncIOEngine::Impl::StartWorkers(unsigned count)
+	{
+		for (unsigned i = 0; i < count; i++)
+			workers.emplace_back([this]()
+				{
+					while (true)
+					{
+						std::function<void()> task;
+						{
+							std::unique_lock<std::mutex> lock(taskLock);
+							taskReady.wait(lock, [this]() { return stop || !tasks.empty(); });
+							if (tasks.empty())
+								return;
+							task = std::move(tasks.front());
+							tasks.pop();
+						}
+						task();
+					}
+				});
+	}
+	void AsyncIOEngine::Impl::StopWorkers()
+	{
+		{
+			std::lock_guard<std::mutex> lock(taskLock);
+			stop = true;
+		}
+		taskReady.notify_all();
+		for (auto& worker : workers)
+			worker.join();
+		workers.clear();
+	}
+	void AsyncIOEngine::Impl::Post(std::function<void()> task)
+	{
+		{
+			std::lock_guard<std::mutex> lock(taskLock);
+			tasks.push(std::move(task));
+		}
+		taskReady.notify_one();
+	}
+
+	AsyncIOEngine::Batch::Batch(AsyncIOEngine& engine) : engine(engine)
+	{
+		batchScopes.push_back(engine.impl);
+	}
+	AsyncIOEngine::Batch::~Batch()
+	{
+		batchScopes.erase(std::find(batchScopes.rbegin(), batchScopes.rend(), engine.impl).base() - 1);
+		if (!InBatch(engine.impl))
+		{
+			try
+			{
+				engine.Submit();
+			}
+			catch (...)
+			{
+				// 析构函数中无法报告错误，未能提交的请求会在下一次提交时一并提交
+			}
+		}
+	}
+
+	AsyncIOEngine::AsyncIOEngine(unsigned queueDepth, unsigned workerCount)
+	{
+		impl = new Impl();
+#ifdef UTILITIES_HAS_IO_URING
+		if (impl->SetupUring(queueDepth == 0 ? 1 : queueDepth))
+		{
+			impl->useUring = true;
+			impl->reaper = std::thread([this]() { impl->Reap(); });
+			return;
+		}
+		impl->TeardownUring();
+#endif
+		impl->StartWorkers(workerCount == 0 ? 1 : workerCount);
+	}
+	AsyncIOEngine::~AsyncIOEngine()
+	{
+#ifdef UTILITIES_HAS_IO_URING
+		if (impl->useUring)
+		{
+			{
+				// 提交一个空操作唤醒收割线程，等待所有请求完成后退出
+				std::unique_lock<std::mutex> lock(impl->sqLock);
+				impl->slotFree.wait(lock, [this]() { return impl->inflight < impl->capacity || impl->broken; });
+				impl->stopping = true;
+				impl->PrepareNop();
+				try
+				{
+					impl->SubmitLocked();
+				}
+				catch (...)
+				{
+					// 无法唤醒收割线程，只能放弃引擎占用的资源
+					lock.unlock();
+					impl->reaper.detach();
+					return;
+				}
+			}
+			impl->reaper.join();
+			impl->TeardownUring();
+		}
+#endif
+		impl->StopWorkers();
+		delete impl;
+	}
+	AsyncIOEngine& AsyncIOEngine::Default()
+	{
+		static AsyncIOEngine engine;
+		return engine;
+	}
+	void AsyncIOEngine::Impl::Start(FileStream& stream, bool isWrite, uint64_t offset, size_t len, uint8* data, Completion done)
+	{
+		if (!stream.IsVaild())
+			throw Exception("Stream Closed");
+		if (len == 0)
+		{
+			done(nullptr);
+			return;
+		}
+
+#ifdef UTILITIES_HAS_IO_URING
+		if (useUring)
+		{
+			auto fd = stream.GetDescriptor();
+			std::unique_lock<std::mutex> lock(sqLock);
+			if (broken)
+				std::rethrow_exception(broken);
+			// 批量提交作用域内准备好的请求在提交之前不会完成，队列已满时必须先提交，否则永远等不到空位
+			if (inflight >= capacity && pending != 0)
+			{
+				try
+				{
+					SubmitLocked();
+				}
+				catch (...)
+				{
+					auto error = std::current_exception();
+					Fail(lock, error);
+					std::rethrow_exception(error);
+				}
+			}
+			slotFree.wait(lock, [this]() { return inflight < capacity || broken; });
+			if (broken)
+				std::rethrow_exception(broken);
+			// 取得空位之后才创建请求，之前的提交失败时不会泄漏，也不会遗漏完成回调
+			auto request = new UringRequest{ std::move(done), fd, isWrite, data, len, offset };
+			requests.insert(request);
+			Prepare(request);
+			if (!InBatch(this))
+			{
+				// 请求已经交给引擎，提交失败时通过完成回调报告
+				try
+				{
+					SubmitLocked();
+				}
+				catch (...)
+				{
+					Fail(lock, std::current_exception());
+				}
+			}
+			return;
+		}
+#endif
+		Post([done = std::move(done), &stream, isWrite, offset, len, data]()
+			{
+				std::exception_ptr error;
+				try
+				{
+					if (isWrite)
+						stream.WriteAt(offset, len, data);
+					else
+						stream.ReadAt(offset, len, data);
+				}
+				catch (...)
+				{
+					error = std::current_exception();
+				}
+				done(error);
+			});
+	}
+
+	void AsyncIOEngine::Read(FileStream& stream, uint64_t offset, size_t len, void* data, Completion done)
+	{
+		if (stream.GetStreamType() == Stream::Type::WriteOnly)
+			throw Exception(u8"Error occured when reading stream : Cannot_Read_WriteOnly_Stream");
+		impl->Start(stream, false, offset, len, static_cast<uint8*>(data), std::move(done));
+	}
+	void AsyncIOEngine::Write(FileStream& stream, uint64_t offset, size_t len, const void* data, Completion done)
+	{
+		if (stream.GetStreamType() == Stream::Type::ReadOnly)
+			throw Exception(u8"Error occured when writing stream : Cannot_Write_ReadOnly_Stream");
+		impl->Start(stream, true, offset, len, static_cast<uint8*>(const_cast<void*>(data)), std::move(done));
+	}
+	std::future<void> AsyncIOEngine::Read(FileStream& stream, uint64_t offset, size_t len, void* data)
+	{
+		auto promise = std::make_shared<std::promise<void>>();
+		auto future = promise->get_future();
+		Read(stream, offset, len, data, [promise](std::exception_ptr error)
+			{
+				if (error)
+					promise->set_exception(error);
+				else
+					promise->set_value();
+			});
+		return future;
+	}
+	std::future<void> AsyncIOEngine::Write(FileStream& stream, uint64_t offset, size_t len, const void* data)
+	{
+		auto promise = std::make_shared<std::promise<void>>();
+		auto future = promise->get_future();
+		Write(stream, offset, len, data, [promise](std::exception_ptr error)
+			{
+				if (error)
+					promise->set_exception(error);
+				else
+					promise->set_value();
+			});
+		return future;
+	}
+	void AsyncIOEngine::Submit()
+	{
+#ifdef UTILITIES_HAS_IO_URING
+		if (impl->useUring)
+		{
+			std::unique_lock<std::mutex> lock(impl->sqLock);
+			if (impl->broken)
+				std::rethrow_exception(impl->broken);
+			try
+			{
+				impl->SubmitLocked();
+			}
+			catch (...)
+			{
+				auto error = std::current_exception();
+				impl->Fail(lock, error);
+				std::rethrow_exception(error);
+			}
+		}
+#endif
+	}
+	bool AsyncIOEngine::IsUsingUring() const
+	{
+		return impl->useUring;
+	}
+
+	std::future<void> FileStream::ReadAsync(uint64_t offset, size_t len, void* data)
+	{
+		return AsyncIOEngine::Default().Read(*this, offset, len, data);
+	}
+	std::future<void> FileStream::WriteAsync(uint64_t offset, size_t len, const void* data)
+	{
+		return AsyncIOEngine::Default().Write(*this, offset, len, data);
+	}
+}
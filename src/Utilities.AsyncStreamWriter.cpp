@@ -0,0 +1,213 @@
+/**
+ @file
+ @brief 通用IO库 异步写入流实现
+
+ @author 司马坑
+ @date 2026/10/17
+*/
+#include "Utilities.AsyncStreamWriter.h"
+#include "Utilities.FileStream.h"
+
+#include <cstring>
+
+namespace Utilities
+{
+	AsyncStreamWriter::AsyncStreamWriter(Stream& stream, size_t bufferSize, OverflowPolicy policy, SyncCallback sync)
+		: Stream(Type::WriteOnly), stream(stream), bufferSize(bufferSize), policy(policy), sync(std::move(sync))
+	{
+		if (bufferSize == 0)
+			throw Exception(u8"Error occured when creating stream : Invalid_Buffer_Size");
+		// POSIX 下 FileStream::Flush 什么也不做，数据只到达页缓存
+		if (!this->sync && dynamic_cast<FileStream*>(&stream) != nullptr)
+			this->sync = [](Stream& s) { static_cast<FileStream&>(s).Sync(); };
+		front = std::make_unique<uint8[]>(bufferSize);
+		back = std::make_unique<uint8[]>(bufferSize);
+		worker = std::thread([this]() { Run(); });
+	}
+	AsyncStreamWriter::~AsyncStreamWriter()
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		if (closed)
+			return;
+		try
+		{
+			Submit(lock);
+			WaitFlushed(lock);
+		}
+		catch (...)
+		{
+			// 析构函数中无法报告错误
+		}
+		Stop(lock);
+	}
+
+	void AsyncStreamWriter::Read(size_t, void*)
+	{
+		throw Exception(u8"Error occured when reading stream : Cannot_Read_WriteOnly_Stream");
+	}
+	void AsyncStreamWriter::Write(size_t len, const void* data)
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		if (closed)
+			throw Exception("Stream Closed");
+		ThrowIfFailed();
+		if (len <= bufferSize - frontLength)
+		{
+			memcpy(front.get() + frontLength, data, len);
+			frontLength += len;
+			return;
+		}
+
+		// 放不下时先交换缓冲区，不超过缓冲区大小的写入总是连续地放在同一个缓冲区中；
+		// Drop 策略下后台缓冲区仍在写入时整个丢弃，不会只写入一半
+		if (len <= bufferSize && (policy == OverflowPolicy::Block || !backBusy))
+		{
+			Submit(lock);
+			memcpy(front.get(), data, len);
+			frontLength = len;
+			return;
+		}
+		if (policy == OverflowPolicy::Drop)
+		{
+			droppedBytes += len;
+			return;
+		}
+
+		// 超过缓冲区大小的写入分块提交，多个线程同时写入时可能与其他线程的数据交错
+		auto src = static_cast<const uint8*>(data);
+		while (len != 0)
+		{
+			if (frontLength == bufferSize)
+				Submit(lock);
+			auto n = bufferSize - frontLength < len ? bufferSize - frontLength : len;
+			memcpy(front.get() + frontLength, src, n);
+			frontLength += n;
+			src += n;
+			len -= n;
+		}
+	}
+	void AsyncStreamWriter::Close()
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		if (closed)
+			return;
+		std::exception_ptr failure;
+		try
+		{
+			Submit(lock);
+			WaitFlushed(lock);
+		}
+		catch (...)
+		{
+			failure = std::current_exception();
+		}
+		Stop(lock);
+		if (failure)
+			std::rethrow_exception(failure);
+		stream.Close();
+	}
+	bool AsyncStreamWriter::IsVaild()
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		return !closed && !error && stream.IsVaild();
+	}
+	void AsyncStreamWriter::Flush()
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		if (closed)
+			throw Exception("Stream Closed");
+		Submit(lock);
+		WaitFlushed(lock);
+	}
+
+	uint64_t AsyncStreamWriter::GetDroppedBytes()
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		return droppedBytes;
+	}
+	uint64_t AsyncStreamWriter::GetStallCount()
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		return stallCount;
+	}
+
+	void AsyncStreamWriter::Run()
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		while (true)
+		{
+			work.wait(lock, [this]() { return backBusy || flushRequested != flushCompleted || stopping; });
+			// 先写完已提交的数据，再处理 Flush 请求，最后才退出
+			bool writing = backBusy;
+			if (!writing && flushRequested == flushCompleted)
+				return;
+			auto ticket = flushRequested;
+			std::exception_ptr failure;
+			lock.unlock();
+			try
+			{
+				if (writing)
+					stream.Write(backLength, back.get());
+				else
+				{
+					stream.Flush();
+					if (sync)
+						sync(stream);
+				}
+			}
+			catch (...)
+			{
+				failure = std::current_exception();
+			}
+			lock.lock();
+			if (failure && !error)
+				error = failure;
+			if (writing)
+				backBusy = false;
+			else
+				flushCompleted = ticket;
+			done.notify_all();
+		}
+	}
+
+	void AsyncStreamWriter::Submit(std::unique_lock<std::mutex>& lock)
+	{
+		if (frontLength == 0)
+			return;
+		if (backBusy)
+		{
+			stallCount++;
+			done.wait(lock, [this]() { return !backBusy; });
+		}
+		ThrowIfFailed();
+		// 等待期间其他线程可能已经提交了前台缓冲区
+		if (frontLength == 0)
+			return;
+		std::swap(front, back);
+		backLength = frontLength;
+		frontLength = 0;
+		backBusy = true;
+		work.notify_one();
+	}
+	void AsyncStreamWriter::WaitFlushed(std::unique_lock<std::mutex>& lock)
+	{
+		auto ticket = ++flushRequested;
+		work.notify_one();
+		done.wait(lock, [this, ticket]() { return flushCompleted >= ticket; });
+		ThrowIfFailed();
+	}
+	void AsyncStreamWriter::Stop(std::unique_lock<std::mutex>& lock)
+	{
+		closed = true;
+		stopping = true;
+		work.notify_one();
+		lock.unlock();
+		worker.join();
+		lock.lock();
+	}
+	void AsyncStreamWriter::ThrowIfFailed()
+	{
+		if (error)
+			std::rethrow_exception(error);
+	}
+}
@@ -0,0 +1,204 @@
+/**
+ @file
+ @brief 通用IO库 块缓存实现
+
+ @author 司马坑
+ @date 2026/10/17
+*/
+#include "Utilities.BlockCache.h"
+
+#include <cstring>
+#include <iterator>
+
+namespace Utilities
+{
+	BlockCache::BlockCache(size_t capacity, size_t blockSize, size_t shardCount)
+		: blockSize(blockSize)
+	{
+		if (blockSize == 0 || shardCount == 0)
+			throw Exception(u8"Error occured when creating block cache : Invalid_Argument");
+		shardCapacity = capacity / blockSize / shardCount;
+		if (shardCapacity == 0)
+			shardCapacity = 1;
+		shards.reserve(shardCount);
+		for (size_t i = 0; i < shardCount; i++)
+			shards.push_back(std::make_unique<Shard>());
+	}
+	BlockCache::~BlockCache()
+	{
+
+	}
+
+	size_t BlockCache::KeyHash::operator()(const Key& key) const
+	{
+		auto h = (key.index + key.source * 0x9E3779B97F4A7C15ull) * 0xFF51AFD7ED558CCDull;
+		return static_cast<size_t>(h ^ (h >> 32));
+	}
+	BlockCache::Shard& BlockCache::GetShard(const Key& key)
+	{
+		// 分片使用散列值的高位，散列表使用低位，两者互不相关
+		auto h = (key.index + key.source * 0x9E3779B97F4A7C15ull) * 0xFF51AFD7ED558CCDull;
+		return *shards[(h >> 40) % shards.size()];
+	}
+
+	BlockCache::Statistics BlockCache::GetStatistics() const
+	{
+		Statistics statistics;
+		statistics.hits = hits.load(std::memory_order_relaxed);
+		statistics.misses = misses.load(std::memory_order_relaxed);
+		statistics.evictions = evictions.load(std::memory_order_relaxed);
+		return statistics;
+	}
+
+	void BlockCache::Clear()
+	{
+		for (auto& shard : shards)
+		{
+			std::lock_guard<std::mutex> lock(shard->mutex);
+			shard->map.clear();
+			shard->slots.clear();
+			shard->free.clear();
+			shard->hand = 0;
+			shard->generation++;
+		}
+	}
+
+	BlockCache::Source& BlockCache::AcquireSource(Stream& stream, uint64_t length)
+	{
+		std::lock_guard<std::mutex> lock(sourceMutex);
+		auto result = sources.try_emplace(&stream);
+		auto& source = result.first->second;
+		if (result.second)
+		{
+			source.id = nextSource++;
+			source.length = length;
+		}
+		source.references++;
+		return source;
+	}
+	void BlockCache::ReleaseSource(Stream& stream)
+	{
+		uint64_t id;
+		{
+			std::lock_guard<std::mutex> lock(sourceMutex);
+			auto it = sources.find(&stream);
+			if (it == sources.end() || --it->second.references != 0)
+				return;
+			id = it->second.id;
+			sources.erase(it);
+		}
+		Invalidate(id);
+	}
+
+	void BlockCache::Read(uint64_t source, uint64_t index, Stream& stream, size_t blockLength, size_t offset, size_t len, void* dst)
+	{
+		Key key{ source, index };
+		auto& shard = GetShard(key);
+		uint64_t generation;
+		{
+			std::lock_guard<std::mutex> lock(shard.mutex);
+			auto it = shard.map.find(key);
+			if (it != shard.map.end())
+			{
+				auto& slot = shard.slots[it->second];
+				if (slot.size == blockLength)
+				{
+					memcpy(dst, slot.data.get() + offset, len);
+					slot.referenced = true;
+					hits.fetch_add(1, std::memory_order_relaxed);
+					return;
+				}
+			}
+			generation = shard.generation;
+		}
+
+		misses.fetch_add(1, std::memory_order_relaxed);
+		auto data = std::make_unique<uint8_t[]>(blockSize);
+		stream.ReadAt(index * blockSize, blockLength, data.get());
+		memcpy(dst, data.get() + offset, len);
+
+		std::lock_guard<std::mutex> lock(shard.mutex);
+		// 读取期间数据被改写过，读到的块可能已经过时，不放入缓存
+		if (generation != shard.generation)
+			return;
+		auto it = shard.map.find(key);
+		if (it != shard.map.end())
+		{
+			// 其他线程已经放入了同一块，或者缓存中是长度不同的旧块
+			auto& slot = shard.slots[it->second];
+			slot.data = std::move(data);
+			slot.size = blockLength;
+			slot.referenced = true;
+			return;
+		}
+
+		size_t target;
+		if (!shard.free.empty())
+		{
+			target = shard.free.back();
+			shard.free.pop_back();
+		}
+		else if (shard.slots.size() < shardCapacity)
+		{
+			target = shard.slots.size();
+			shard.slots.emplace_back();
+		}
+		else
+		{
+			// CLOCK：跳过最近被访问过的块并清除其标记，淘汰第一个未被访问过的块
+			while (shard.slots[shard.hand].referenced)
+			{
+				shard.slots[shard.hand].referenced = false;
+				shard.hand = (shard.hand + 1) % shard.slots.size();
+			}
+			target = shard.hand;
+			shard.hand = (shard.hand + 1) % shard.slots.size();
+			shard.map.erase(shard.slots[target].key);
+			evictions.fetch_add(1, std::memory_order_relaxed);
+		}
+		auto& slot = shard.slots[target];
+		slot.key = key;
+		slot.data = std::move(data);
+		slot.size = blockLength;
+		slot.referenced = false;
+		shard.map.emplace(key, target);
+	}
+
+	void BlockCache::Invalidate(uint64_t source, uint64_t first, uint64_t last)
+	{
+		for (auto index = first; index <= last; index++)
+		{
+			Key key{ source, index };
+			auto& shard = GetShard(key);
+			std::lock_guard<std::mutex> lock(shard.mutex);
+			shard.generation++;
+			auto it = shard.map.find(key);
+			if (it != shard.map.end())
+				Discard(shard, it);
+		}
+	}
+	void BlockCache::Invalidate(uint64_t source)
+	{
+		for (auto& shard : shards)
+		{
+			std::lock_guard<std::mutex> lock(shard->mutex);
+			shard->generation++;
+			for (auto it = shard->map.begin(); it != shard->map.end();)
+			{
+				auto next = std::next(it);
+				if (it->first.source == source)
+					Discard(*shard, it);
+				it = next;
+			}
+		}
+	}
+	void BlockCache::Discard(Shard& shard, std::unordered_map<Key, size_t, KeyHash>::iterator it)
+	{
+		auto& slot = shard.slots[it->second];
+		slot.data.reset();
+		slot.size = 0;
+		slot.referenced = false;
+		shard.free.push_back(it->second);
+		shard.map.erase(it);
+	}
+}
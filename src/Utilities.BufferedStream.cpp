@@ -0,0 +1,175 @@
+/**
+ @file
+ @brief 通用IO库 缓冲流实现
+
+ 缓冲区在任意时刻只处于一种状态：
+	- 预读状态：readLength > 0，writeLength == 0，被包装流的读写指针位于缓冲区数据的末尾
+	- 写入状态：writeLength > 0，readLength == 0，被包装流的读写指针位于缓冲区数据的开头
+	- 空闲状态：两者均为 0
+
+ @author 司马坑
+ @date 2026/10/17
+*/
+#include "Utilities.BufferedStream.h"
+
+namespace Utilities
+{
+	BufferedStream::BufferedStream(Stream& stream, size_t bufferSize) : Stream(stream.GetStreamType()), stream(stream)
+	{
+		if (bufferSize == 0)
+			throw Exception(u8"Error occured when creating stream : Buffer_Size_Is_Zero");
+		this->buffer = new uint8[bufferSize];
+		this->bufferSize = bufferSize;
+	}
+	BufferedStream::~BufferedStream()
+	{
+		try
+		{
+			FlushWrite();
+		}
+		catch (...)
+		{
+			// 析构函数中无法报告错误
+		}
+		delete[] buffer;
+	}
+	void BufferedStream::ReadSlow(size_t len, void* data)
+	{
+		if (writeLength != 0)
+			FlushWrite();
+
+		auto dst = static_cast<uint8*>(data);
+		auto available = readLength - readPosition;
+		if (available != 0)
+		{
+			memcpy(dst, buffer + readPosition, available);
+			dst += available;
+			len -= available;
+		}
+		readLength = 0;
+		readPosition = 0;
+
+		// 大块读取直接交给被包装的流，避免一次多余的复制
+		if (len >= bufferSize)
+		{
+			stream.Read(len, dst);
+			return;
+		}
+
+		while (len != 0)
+		{
+			auto readLen = stream.ReadSome(bufferSize, buffer);
+			if (readLen == 0)
+				throw Exception(u8"Error occured when reading stream : End_Of_Stream");
+			auto copyLen = readLen < len ? readLen : len;
+			memcpy(dst, buffer, copyLen);
+			dst += copyLen;
+			len -= copyLen;
+			readLength = readLen;
+			readPosition = copyLen;
+		}
+	}
+	void BufferedStream::WriteSlow(size_t len, const void* data)
+	{
+		if (readLength != 0)
+			DiscardRead();
+		if (writeLength + len > bufferSize)
+			FlushWrite();
+
+		// 大块写入直接交给被包装的流
+		if (len >= bufferSize)
+		{
+			stream.Write(len, data);
+			return;
+		}
+		memcpy(buffer + writeLength, data, len);
+		writeLength += len;
+	}
+	void BufferedStream::FlushWrite()
+	{
+		if (writeLength == 0)
+			return;
+		// 先清零，写入失败时不会在析构函数中重复提交
+		auto len = writeLength;
+		writeLength = 0;
+		stream.Write(len, buffer);
+	}
+	void BufferedStream::DiscardRead()
+	{
+		auto unread = readLength - readPosition;
+		// 把被包装流的读写指针退回到逻辑位置，成功后才丢弃，不支持定位的流抛出异常时预读的数据仍然可以读取
+		if (unread != 0)
+			stream.Seek(-static_cast<int64_t>(unread));
+		readLength = 0;
+		readPosition = 0;
+	}
+	void BufferedStream::Close()
+	{
+		FlushWrite();
+		readLength = 0;
+		readPosition = 0;
+		stream.Close();
+	}
+	bool BufferedStream::IsVaild()
+	{
+		return stream.IsVaild();
+	}
+	size_t BufferedStream::ReadSome(size_t maxLen, void* data)
+	{
+		auto available = readLength - readPosition;
+		if (available == 0)
+		{
+			if (writeLength != 0)
+				FlushWrite();
+			readLength = 0;
+			readPosition = 0;
+			if (maxLen >= bufferSize)
+				return stream.ReadSome(maxLen, data);
+			readLength = stream.ReadSome(bufferSize, buffer);
+			available = readLength;
+		}
+
+		auto len = available < maxLen ? available : maxLen;
+		memcpy(data, buffer + readPosition, len);
+		readPosition += len;
+		return len;
+	}
+	void BufferedStream::Flush()
+	{
+		FlushWrite();
+		stream.Flush();
+	}
+	uint64_t BufferedStream::GetLength()
+	{
+		FlushWrite();
+		return stream.GetLength();
+	}
+	uint64_t BufferedStream::GetPosition()
+	{
+		return stream.GetPosition() - (readLength - readPosition) + writeLength;
+	}
+	void BufferedStream::SetPosition(uint64_t pos)
+	{
+		if (readLength != 0)
+		{
+			auto end = stream.GetPosition();
+			auto begin = end - readLength;
+			if (pos >= begin && pos <= end)
+			{
+				readPosition = static_cast<size_t>(pos - begin);
+				return;
+			}
+		}
+		FlushWrite();
+		readLength = 0;
+		readPosition = 0;
+		stream.SetPosition(pos);
+	}
+	void BufferedStream::Seek(int64_t offset)
+	{
+		auto pos = GetPosition();
+		if (offset < 0 && static_cast<uint64_t>(-offset) > pos)
+			throw Exception(u8"Error occured when seeking stream : Position_Out_Of_Range");
+		SetPosition(pos + offset);
+	}
+}
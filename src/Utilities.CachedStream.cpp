@@ -0,0 +1,131 @@
+/**
+ @file
+ @brief 通用IO库 缓存流实现
+
+ @author 司马坑
+ @date 2026/10/17
+*/
+#include "Utilities.CachedStream.h"
+
+namespace Utilities
+{
+	CachedStream::CachedStream(Stream& stream, BlockCache& cache)
+		: Stream(stream.GetStreamType()), stream(stream), cache(cache), source(cache.AcquireSource(stream, stream.GetLength()))
+	{
+
+	}
+	CachedStream::~CachedStream()
+	{
+		Close();
+	}
+
+	void CachedStream::Read(size_t len, void* data)
+	{
+		ReadAt(position, len, data);
+		position += len;
+	}
+	void CachedStream::Write(size_t len, const void* data)
+	{
+		WriteAt(position, len, data);
+		position += len;
+	}
+	size_t CachedStream::ReadSome(size_t maxLen, void* data)
+	{
+		if (closed)
+			throw Exception("Stream Closed");
+		uint64_t length = source.length;
+		if (position >= length)
+			return 0;
+		auto len = length - position < maxLen ? static_cast<size_t>(length - position) : maxLen;
+		Read(len, data);
+		return len;
+	}
+	void CachedStream::ReadAt(uint64_t pos, size_t len, void* data)
+	{
+		if (GetStreamType() == Type::WriteOnly)
+			throw Exception(u8"Error occured when reading stream : Cannot_Read_WriteOnly_Stream");
+		if (closed)
+			throw Exception("Stream Closed");
+		uint64_t length = source.length;
+		if (pos > length || len > length - pos)
+			throw Exception(u8"Error occured when reading stream : End_Of_Stream");
+
+		auto blockSize = cache.GetBlockSize();
+		auto dst = static_cast<uint8_t*>(data);
+		while (len != 0)
+		{
+			auto index = pos / blockSize;
+			auto offset = static_cast<size_t>(pos % blockSize);
+			auto remain = length - index * blockSize;
+			auto blockLength = remain < blockSize ? static_cast<size_t>(remain) : blockSize;
+			auto n = blockSize - offset < len ? blockSize - offset : len;
+			cache.Read(source.id, index, stream, blockLength, offset, n, dst);
+			pos += n;
+			dst += n;
+			len -= n;
+		}
+	}
+	void CachedStream::WriteAt(uint64_t pos, size_t len, const void* data)
+	{
+		if (GetStreamType() == Type::ReadOnly)
+			throw Exception(u8"Error occured when writing stream : Cannot_Write_ReadOnly_Stream");
+		if (closed)
+			throw Exception("Stream Closed");
+		if (len == 0)
+			return;
+		stream.WriteAt(pos, len, data);
+		auto blockSize = cache.GetBlockSize();
+		uint64_t length = source.length;
+		// 写入超出末尾时原来的最后一块也不再完整，中间的块此前不存在，不需要处理
+		if (pos > length)
+			cache.Invalidate(source.id, length / blockSize, length / blockSize);
+		cache.Invalidate(source.id, pos / blockSize, (pos + len - 1) / blockSize);
+		// 其他缓存流可能同时增长长度，只在更长时更新
+		while (pos + len > length && !source.length.compare_exchange_weak(length, pos + len))
+			;
+	}
+	void CachedStream::Close()
+	{
+		if (closed)
+			return;
+		closed = true;
+		cache.ReleaseSource(stream);
+	}
+	bool CachedStream::IsVaild()
+	{
+		return !closed && stream.IsVaild();
+	}
+	void CachedStream::Flush()
+	{
+		if (closed)
+			throw Exception("Stream Closed");
+		stream.Flush();
+	}
+
+	uint64_t CachedStream::GetLength()
+	{
+		if (closed)
+			throw Exception("Stream Closed");
+		return source.length;
+	}
+	uint64_t CachedStream::GetPosition()
+	{
+		if (closed)
+			throw Exception("Stream Closed");
+		return position;
+	}
+	void CachedStream::SetPosition(uint64_t pos)
+	{
+		if (closed)
+			throw Exception("Stream Closed");
+		if (pos > source.length)
+			throw Exception(u8"Error occured when seeking stream : Position_Out_Of_Range");
+		position = pos;
+	}
+	void CachedStream::Seek(int64_t offset)
+	{
+		if (offset < 0 && static_cast<uint64_t>(-offset) > position)
+			throw Exception(u8"Error occured when seeking stream : Position_Out_Of_Range");
+		SetPosition(position + offset);
+	}
+}
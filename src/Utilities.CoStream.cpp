@@ -0,0 +1,196 @@
+/**
+ @file
+ @brief 通用IO流 可等待的 CoStreamReader 与 CoStreamWriter 实现
+
+ @author 司马坑
+ @date 2026/10/17
+*/
+#include "Utilities.CoStream.h"
+
+#ifdef UTILITIES_HAS_COROUTINE
+#include <cstring>
+#include <algorithm>
+
+namespace Utilities
+{
+	CoStreamReader::CoStreamReader(FileStream& stream, Coroutine::Executor& executor, size_t bufferSize, AsyncIOEngine& engine)
+		: stream(stream), executor(executor), engine(engine), buffer(bufferSize == 0 ? 1 : bufferSize)
+	{
+		if (stream.GetStreamType() == Stream::Type::WriteOnly)
+			throw Exception(u8"Error occured when reading stream : Cannot_Read_WriteOnly_Stream");
+		filePosition = stream.GetPosition();
+		fileLength = stream.GetLength();
+	}
+
+	CoStreamWriter::CoStreamWriter(FileStream& stream, Coroutine::Executor& executor, size_t bufferSize, AsyncIOEngine& engine)
+		: stream(stream), executor(executor), engine(engine), buffer(bufferSize == 0 ? 1 : bufferSize)
+	{
+		if (stream.GetStreamType() == Stream::Type::ReadOnly)
+			throw Exception(u8"Error occured when writing stream : Cannot_Write_ReadOnly_Stream");
+		filePosition = stream.GetPosition();
+	}
+	CoStreamWriter::~CoStreamWriter()
+	{
+		try
+		{
+			if (bufferEnd != 0)
+				stream.WriteAt(filePosition, bufferEnd, buffer.data());
+		}
+		catch (...)
+		{
+			// 析构函数中无法报告错误
+		}
+	}
+
+	namespace _private
+	{
+		bool CoTransfer::await_ready()
+		{
+			// 只处理不需要IO的情况，发起IO必须等到协程句柄可用之后
+			if (reader)
+			{
+				auto& r = *reader;
+				if (r.bufferEnd - r.bufferBegin < remaining)
+					return false;
+				memcpy(data, r.buffer.data() + r.bufferBegin, remaining);
+				r.bufferBegin += remaining;
+			}
+			else
+			{
+				auto& w = *writer;
+				if (flush || w.buffer.size() - w.bufferEnd < remaining)
+					return false;
+				memcpy(w.buffer.data() + w.bufferEnd, data, remaining);
+				w.bufferEnd += remaining;
+			}
+			remaining = 0;
+			return true;
+		}
+		bool CoTransfer::await_suspend(std::coroutine_handle<> handle)
+		{
+			this->handle = handle;
+			try
+			{
+				// 返回 false 表示已经同步完成，协程不挂起
+				return !Step();
+			}
+			catch (...)
+			{
+				error = std::current_exception();
+				return false;
+			}
+		}
+		void CoTransfer::await_resume()
+		{
+			if (error)
+				std::rethrow_exception(error);
+		}
+		bool CoTransfer::Step()
+		{
+			return reader ? StepRead() : StepWrite();
+		}
+		bool CoTransfer::StepRead()
+		{
+			auto& r = *reader;
+			auto n = std::min(r.bufferEnd - r.bufferBegin, remaining);
+			memcpy(data, r.buffer.data() + r.bufferBegin, n);
+			r.bufferBegin += n;
+			data += n;
+			remaining -= n;
+			if (remaining == 0)
+				return true;
+
+			r.bufferBegin = r.bufferEnd = 0;
+			if (r.fileLength - r.filePosition < remaining)
+				throw Exception(u8"Error occured when reading stream : End_Of_Stream");
+
+			auto position = r.filePosition;
+			if (remaining >= r.buffer.size())
+			{
+				// 大块数据直接读入目标缓冲区
+				auto len = remaining;
+				r.filePosition += len;
+				remaining = 0;
+				r.engine.Read(r.stream, position, len, data, [this](std::exception_ptr e) { Resume(e); });
+				return false;
+			}
+
+			auto len = static_cast<size_t>(std::min<uint64_t>(r.buffer.size(), r.fileLength - r.filePosition));
+			r.filePosition += len;
+			r.engine.Read(r.stream, position, len, r.buffer.data(), [this, len](std::exception_ptr e)
+				{
+					if (e)
+						return Resume(e);
+					reader->bufferEnd = len;
+					Continue();
+				});
+			return false;
+		}
+		bool CoTransfer::StepWrite()
+		{
+			auto& w = *writer;
+			auto free = w.buffer.size() - w.bufferEnd;
+			if (!flush && remaining <= free)
+			{
+				memcpy(w.buffer.data() + w.bufferEnd, data, remaining);
+				w.bufferEnd += remaining;
+				remaining = 0;
+				return true;
+			}
+			if (flush && w.bufferEnd == 0)
+				return true;
+
+			if (!flush && w.bufferEnd == 0 && remaining >= w.buffer.size())
+			{
+				// 大块数据直接写出，不经过缓冲区
+				auto position = w.filePosition;
+				auto len = remaining;
+				w.filePosition += len;
+				remaining = 0;
+				w.engine.Write(w.stream, position, len, data, [this](std::exception_ptr e) { Resume(e); });
+				return false;
+			}
+
+			auto n = std::min(free, remaining);
+			memcpy(w.buffer.data() + w.bufferEnd, data, n);
+			w.bufferEnd += n;
+			data += n;
+			remaining -= n;
+
+			auto len = w.bufferEnd;
+			w.engine.Write(w.stream, w.filePosition, len, w.buffer.data(), [this, len](std::exception_ptr e)
+				{
+					if (e)
+						return Resume(e);
+					writer->filePosition += len;
+					writer->bufferEnd = 0;
+					Continue();
+				});
+			return false;
+		}
+		void CoTransfer::Continue()
+		{
+			// 完成回调在 IO 引擎的线程上执行，在那里发起下一个请求可能因队列已满而阻塞该线程，
+			// 它负责的完成事件也就无法处理，因此交给调度器的线程继续
+			(reader ? reader->executor : writer->executor).Post([this]()
+				{
+					try
+					{
+						if (!Step())
+							return;
+					}
+					catch (...)
+					{
+						error = std::current_exception();
+					}
+					handle.resume();
+				});
+		}
+		void CoTransfer::Resume(std::exception_ptr error)
+		{
+			this->error = error;
+			(reader ? reader->executor : writer->executor).Post(handle);
+		}
+	}
+}
+#endif
@@ -0,0 +1,127 @@
+/**
+ @file
+ @brief 通用模板库 批量字节序转换的实现
+
+ 在 x86 上运行时检测 CPU 支持的指令集：
+	- AVX2  每次重排 32 字节
+	- SSSE3 每次重排 16 字节
+	- 其他  逐个元素转换
+ 剩余不足一个向量的尾部逐个元素处理
+
+ @author 司马坑
+ @date 2026/10/17
+*/
+#include "Utilities.Common.Endian.h"
+#include "Utilities.Simd.h"
+
+namespace Utilities::Common
+{
+	namespace
+	{
+		template<typename Bits>
+		void SwapScalar(uint8_t* dst, const uint8_t* src, size_t count)
+		{
+			for (size_t i = 0; i < count; i++)
+			{
+				Bits v;
+				memcpy(&v, src + i * sizeof(Bits), sizeof(Bits));
+				v = ByteSwap(v);
+				memcpy(dst + i * sizeof(Bits), &v, sizeof(Bits));
+			}
+		}
+		void SwapScalar(uint8_t* dst, const uint8_t* src, size_t count, size_t elementSize)
+		{
+			switch (elementSize)
+			{
+			case 2: SwapScalar<uint16_t>(dst, src, count); return;
+			case 4: SwapScalar<uint32_t>(dst, src, count); return;
+			case 8: SwapScalar<uint64_t>(dst, src, count); return;
+			}
+			for (size_t i = 0; i < count; i++, dst += elementSize, src += elementSize)
+			{
+				for (size_t l = 0, r = elementSize - 1; l <= r; l++, r--)
+				{
+					auto t = src[l];
+					dst[l] = src[r];
+					dst[r] = t;
+				}
+			}
+		}
+
+#ifdef UTILITIES_SIMD_X86
+		//! 每种元素长度在一个 128 位通道内的字节重排表
+		alignas(16) constexpr uint8_t ShuffleTable[3][16] =
+		{
+			{ 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14 },
+			{ 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12 },
+			{ 7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8 },
+		};
+		const uint8_t* GetShuffle(size_t elementSize)
+		{
+			return ShuffleTable[elementSize == 2 ? 0 : elementSize == 4 ? 1 : 2];
+		}
+
+		UTILITIES_TARGET("ssse3")
+		size_t SwapSSSE3(uint8_t* dst, const uint8_t* src, size_t bytes, size_t elementSize)
+		{
+			auto mask = _mm_load_si128(reinterpret_cast<const __m128i*>(GetShuffle(elementSize)));
+			size_t i = 0;
+			for (; i + 16 <= bytes; i += 16)
+			{
+				auto v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_shuffle_epi8(v, mask));
+			}
+			return i;
+		}
+
+		UTILITIES_TARGET("avx2")
+		size_t SwapAVX2(uint8_t* dst, const uint8_t* src, size_t bytes, size_t elementSize)
+		{
+			// 元素不会跨越 128 位通道，两个通道使用相同的重排表
+			auto mask = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(GetShuffle(elementSize))));
+			size_t i = 0;
+			for (; i + 64 <= bytes; i += 64)
+			{
+				auto v0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+				auto v1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i + 32));
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_shuffle_epi8(v0, mask));
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i + 32), _mm256_shuffle_epi8(v1, mask));
+			}
+			for (; i + 32 <= bytes; i += 32)
+			{
+				auto v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_shuffle_epi8(v, mask));
+			}
+			return i;
+		}
+#endif
+	}
+
+	void ByteSwapBuffer(void* dst, const void* src, size_t count, size_t elementSize)
+	{
+		auto d = static_cast<uint8_t*>(dst);
+		auto s = static_cast<const uint8_t*>(src);
+		if (elementSize <= 1)
+		{
+			if (d != s && count != 0)
+				memcpy(d, s, count * elementSize);
+			return;
+		}
+#ifdef UTILITIES_SIMD_X86
+		if (elementSize == 2 || elementSize == 4 || elementSize == 8)
+		{
+			auto bytes = count * elementSize;
+			size_t done = 0;
+			auto level = Utilities::_private::GetSimdLevel();
+			if (level == Utilities::_private::SimdLevel::AVX2)
+				done = SwapAVX2(d, s, bytes, elementSize);
+			if (level != Utilities::_private::SimdLevel::None)
+				done += SwapSSSE3(d + done, s + done, bytes - done, elementSize);
+			d += done;
+			s += done;
+			count -= done / elementSize;
+		}
+#endif
+		SwapScalar(d, s, count, elementSize);
+	}
+}
@@ -0,0 +1,207 @@
+/**
+ @file
+ @brief 通用模板库 文本格式化的实现
+
+ @author 司马坑
+ @date 2026/10/17
+*/
+#include "Utilities.Common.Format.h"
+
+#include <cstring>
+
+namespace Utilities::Common
+{
+	char* FormatFloat(char* out, double value)
+	{
+		return std::to_chars(out, out + MaxNumberChars, value).ptr;
+	}
+	char* FormatFloat(char* out, float value)
+	{
+		return std::to_chars(out, out + MaxNumberChars, value).ptr;
+	}
+	char* FormatFloat(char* out, double value, int precision)
+	{
+		auto result = std::to_chars(out, out + MaxNumberChars, value, std::chars_format::fixed, precision);
+		if (result.ec != std::errc())
+			result = std::to_chars(out, out + MaxNumberChars, value, std::chars_format::scientific, precision);
+		if (result.ec != std::errc())
+			result = std::to_chars(out, out + MaxNumberChars, value);
+		return result.ptr;
+	}
+
+	namespace
+	{
+		/// <summary>
+		/// 栈上的输出缓冲区，满了才交给回调
+		/// </summary>
+		class FormatBuffer
+		{
+		public:
+			FormatBuffer(FormatOutput output, void* context) : output(output), context(context) { }
+			void Append(const char* data, size_t len)
+			{
+				if (size + len > sizeof(buffer))
+				{
+					Flush();
+					// 长字符串直接交给回调，不再复制
+					if (len > sizeof(buffer))
+					{
+						output(context, data, len);
+						return;
+					}
+				}
+				memcpy(buffer + size, data, len);
+				size += len;
+			}
+			/// <summary>
+			/// 预留至少 MaxNumberChars 字节用于直接格式化数值
+			/// </summary>
+			char* Reserve()
+			{
+				if (size + MaxNumberChars > sizeof(buffer))
+					Flush();
+				return buffer + size;
+			}
+			void Commit(char* end)
+			{
+				size = end - buffer;
+			}
+			void Flush()
+			{
+				if (size != 0)
+					output(context, buffer, size);
+				size = 0;
+			}
+		private:
+			char buffer[512];
+			size_t size = 0;
+			FormatOutput output;
+			void* context;
+		};
+
+		void FormatOne(FormatBuffer& out, const FormatArg& arg, std::string_view spec)
+		{
+			using Kind = FormatArg::Kind;
+			auto invalid = []()
+			{
+				throw Exception(u8"Error occured when formatting text : Invalid_Format_Spec");
+			};
+
+			if (spec == "x" || spec == "X")
+			{
+				if (arg.kind != Kind::Int && arg.kind != Kind::UInt)
+					invalid();
+				auto value = arg.kind == Kind::Int ? static_cast<uint64_t>(arg.i) : arg.u;
+				auto p = out.Reserve();
+				out.Commit(FormatHex(p, value, 0, spec == "X"));
+				return;
+			}
+			if (!spec.empty() && spec[0] == '.')
+			{
+				int precision = 0;
+				auto r = std::from_chars(spec.data() + 1, spec.data() + spec.size(), precision);
+				if (r.ec != std::errc() || r.ptr != spec.data() + spec.size() || precision > 17)
+					invalid();
+				double value;
+				switch (arg.kind)
+				{
+				case Kind::Float: value = arg.f; break;
+				case Kind::Double: value = arg.d; break;
+				case Kind::Int: value = static_cast<double>(arg.i); break;
+				case Kind::UInt: value = static_cast<double>(arg.u); break;
+				default: invalid(); return;
+				}
+				auto p = out.Reserve();
+				out.Commit(FormatFloat(p, value, precision));
+				return;
+			}
+			if (!spec.empty())
+				invalid();
+
+			switch (arg.kind)
+			{
+			case Kind::Bool:
+				if (arg.b)
+					out.Append("true", 4);
+				else
+					out.Append("false", 5);
+				break;
+			case Kind::Char:
+				out.Append(&arg.c, 1);
+				break;
+			case Kind::String:
+				out.Append(arg.s.data, arg.s.size);
+				break;
+			case Kind::Int:
+			{
+				auto p = out.Reserve();
+				out.Commit(FormatInt(p, arg.i));
+				break;
+			}
+			case Kind::UInt:
+			{
+				auto p = out.Reserve();
+				out.Commit(FormatInt(p, arg.u));
+				break;
+			}
+			case Kind::Float:
+			{
+				auto p = out.Reserve();
+				out.Commit(FormatFloat(p, arg.f));
+				break;
+			}
+			case Kind::Double:
+			{
+				auto p = out.Reserve();
+				out.Commit(FormatFloat(p, arg.d));
+				break;
+			}
+			default:
+				break;
+			}
+		}
+	}
+
+	void FormatTo(std::string_view format, const FormatArg* args, size_t count, FormatOutput output, void* context)
+	{
+		FormatBuffer out(output, context);
+		size_t next = 0;
+		size_t i = 0;
+		while (i < format.size())
+		{
+			// 找到下一个花括号，之前的文本原样输出
+			auto brace = format.find_first_of("{}", i);
+			if (brace == std::string_view::npos)
+				brace = format.size();
+			out.Append(format.data() + i, brace - i);
+			i = brace;
+			if (i == format.size())
+				break;
+
+			if (i + 1 < format.size() && format[i + 1] == format[i])
+			{
+				out.Append(format.data() + i, 1);
+				i += 2;
+				continue;
+			}
+			if (format[i] == '}')
+				throw Exception(u8"Error occured when formatting text : Unmatched_Brace");
+
+			auto close = format.find('}', i);
+			if (close == std::string_view::npos)
+				throw Exception(u8"Error occured when formatting text : Unmatched_Brace");
+			auto spec = format.substr(i + 1, close - i - 1);
+			if (!spec.empty())
+			{
+				if (spec[0] != ':')
+					throw Exception(u8"Error occured when formatting text : Invalid_Format_Spec");
+				spec.remove_prefix(1);
+			}
+			if (next == count)
+				throw Exception(u8"Error occured when formatting text : Too_Few_Arguments");
+			FormatOne(out, args[next++], spec);
+			i = close + 1;
+		}
+		out.Flush();
+	}
+}
@@ -0,0 +1,87 @@
+/**
+ @file
+ @brief 通用模板库 字节查找的实现
+
+ SSE2 是 x86-64 的基础指令集，直接使用；AVX2 在运行时检测后才使用
+ 开头与结尾不足一个向量的部分逐字节比较，所有加载都不越过 last
+
+ @author 司马坑
+ @date 2026/10/17
+*/
+#include "Utilities.Common.Scan.h"
+#include "Utilities.Simd.h"
+
+#include <cstring>
+
+namespace Utilities::Common
+{
+	namespace
+	{
+#ifdef UTILITIES_SIMD_X86
+		const char* FindByteSSE2(const char* p, const char* last, char value)
+		{
+			auto needle = _mm_set1_epi8(value);
+			for (; last - p >= 16; p += 16)
+			{
+				auto v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+				auto mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, needle)));
+				if (mask != 0)
+					return p + Utilities::_private::CountTrailingZeros(mask);
+			}
+			return p;
+		}
+
+		UTILITIES_TARGET("avx2")
+		const char* FindByteAVX2(const char* p, const char* last, char value)
+		{
+			auto needle = _mm256_set1_epi8(value);
+			for (; last - p >= 64; p += 64)
+			{
+				auto v0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+				auto v1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + 32));
+				auto m0 = _mm256_cmpeq_epi8(v0, needle);
+				auto m1 = _mm256_cmpeq_epi8(v1, needle);
+				// 先用一次测试判断 64 字节中是否有命中，命中时才计算具体位置
+				if (!_mm256_testz_si256(_mm256_or_si256(m0, m1), _mm256_or_si256(m0, m1)))
+				{
+					auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(m0)) |
+						static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(m1))) << 32;
+					return p + Utilities::_private::CountTrailingZeros(mask);
+				}
+			}
+			for (; last - p >= 32; p += 32)
+			{
+				auto v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+				auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, needle)));
+				if (mask != 0)
+					return p + Utilities::_private::CountTrailingZeros(mask);
+			}
+			return p;
+		}
+#endif
+	}
+
+	const char* FindByte(const char* first, const char* last, char value)
+	{
+		auto p = first;
+#ifdef UTILITIES_SIMD_X86
+		if (Utilities::_private::GetSimdLevel() == Utilities::_private::SimdLevel::AVX2)
+			p = FindByteAVX2(p, last, value);
+		if (p == last || *p == value)
+			return p;
+		p = FindByteSSE2(p, last, value);
+		if (p == last || *p == value)
+			return p;
+		for (; p != last; p++)
+		{
+			if (*p == value)
+				return p;
+		}
+		return last;
+#else
+		if (auto hit = memchr(p, value, last - p))
+			return static_cast<const char*>(hit);
+		return last;
+#endif
+	}
+}
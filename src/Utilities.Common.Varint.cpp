@@ -0,0 +1,209 @@
+/**
+ @file
+ @brief 通用模板库 变长整数批量解码的实现
+
+ 解码分三级：
+	- 支持 SSSE3 时，每次取 8 字节，以续位组成的 8 位掩码查表得到字节重排方式，
+	  一条 pshufb 把其中所有 1 到 2 字节的值同时展开到 16 位通道，再扩展为 64 位写出
+	- 3 到 8 字节的值，按 8 字节字长一次找到结束位并用掩码表截断、移位压缩
+	- 超过 8 字节的值以及缓冲区末尾逐字节解码
+
+ @author 司马坑
+ @date 2026/10/17
+*/
+#include "Utilities.Common.Varint.h"
+#include "Utilities.Common.Endian.h"
+#include "Utilities.Simd.h"
+
+#include <cstring>
+
+namespace Utilities::Common
+{
+	namespace
+	{
+		//! 长度为 n 字节的编码在 64 位字中的有效位掩码
+		constexpr uint64_t KeepMask[9] =
+		{
+			0,
+			0x00000000000000FFull, 0x000000000000FFFFull, 0x0000000000FFFFFFull, 0x00000000FFFFFFFFull,
+			0x000000FFFFFFFFFFull, 0x0000FFFFFFFFFFFFull, 0x00FFFFFFFFFFFFFFull, 0xFFFFFFFFFFFFFFFFull,
+		};
+
+		inline uint64_t LoadWord(const uint8_t* p)
+		{
+			uint64_t word;
+			memcpy(&word, p, sizeof(word));
+			return ConvertEndian<Endian::Little>(word);
+		}
+
+		/// <summary>
+		/// 把至多 8 字节的编码压缩为数值：去掉续位后把每 7 位一组依次拼接
+		/// </summary>
+		inline uint64_t CompactWord(uint64_t word, size_t len)
+		{
+			auto x = word & KeepMask[len] & 0x7F7F7F7F7F7F7F7Full;
+			x = (x & 0x007F007F007F007Full) | ((x & 0x7F007F007F007F00ull) >> 1);
+			x = (x & 0x00003FFF00003FFFull) | ((x & 0x3FFF00003FFF0000ull) >> 2);
+			x = (x & 0x000000000FFFFFFFull) | ((x & 0x0FFFFFFF00000000ull) >> 4);
+			return x;
+		}
+
+#ifdef UTILITIES_SIMD_X86
+		/// <summary>
+		/// 8 字节输入的解码方式：其中从头开始连续的 1 到 2 字节值如何重排到 16 位通道
+		/// </summary>
+		struct alignas(16) ShortShuffle
+		{
+			uint8_t shuffle[16];
+			//! 解出的值个数
+			uint8_t count;
+			//! 占用的字节数
+			uint8_t consumed;
+		};
+		struct ShortShuffleTable
+		{
+			ShortShuffle entries[256];
+		};
+		constexpr ShortShuffleTable BuildShortShuffleTable()
+		{
+			ShortShuffleTable table{};
+			for (unsigned mask = 0; mask < 256; mask++)
+			{
+				auto& e = table.entries[mask];
+				for (auto& s : e.shuffle)
+					s = 0x80;
+				unsigned pos = 0, k = 0;
+				while (pos < 8)
+				{
+					unsigned length = 0;
+					if ((mask >> pos & 1) == 0)
+						length = 1;
+					else if (pos + 1 < 8 && (mask >> (pos + 1) & 1) == 0)
+						length = 2;
+					else
+						break;
+					e.shuffle[2 * k] = static_cast<uint8_t>(pos);
+					if (length == 2)
+						e.shuffle[2 * k + 1] = static_cast<uint8_t>(pos + 1);
+					pos += length;
+					k++;
+				}
+				e.count = static_cast<uint8_t>(k);
+				e.consumed = static_cast<uint8_t>(pos);
+			}
+			return table;
+		}
+		//! 以 8 字节内的续位掩码为索引的重排表
+		constexpr ShortShuffleTable ShortShuffles = BuildShortShuffleTable();
+
+		/// <summary>
+		/// 用查表的 pshufb 批量解码 1 到 2 字节的值，3 到 8 字节的值逐个在字长上解码，
+		/// 遇到更长的值或数据不足时返回
+		/// </summary>
+		/// <returns>解码得到的值个数</returns>
+		UTILITIES_TARGET("ssse3")
+		size_t DecodeSSSE3(const uint8_t*& p, const uint8_t* end, uint64_t* out, size_t count)
+		{
+			const auto zero = _mm_setzero_si128();
+			const auto low7 = _mm_set1_epi16(0x007F);
+			const auto high7 = _mm_set1_epi16(0x7F00);
+			size_t n = 0;
+			// 每次固定写出 8 个 64 位值，其中只有 count 个有效
+			while (end - p >= 8 && count - n >= 8)
+			{
+				auto v = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(p));
+				auto mask = static_cast<unsigned>(_mm_movemask_epi8(v));
+				auto& e = ShortShuffles.entries[mask];
+				if (e.count == 0)
+				{
+					// 开头是 3 到 8 字节的值，直接在字长上解码
+					auto stops = ~mask & 0xFF;
+					if (stops == 0)
+						break;
+					auto length = Utilities::_private::CountTrailingZeros(stops) + 1;
+					out[n++] = CompactWord(LoadWord(p), length);
+					p += length;
+					continue;
+				}
+				auto lanes = _mm_shuffle_epi8(v, _mm_load_si128(reinterpret_cast<const __m128i*>(e.shuffle)));
+				auto values = _mm_or_si128(_mm_and_si128(lanes, low7), _mm_srli_epi16(_mm_and_si128(lanes, high7), 1));
+				auto lo = _mm_unpacklo_epi16(values, zero);
+				auto hi = _mm_unpackhi_epi16(values, zero);
+				auto dst = reinterpret_cast<__m128i*>(out + n);
+				_mm_storeu_si128(dst + 0, _mm_unpacklo_epi32(lo, zero));
+				_mm_storeu_si128(dst + 1, _mm_unpackhi_epi32(lo, zero));
+				_mm_storeu_si128(dst + 2, _mm_unpacklo_epi32(hi, zero));
+				_mm_storeu_si128(dst + 3, _mm_unpackhi_epi32(hi, zero));
+				n += e.count;
+				p += e.consumed;
+			}
+			return n;
+		}
+#endif
+
+		/// <summary>
+		/// 逐字节解码一个值
+		/// </summary>
+		/// <returns>编码长度，数据不完整时返回 0</returns>
+		inline size_t DecodeOne(const uint8_t* p, const uint8_t* end, uint64_t& value)
+		{
+			uint64_t v = 0;
+			for (size_t i = 0; i < MaxVarintLength; i++)
+			{
+				if (p + i == end)
+					return 0;
+				auto b = p[i];
+				if (i == MaxVarintLength - 1 && b > 1)
+					throw Exception(u8"Error occured when decoding varint : Varint_Overflow");
+				v |= static_cast<uint64_t>(b & 0x7F) << (7 * i);
+				if ((b & 0x80) == 0)
+				{
+					value = v;
+					return i + 1;
+				}
+			}
+			throw Exception(u8"Error occured when decoding varint : Varint_Overflow");
+		}
+	}
+
+	size_t DecodeVarints(const uint8_t* src, size_t len, uint64_t* out, size_t count, size_t& consumed)
+	{
+		auto p = src;
+		auto end = src + len;
+		size_t n = 0;
+#ifdef UTILITIES_SIMD_X86
+		auto ssse3 = Utilities::_private::GetSimdLevel() != Utilities::_private::SimdLevel::None;
+#endif
+		while (n < count && p != end)
+		{
+#ifdef UTILITIES_SIMD_X86
+			if (ssse3)
+			{
+				n += DecodeSSSE3(p, end, out + n, count - n);
+				if (n == count || p == end)
+					break;
+			}
+#endif
+			if (end - p >= 8)
+			{
+				auto word = LoadWord(p);
+				auto stops = ~word & 0x8080808080808080ull;
+				if (stops != 0)
+				{
+					auto length = Utilities::_private::CountTrailingZeros(stops) / 8 + 1;
+					out[n++] = CompactWord(word, length);
+					p += length;
+					continue;
+				}
+			}
+			uint64_t value;
+			auto length = DecodeOne(p, end, value);
+			if (length == 0)
+				break;
+			out[n++] = value;
+			p += length;
+		}
+		consumed = p - src;
+		return n;
+	}
+}
@@ -0,0 +1,89 @@
+/**
+ @file
+ @brief 通用协程库 Executor 实现
+
+ @author 司马坑
+ @date 2026/10/17
+*/
+#include "Utilities.Coroutine.h"
+
+#ifdef UTILITIES_HAS_COROUTINE
+namespace Utilities::Coroutine
+{
+	/// <summary>
+	/// 驱动一个 Task 运行到结束的协程，结束时自行销毁
+	/// </summary>
+	struct Executor::Detached
+	{
+		struct promise_type
+		{
+			Detached get_return_object() noexcept { return { std::coroutine_handle<promise_type>::from_promise(*this) }; }
+			std::suspend_always initial_suspend() noexcept { return {}; }
+			std::suspend_never final_suspend() noexcept { return {}; }
+			void return_void() noexcept { }
+			void unhandled_exception() noexcept { std::terminate(); }
+		};
+		std::coroutine_handle<promise_type> handle;
+	};
+
+	Executor::Detached Executor::Drive(Executor& ex, Task<void> task)
+	{
+		std::exception_ptr error;
+		try
+		{
+			co_await task;
+		}
+		catch (...)
+		{
+			error = std::current_exception();
+		}
+		// 此后不能再访问 ex ，Run 可能已经返回
+		ex.Finish(error);
+	}
+
+	void Executor::Post(std::coroutine_handle<> handle)
+	{
+		Post([handle]() { handle.resume(); });
+	}
+	void Executor::Post(std::function<void()> work)
+	{
+		// 在锁内通知：协程被恢复后可能很快结束，Run 随之返回，调度器可能已被销毁
+		std::lock_guard<std::mutex> guard(lock);
+		queue.push_back(std::move(work));
+		ready.notify_one();
+	}
+	void Executor::Spawn(Task<void> task)
+	{
+		{
+			std::lock_guard<std::mutex> guard(lock);
+			running++;
+		}
+		Post(std::coroutine_handle<>(Drive(*this, std::move(task)).handle));
+	}
+	void Executor::Finish(std::exception_ptr error)
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		if (error && !firstError)
+			firstError = error;
+		if (--running == 0)
+			ready.notify_all();
+	}
+	void Executor::Run()
+	{
+		std::unique_lock<std::mutex> guard(lock);
+		while (true)
+		{
+			ready.wait(guard, [this]() { return !queue.empty() || running == 0; });
+			if (queue.empty())
+				break;
+			auto work = std::move(queue.front());
+			queue.pop_front();
+			guard.unlock();
+			work();
+			guard.lock();
+		}
+		if (firstError)
+			std::rethrow_exception(std::exchange(firstError, nullptr));
+	}
+}
+#endif
@@ -0,0 +1,239 @@
+/**
+ @file
+ @brief 通用IO库 CSV / TSV 读取器实现
+
+ @author 司马坑
+ @date 2026/10/17
+*/
+#include "Utilities.CsvReader.h"
+#include "Utilities.Common.Scan.h"
+#include "Utilities.Simd.h"
+
+#include <cstring>
+
+namespace Utilities
+{
+	namespace
+	{
+		constexpr size_t BlockSize = 64;
+		constexpr size_t InitialBufferSize = 64 * 1024;
+
+		/// <summary>
+		/// 一个块中三类字符的位掩码，第 i 位对应块中的第 i 个字节
+		/// </summary>
+		struct BlockMasks
+		{
+			uint64_t delimiter;
+			uint64_t newline;
+			uint64_t quote;
+		};
+
+#ifdef UTILITIES_SIMD_X86
+		BlockMasks ClassifySSE2(const char* p, char delimiter, char quote)
+		{
+			auto vd = _mm_set1_epi8(delimiter);
+			auto vn = _mm_set1_epi8('\n');
+			auto vq = _mm_set1_epi8(quote);
+			BlockMasks masks{};
+			for (size_t i = 0; i < BlockSize; i += 16)
+			{
+				auto v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+				masks.delimiter |= static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, vd)))) << i;
+				masks.newline |= static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, vn)))) << i;
+				masks.quote |= static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, vq)))) << i;
+			}
+			return masks;
+		}
+
+		UTILITIES_TARGET("avx2")
+		inline uint64_t MoveMask64(__m256i lo, __m256i hi)
+		{
+			return static_cast<uint32_t>(_mm256_movemask_epi8(lo)) |
+				static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(hi))) << 32;
+		}
+
+		UTILITIES_TARGET("avx2")
+		BlockMasks ClassifyAVX2(const char* p, char delimiter, char quote)
+		{
+			auto vd = _mm256_set1_epi8(delimiter);
+			auto vn = _mm256_set1_epi8('\n');
+			auto vq = _mm256_set1_epi8(quote);
+			auto lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+			auto hi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + 32));
+			BlockMasks masks;
+			masks.delimiter = MoveMask64(_mm256_cmpeq_epi8(lo, vd), _mm256_cmpeq_epi8(hi, vd));
+			masks.newline = MoveMask64(_mm256_cmpeq_epi8(lo, vn), _mm256_cmpeq_epi8(hi, vn));
+			masks.quote = MoveMask64(_mm256_cmpeq_epi8(lo, vq), _mm256_cmpeq_epi8(hi, vq));
+			return masks;
+		}
+#endif
+
+		BlockMasks Classify(const char* p, char delimiter, char quote)
+		{
+#ifdef UTILITIES_SIMD_X86
+			if (Utilities::_private::GetSimdLevel() == Utilities::_private::SimdLevel::AVX2)
+				return ClassifyAVX2(p, delimiter, quote);
+			return ClassifySSE2(p, delimiter, quote);
+#else
+			BlockMasks masks{};
+			for (size_t i = 0; i < BlockSize; i++)
+			{
+				masks.delimiter |= static_cast<uint64_t>(p[i] == delimiter) << i;
+				masks.newline |= static_cast<uint64_t>(p[i] == '\n') << i;
+				masks.quote |= static_cast<uint64_t>(p[i] == quote) << i;
+			}
+			return masks;
+#endif
+		}
+
+		/// <summary>
+		/// 前缀异或：第 i 位为第 0 位到第 i 位的异或，即该字节之前(含)出现过奇数个引号
+		/// </summary>
+		inline uint64_t PrefixXor(uint64_t v)
+		{
+			v ^= v << 1;
+			v ^= v << 2;
+			v ^= v << 4;
+			v ^= v << 8;
+			v ^= v << 16;
+			v ^= v << 32;
+			return v;
+		}
+	}
+
+	CsvReader::CsvReader(Stream& stream, char delimiter, char quote)
+		: stream(stream), delimiter(delimiter), quote(quote), buffer(InitialBufferSize + BlockSize)
+	{
+		if (delimiter == '\n' || delimiter == quote || quote == '\n')
+			throw Exception(u8"Error occured when creating csv reader : Invalid_Delimiter");
+	}
+
+	std::optional<Common::Span<const std::string_view>> CsvReader::ReadRow()
+	{
+		fields.clear();
+		while (true)
+		{
+			while (structural == 0)
+			{
+				if (tail - next >= BlockSize || (eof && next < tail))
+				{
+					ClassifyBlock();
+					continue;
+				}
+				if (eof)
+				{
+					if (inQuote)
+						throw Exception(u8"Error occured when parsing csv : Unterminated_Quote");
+					if (head == tail)
+						return std::nullopt;
+					// 最后一行没有换行符
+					EndField(tail, true);
+					head = fieldStart = tail;
+					return MakeRow();
+				}
+				Refill();
+			}
+
+			auto bit = Utilities::_private::CountTrailingZeros(structural);
+			auto pos = block + bit;
+			structural &= structural - 1;
+			if (((newlines >> bit) & 1) == 0)
+			{
+				EndField(pos, false);
+				fieldStart = pos + 1;
+			}
+			else
+			{
+				EndField(pos, true);
+				head = fieldStart = pos + 1;
+				return MakeRow();
+			}
+		}
+	}
+
+	void CsvReader::Refill()
+	{
+		// 调用时当前块已经处理完，不需要调整 structural；当前行已完成的字段随数据一起移动
+		if (head != 0)
+		{
+			memmove(buffer.data(), buffer.data() + head, tail - head);
+			for (auto& field : fields)
+				field = std::string_view(field.data() - head, field.size());
+			tail -= head;
+			next -= head;
+			fieldStart -= head;
+			head = 0;
+		}
+		auto capacity = buffer.size() - BlockSize;
+		if (tail == capacity)
+		{
+			std::vector<char> larger(capacity * 2 + BlockSize);
+			memcpy(larger.data(), buffer.data(), tail);
+			for (auto& field : fields)
+				field = std::string_view(larger.data() + (field.data() - buffer.data()), field.size());
+			buffer.swap(larger);
+			capacity *= 2;
+		}
+		auto n = stream.ReadSome(capacity - tail, buffer.data() + tail);
+		if (n == 0)
+			eof = true;
+		tail += n;
+	}
+
+	void CsvReader::ClassifyBlock()
+	{
+		// 缓冲区末尾多分配了一个块的大小，流结束时不足一块的部分也可以整块加载，多出的位在这里清除
+		auto len = tail - next < BlockSize ? tail - next : BlockSize;
+		auto valid = len == BlockSize ? ~uint64_t(0) : (uint64_t(1) << len) - 1;
+		auto masks = Classify(buffer.data() + next, delimiter, quote);
+		auto quotes = quote == '\0' ? 0 : masks.quote & valid;
+		auto inside = PrefixXor(quotes) ^ (inQuote ? ~uint64_t(0) : 0);
+		inQuote = (inside >> (len - 1)) & 1;
+		structural = (masks.delimiter | masks.newline) & valid & ~inside;
+		newlines = masks.newline;
+		block = next;
+		next += len;
+	}
+
+	void CsvReader::EndField(size_t end, bool lastInRow)
+	{
+		auto first = buffer.data() + fieldStart;
+		auto last = buffer.data() + end;
+		if (lastInRow && last != first && last[-1] == '\r')
+			last--;
+		if (last == first || *first != quote || quote == '\0')
+		{
+			fields.emplace_back(first, last - first);
+			return;
+		}
+
+		// 原地去掉引号："a""b" -> a"b ，结束引号之后的字符原样保留
+		auto out = first;
+		const char* src = first + 1;
+		while (src < last)
+		{
+			auto hit = Common::FindByte(src, last, quote);
+			memmove(out, src, hit - src);
+			out += hit - src;
+			if (hit == last)
+				break;
+			if (hit + 1 < last && hit[1] == quote)
+			{
+				*out++ = quote;
+				src = hit + 2;
+				continue;
+			}
+			src = hit + 1;
+			memmove(out, src, last - src);
+			out += last - src;
+			break;
+		}
+		fields.emplace_back(first, out - first);
+	}
+
+	Common::Span<const std::string_view> CsvReader::MakeRow()
+	{
+		rows++;
+		return Common::Span<const std::string_view>(fields.data(), fields.size());
+	}
+}
@@ -0,0 +1,368 @@
+/**
+ @file
+ @brief 通用IO库 直接IO文件流实现
+
+ 所有对文件的读写都以 Alignment 对齐的偏移量和长度进行：
+	- 缓冲区窗口覆盖 [bufferOffset, bufferOffset + bufferSize) ，读取时整块载入，写满时整块写出
+	- 地址和位置都对齐且长度不小于缓冲区的读写直接在调用者的内存上进行
+	- 写出不足一个扇区的尾部时以 0 填充，之后把文件截断回实际长度
+
+ @author 司马坑
+ @date 2026/10/17
+*/
+#include "Utilities.DirectFileStream.h"
+#include "Utilities.Common.AlignedAllocator.h"
+#include "Utilities.Platform.h"
+
+#include <cstring>
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#endif
+
+namespace Utilities
+{
+	static inline uint64_t AlignDown(uint64_t v) { return v & ~static_cast<uint64_t>(DirectFileStream::Alignment - 1); }
+	static inline uint64_t AlignUp(uint64_t v) { return AlignDown(v + DirectFileStream::Alignment - 1); }
+
+	//! 单次系统调用传输的最大长度，按 Alignment 对齐
+	constexpr size_t MaxTransfer = 0x40000000;
+
+	/// <summary>
+	/// 从 offset 处读取至多 len 字节，到达文件末尾时提前返回
+	/// </summary>
+	static size_t ReadBlocks(intptr_t file, uint64_t offset, size_t len, uint8* data)
+	{
+		size_t done = 0;
+		while (done < len)
+		{
+			auto chunk = len - done < MaxTransfer ? len - done : MaxTransfer;
+#ifdef _WIN32
+			OVERLAPPED ov = {};
+			ov.Offset = static_cast<DWORD>(offset + done);
+			ov.OffsetHigh = static_cast<DWORD>((offset + done) >> 32);
+			DWORD readLen = 0;
+			if (!ReadFile(reinterpret_cast<HANDLE>(file), data + done, static_cast<DWORD>(chunk), &readLen, &ov))
+			{
+				if (GetLastError() == ERROR_HANDLE_EOF)
+					break;
+				throw Exception(u8"Error occured when reading file : Read_Failed");
+			}
+#else
+			auto readLen = pread(static_cast<int>(file), data + done, chunk, static_cast<off_t>(offset + done));
+			if (readLen < 0 && errno == EINTR)
+				continue;
+			if (readLen < 0)
+				_private::ThrowSystemError(u8"Error occured when reading file :");
+#endif
+			if (readLen == 0)
+				break;
+			done += static_cast<size_t>(readLen);
+		}
+		return done;
+	}
+	/// <summary>
+	/// 向 offset 处写入 len 字节
+	/// </summary>
+	static void WriteBlocks(intptr_t file, uint64_t offset, size_t len, const uint8* data)
+	{
+		size_t done = 0;
+		while (done < len)
+		{
+			auto chunk = len - done < MaxTransfer ? len - done : MaxTransfer;
+#ifdef _WIN32
+			OVERLAPPED ov = {};
+			ov.Offset = static_cast<DWORD>(offset + done);
+			ov.OffsetHigh = static_cast<DWORD>((offset + done) >> 32);
+			DWORD writeLen = 0;
+			if (!WriteFile(reinterpret_cast<HANDLE>(file), data + done, static_cast<DWORD>(chunk), &writeLen, &ov))
+				throw Exception(u8"Error occured when writing file : Write_Failed");
+#else
+			auto writeLen = pwrite(static_cast<int>(file), data + done, chunk, static_cast<off_t>(offset + done));
+			if (writeLen < 0 && errno == EINTR)
+				continue;
+			if (writeLen < 0)
+				_private::ThrowSystemError(u8"Error occured when writing file :");
+#endif
+			done += static_cast<size_t>(writeLen);
+		}
+	}
+
+	DirectFileStream::DirectFileStream(const wchar_t* fileName, const Type& ioType, size_t bufferSize) : Stream(ioType)
+	{
+		this->bufferSize = static_cast<size_t>(AlignUp(bufferSize == 0 ? Alignment : bufferSize));
+#ifdef _WIN32
+		DWORD access = GENERIC_READ;
+		DWORD disposition = OPEN_EXISTING;
+		// 写入不足一个扇区的数据时需要先读出原有内容，因此只写模式也要求读权限
+		if (ioType == Type::WriteOnly)
+		{
+			access |= GENERIC_WRITE;
+			disposition = CREATE_ALWAYS;
+		}
+		else if (ioType == Type::ReadWrite)
+		{
+			access |= GENERIC_WRITE;
+			disposition = OPEN_ALWAYS;
+		}
+		auto handle = CreateFileW(fileName, access, FILE_SHARE_READ, nullptr, disposition,
+			FILE_ATTRIBUTE_NORMAL | FILE_FLAG_NO_BUFFERING, nullptr);
+		if (handle == INVALID_HANDLE_VALUE)
+			throw Exception(u8"Error occured when opening file : Cannot_Open_File");
+
+		LARGE_INTEGER size;
+		if (!GetFileSizeEx(handle, &size))
+		{
+			CloseHandle(handle);
+			throw Exception(u8"Error occured when opening file : Cannot_Get_File_Size");
+		}
+		file = reinterpret_cast<intptr_t>(handle);
+		length = static_cast<uint64_t>(size.QuadPart);
+		direct = true;
+#else
+		auto path = _private::NarrowPath(fileName);
+		int flags = O_CLOEXEC;
+		// 写入不足一个扇区的数据时需要先读出原有内容，因此只写模式也要求读权限
+		if (ioType == Type::ReadOnly)
+			flags |= O_RDONLY;
+		else if (ioType == Type::WriteOnly)
+			flags |= O_RDWR | O_CREAT | O_TRUNC;
+		else
+			flags |= O_RDWR | O_CREAT;
+
+		int fd = -1;
+#ifdef O_DIRECT
+		fd = open(path.c_str(), flags | O_DIRECT, 0666);
+		direct = fd >= 0;
+		// 文件系统不支持 O_DIRECT 时返回 EINVAL
+		if (fd < 0 && errno != EINVAL)
+			_private::ThrowSystemError(u8"Error occured when opening file :");
+#endif
+		if (fd < 0)
+			fd = open(path.c_str(), flags, 0666);
+		if (fd < 0)
+			_private::ThrowSystemError(u8"Error occured when opening file :");
+
+		struct stat st;
+		if (fstat(fd, &st) != 0)
+		{
+			auto err = errno;
+			::close(fd);
+			_private::ThrowSystemError(u8"Error occured when opening file :", err);
+		}
+		file = fd;
+		length = static_cast<uint64_t>(st.st_size);
+#endif
+		buffer = static_cast<uint8*>(Common::AlignedAlloc(this->bufferSize, Alignment));
+	}
+	DirectFileStream::~DirectFileStream()
+	{
+		try
+		{
+			Close();
+		}
+		catch (...)
+		{
+			// 析构函数中无法报告错误
+		}
+		Common::AlignedFree(buffer);
+	}
+
+	bool DirectFileStream::CanBypass(const void* data, size_t len) const
+	{
+		return len >= bufferSize && position % Alignment == 0 && reinterpret_cast<uintptr_t>(data) % Alignment == 0;
+	}
+	void DirectFileStream::LoadWindow(uint64_t pos)
+	{
+		FlushWindow();
+		bufferOffset = AlignDown(pos);
+		size_t readLen = 0;
+		if (bufferOffset < length)
+			readLen = ReadBlocks(file, bufferOffset, bufferSize, buffer);
+		// 文件中的空洞以及末尾之后的部分都视为 0
+		memset(buffer + readLen, 0, bufferSize - readLen);
+		bufferValid = bufferOffset < length ? static_cast<size_t>(length - bufferOffset < bufferSize ? length - bufferOffset : bufferSize) : 0;
+	}
+	void DirectFileStream::FlushWindow()
+	{
+		if (!dirty)
+			return;
+		auto writeLen = static_cast<size_t>(AlignUp(bufferValid));
+		memset(buffer + bufferValid, 0, writeLen - bufferValid);
+		WriteBlocks(file, bufferOffset, writeLen, buffer);
+		if (bufferOffset + writeLen > length)
+			padded = true;
+		dirty = false;
+	}
+
+	void DirectFileStream::Read(size_t len, void* data)
+	{
+		if (GetStreamType() == Type::WriteOnly)
+			throw Exception(u8"Error occured when reading stream : Cannot_Read_WriteOnly_Stream");
+		if (file == -1)
+			throw Exception("Stream Closed");
+		if (position > length || len > length - position)
+			throw Exception(u8"Error occured when reading stream : End_Of_Stream");
+
+		auto dst = static_cast<uint8*>(data);
+		while (len != 0)
+		{
+			if (position >= bufferOffset && position < bufferOffset + bufferValid)
+			{
+				auto offset = static_cast<size_t>(position - bufferOffset);
+				auto n = bufferValid - offset < len ? bufferValid - offset : len;
+				memcpy(dst, buffer + offset, n);
+				dst += n;
+				len -= n;
+				position += n;
+			}
+			else if (CanBypass(dst, len))
+			{
+				// 写出缓冲区后文件中的数据就是最新的
+				FlushWindow();
+				auto n = static_cast<size_t>(AlignDown(len));
+				if (ReadBlocks(file, position, n, dst) != n)
+					throw Exception(u8"Error occured when reading stream : End_Of_Stream");
+				dst += n;
+				len -= n;
+				position += n;
+			}
+			else
+				LoadWindow(position);
+		}
+	}
+	void DirectFileStream::Write(size_t len, const void* data)
+	{
+		if (GetStreamType() == Type::ReadOnly)
+			throw Exception(u8"Error occured when writing stream : Cannot_Write_ReadOnly_Stream");
+		if (file == -1)
+			throw Exception("Stream Closed");
+
+		auto src = static_cast<const uint8*>(data);
+		while (len != 0)
+		{
+			if (position < bufferOffset || position >= bufferOffset + bufferSize || (bufferValid == 0 && !dirty))
+			{
+				if (CanBypass(src, len))
+				{
+					FlushWindow();
+					auto n = static_cast<size_t>(AlignDown(len));
+					WriteBlocks(file, position, n, src);
+					// 缓冲区中与本次写入重叠的内容已经过期
+					if (bufferOffset < position + n && position < bufferOffset + bufferSize)
+						bufferValid = 0;
+					src += n;
+					len -= n;
+					position += n;
+					if (position > length)
+						length = position;
+					continue;
+				}
+				LoadWindow(position);
+			}
+
+			auto offset = static_cast<size_t>(position - bufferOffset);
+			auto n = bufferSize - offset < len ? bufferSize - offset : len;
+			memcpy(buffer + offset, src, n);
+			if (offset + n > bufferValid)
+				bufferValid = offset + n;
+			dirty = true;
+			src += n;
+			len -= n;
+			position += n;
+			if (position > length)
+				length = position;
+			// 写满的窗口立即整块写出
+			if (offset + n == bufferSize)
+				FlushWindow();
+		}
+	}
+	size_t DirectFileStream::ReadSome(size_t maxLen, void* data)
+	{
+		if (file == -1)
+			throw Exception("Stream Closed");
+		if (position >= length)
+			return 0;
+		auto len = length - position < maxLen ? static_cast<size_t>(length - position) : maxLen;
+		Read(len, data);
+		return len;
+	}
+	void DirectFileStream::Flush()
+	{
+		if (file == -1)
+			throw Exception("Stream Closed");
+		FlushWindow();
+		if (!padded)
+			return;
+#ifdef _WIN32
+		FILE_END_OF_FILE_INFO info;
+		info.EndOfFile.QuadPart = static_cast<LONGLONG>(length);
+		if (!SetFileInformationByHandle(reinterpret_cast<HANDLE>(file), FileEndOfFileInfo, &info, sizeof(info)))
+			throw Exception(u8"Error occured when writing file : Cannot_Truncate_File");
+#else
+		if (ftruncate(static_cast<int>(file), static_cast<off_t>(length)) != 0)
+			_private::ThrowSystemError(u8"Error occured when writing file :");
+#endif
+		padded = false;
+	}
+	void DirectFileStream::Close()
+	{
+		if (file == -1)
+			return;
+		try
+		{
+			Flush();
+		}
+		catch (...)
+		{
+#ifdef _WIN32
+			CloseHandle(reinterpret_cast<HANDLE>(file));
+#else
+			::close(static_cast<int>(file));
+#endif
+			file = -1;
+			throw;
+		}
+#ifdef _WIN32
+		CloseHandle(reinterpret_cast<HANDLE>(file));
+#else
+		::close(static_cast<int>(file));
+#endif
+		file = -1;
+	}
+	bool DirectFileStream::IsVaild()
+	{
+		return file != -1;
+	}
+
+	uint64_t DirectFileStream::GetLength()
+	{
+		if (file == -1)
+			throw Exception("Stream Closed");
+		return length;
+	}
+	uint64_t DirectFileStream::GetPosition()
+	{
+		if (file == -1)
+			throw Exception("Stream Closed");
+		return position;
+	}
+	void DirectFileStream::SetPosition(uint64_t pos)
+	{
+		if (file == -1)
+			throw Exception("Stream Closed");
+		position = pos;
+	}
+	void DirectFileStream::Seek(int64_t offset)
+	{
+		if (file == -1)
+			throw Exception("Stream Closed");
+		if (offset < 0 && static_cast<uint64_t>(-offset) > position)
+			throw Exception(u8"Error occured when seeking stream : Position_Out_Of_Range");
+		position += offset;
+	}
+}
@@ -0,0 +1,185 @@
+/**
+ @file
+ @brief 通用IO库 文件句柄缓存实现
+
+ @author 司马坑
+ @date 2026/10/17
+*/
+#include "Utilities.FileHandleCache.h"
+
+#include <algorithm>
+#include <functional>
+
+namespace Utilities
+{
+	FileHandleCache::Lease::Lease(Lease&& rhs) noexcept
+		: cache(rhs.cache), entry(std::move(rhs.entry))
+	{
+		rhs.cache = nullptr;
+	}
+	FileHandleCache::Lease& FileHandleCache::Lease::operator=(Lease&& rhs) noexcept
+	{
+		if (this != &rhs)
+		{
+			Release();
+			cache = rhs.cache;
+			entry = std::move(rhs.entry);
+			rhs.cache = nullptr;
+		}
+		return *this;
+	}
+	FileHandleCache::Lease::~Lease()
+	{
+		Release();
+	}
+	void FileHandleCache::Lease::Release()
+	{
+		if (entry)
+			cache->Return(std::move(entry));
+		cache = nullptr;
+	}
+
+	FileHandleCache::FileHandleCache(size_t capacity)
+		: capacity(capacity == 0 ? 1 : capacity)
+	{
+
+	}
+	FileHandleCache::~FileHandleCache()
+	{
+		Clear();
+	}
+
+	size_t FileHandleCache::KeyHash::operator()(const Key& key) const
+	{
+		auto h = std::hash<std::wstring>()(key.fileName);
+		return h ^ (static_cast<size_t>(key.ioType) * 2 + (key.isTextMode ? 1 : 0) + 1) * 0x9E3779B9u;
+	}
+
+	FileHandleCache::Lease FileHandleCache::Acquire(const wchar_t* fileName, Stream::Type ioType, bool isTextMode)
+	{
+		Key key{ fileName, ioType, isTextMode };
+		std::unique_ptr<Entry> victim;
+		std::unique_ptr<Entry> reused;
+		uint64_t generation = 0;
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			auto it = idle.find(key);
+			if (it != idle.end())
+			{
+				hits.fetch_add(1, std::memory_order_relaxed);
+				reused = Remove(it->second.back());
+			}
+			else
+			{
+				// 先占用一个名额，超过容量时关闭最久未使用的空闲文件流
+				misses.fetch_add(1, std::memory_order_relaxed);
+				openCount++;
+				if (openCount > capacity && !lru.empty())
+				{
+					victim = Remove(std::prev(lru.end()));
+					openCount--;
+					evictions.fetch_add(1, std::memory_order_relaxed);
+				}
+				auto g = generations.find(key.fileName);
+				if (g != generations.end())
+					generation = g->second;
+			}
+		}
+		if (reused)
+		{
+			// 与新打开的文件流一样从文件开头开始读写
+			Lease lease(this, std::move(reused));
+			lease->SetPosition(0);
+			return lease;
+		}
+		victim.reset();
+
+		auto entry = std::make_unique<Entry>();
+		try
+		{
+			entry->stream = std::make_unique<FileStream>(fileName, ioType, isTextMode);
+		}
+		catch (...)
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			openCount--;
+			throw;
+		}
+		entry->key = std::move(key);
+		entry->generation = generation;
+		return Lease(this, std::move(entry));
+	}
+
+	void FileHandleCache::Invalidate(const wchar_t* fileName)
+	{
+		std::vector<std::unique_ptr<Entry>> closing;
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			generations[fileName]++;
+			for (auto it = lru.begin(); it != lru.end();)
+			{
+				auto next = std::next(it);
+				if ((*it)->key.fileName == fileName)
+					closing.push_back(Remove(it));
+				it = next;
+			}
+			openCount -= closing.size();
+		}
+	}
+	void FileHandleCache::Clear()
+	{
+		std::vector<std::unique_ptr<Entry>> closing;
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			while (!lru.empty())
+				closing.push_back(Remove(lru.begin()));
+			openCount -= closing.size();
+		}
+	}
+
+	size_t FileHandleCache::GetOpenCount()
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		return openCount;
+	}
+	FileHandleCache::Statistics FileHandleCache::GetStatistics() const
+	{
+		Statistics statistics;
+		statistics.hits = hits.load(std::memory_order_relaxed);
+		statistics.misses = misses.load(std::memory_order_relaxed);
+		statistics.evictions = evictions.load(std::memory_order_relaxed);
+		return statistics;
+	}
+
+	void FileHandleCache::Return(std::unique_ptr<Entry> entry)
+	{
+		// 需要关闭的文件流在释放锁之后析构
+		std::unique_ptr<Entry> closing;
+		std::lock_guard<std::mutex> lock(mutex);
+		auto g = generations.find(entry->key.fileName);
+		auto stale = g != generations.end() && g->second != entry->generation;
+		// 只写的文件流在打开时截断文件，复用会跳过这一步，因此不缓存
+		auto writeOnly = entry->key.ioType == Stream::Type::WriteOnly;
+		if (stale || writeOnly || openCount > capacity || !entry->stream->IsVaild())
+		{
+			if (!stale && !writeOnly && openCount > capacity)
+				evictions.fetch_add(1, std::memory_order_relaxed);
+			openCount--;
+			closing = std::move(entry);
+			return;
+		}
+		lru.push_front(std::move(entry));
+		idle[lru.front()->key].push_back(lru.begin());
+	}
+	std::unique_ptr<FileHandleCache::Entry> FileHandleCache::Remove(LruList::iterator it)
+	{
+		auto slot = idle.find((*it)->key);
+		auto& list = slot->second;
+		list.erase(std::find(list.begin(), list.end(), it));
+		if (list.empty())
+			idle.erase(slot);
+		auto entry = std::move(*it);
+		lru.erase(it);
+		return entry;
+	}
+}
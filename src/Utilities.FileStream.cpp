@@ -2,18 +2,163 @@
  @file
  @brief 通用IO库 文件流实现
 
+ Windows 下文件流建立在 C 运行库的 FILE* 之上，
+ 其他平台上直接使用文件描述符，读写操作不经过 stdio 的缓冲与锁
+
  @author 司马坑
  @date 2020/2/11
 */
 #define _CRT_SECURE_NO_WARNINGS
 #include "Utilities.FileStream.h"
+#include "Utilities.Platform.h"
 
 #include <cstdio>
+#include <vector>
+
+#ifdef _WIN32
+#include <Windows.h>
+#include <io.h>
+#else
+#include <climits>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#ifdef __linux__
+#include <sys/sendfile.h>
+#endif
+#endif
 
 namespace Utilities
 {
+#ifndef _WIN32
+	/// <summary>
+	/// 循环调用 read / pread 直到读满 len 字节或到达文件末尾
+	/// </summary>
+	/// <param name="offset">小于 0 时使用文件描述符的当前位置</param>
+	/// <returns>实际读取的字节数</returns>
+	static size_t ReadFully(int fd, size_t len, void* data, int64_t offset)
+	{
+		auto dst = static_cast<uint8*>(data);
+		size_t done = 0;
+		while (done < len)
+		{
+			auto readLen = offset < 0 ?
+				read(fd, dst + done, len - done) :
+				pread(fd, dst + done, len - done, static_cast<off_t>(offset + done));
+			if (readLen < 0 && errno == EINTR)
+				continue;
+			if (readLen < 0)
+				_private::ThrowSystemError(u8"Error occured when reading file :");
+			if (readLen == 0)
+				break;
+			done += static_cast<size_t>(readLen);
+		}
+		return done;
+	}
+	/// <summary>
+	/// 循环调用 write / pwrite 直到写完 len 字节
+	/// </summary>
+	/// <param name="offset">小于 0 时使用文件描述符的当前位置</param>
+	static void WriteFully(int fd, size_t len, const void* data, int64_t offset)
+	{
+		auto src = static_cast<const uint8*>(data);
+		size_t done = 0;
+		while (done < len)
+		{
+			auto writeLen = offset < 0 ?
+				write(fd, src + done, len - done) :
+				pwrite(fd, src + done, len - done, static_cast<off_t>(offset + done));
+			if (writeLen < 0 && errno == EINTR)
+				continue;
+			if (writeLen < 0)
+				_private::ThrowSystemError(u8"Error occured when writing file :");
+			done += static_cast<size_t>(writeLen);
+		}
+	}
+	/// <summary>
+	/// 对 iovec 数组循环调用 readv / writev，处理部分完成的情况
+	/// </summary>
+	template<bool IsWrite>
+	static size_t TransferV(int fd, std::vector<iovec>& iov)
+	{
+		size_t index = 0;
+		size_t done = 0;
+		while (index < iov.size())
+		{
+			auto batch = iov.size() - index < IOV_MAX ? iov.size() - index : IOV_MAX;
+			auto len = IsWrite ?
+				writev(fd, iov.data() + index, static_cast<int>(batch)) :
+				readv(fd, iov.data() + index, static_cast<int>(batch));
+			if (len < 0 && errno == EINTR)
+				continue;
+			if (len < 0)
+				_private::ThrowSystemError(IsWrite ? u8"Error occured when writing file :" : u8"Error occured when reading file :");
+			if (len == 0)
+				break;
+			done += static_cast<size_t>(len);
+			// 跳过已经完成的缓冲区，调整只完成了一部分的缓冲区
+			auto n = static_cast<size_t>(len);
+			while (index < iov.size() && n >= iov[index].iov_len)
+				n -= iov[index++].iov_len;
+			if (index < iov.size())
+			{
+				iov[index].iov_base = static_cast<uint8*>(iov[index].iov_base) + n;
+				iov[index].iov_len -= n;
+			}
+		}
+		return done;
+	}
+	/// <summary>
+	/// 在内核中把 in 当前位置起的 len 字节复制到 out 的当前位置，数据不经过用户态
+	/// <para>
+	/// 依次尝试 copy_file_range、sendfile、splice，当前文件组合不被支持时换用下一种
+	/// </para>
+	/// </summary>
+	/// <returns>实际复制的字节数，小于 len 时剩余部分需要在用户态复制</returns>
+	static uint64_t KernelCopy(int in, int out, uint64_t len)
+	{
+		uint64_t done = 0;
+#ifdef __linux__
+		enum class Method { CopyFileRange, SendFile, Splice, None };
+		auto method = Method::CopyFileRange;
+		while (done < len && method != Method::None)
+		{
+			auto chunk = static_cast<size_t>(len - done < 0x40000000 ? len - done : 0x40000000);
+			ssize_t copied = -1;
+			switch (method)
+			{
+			case Method::CopyFileRange:
+				copied = copy_file_range(in, nullptr, out, nullptr, chunk, 0);
+				break;
+			case Method::SendFile:
+				copied = sendfile(out, in, nullptr, chunk);
+				break;
+			default:
+				// splice 要求其中一端是管道
+				copied = splice(in, nullptr, out, nullptr, chunk, SPLICE_F_MOVE);
+				break;
+			}
+			if (copied < 0 && errno == EINTR)
+				continue;
+			if (copied < 0 && errno != EINVAL && errno != EXDEV && errno != ENOSYS && errno != EOPNOTSUPP && errno != EBADF)
+				_private::ThrowSystemError(u8"Error occured when copying file :");
+			if (copied <= 0)
+			{
+				// 不支持或者读不到数据(例如 procfs)，换用下一种方式；真正的文件末尾由用户态复制报告
+				method = static_cast<Method>(static_cast<int>(method) + 1);
+				continue;
+			}
+			done += static_cast<uint64_t>(copied);
+		}
+#endif
+		return done;
+	}
+#endif
+
 	FileStream::FileStream(const wchar_t* fileName, const Type& ioType, bool isTextMode) : Stream(ioType)
 	{
+#ifdef _WIN32
 		//! @todo 使用_waccess函数进行可访问性验证并抛出异常
 		// https://docs.microsoft.com/en-us/cpp/c-runtime-library/reference/access-waccess?view=vs-2019
 
@@ -23,10 +168,13 @@ namespace Utilities
 		{
 		case Stream::Type::ReadOnly: mode = isTextMode ? L"r" : L"rb"; break;
 		case Stream::Type::WriteOnly: mode = isTextMode ? L"w" : L"wb"; break;
-		case Stream::Type::ReadWrite:throw Exception(u8"IO Mode 'Type::ReadWrite' on 'FileStream' is not supported.");
+		case Stream::Type::ReadWrite: mode = isTextMode ? L"r+" : L"r+b"; break;
 		default: throw Exception(u8"Unknow IO Mode 'Type::Unknown'");
 		};
 		auto err = _wfopen_s(&fp, fileName, mode);
+		// 可读写模式下文件不存在时创建文件
+		if (err == ENOENT && ioType == Stream::Type::ReadWrite)
+			err = _wfopen_s(&fp, fileName, isTextMode ? L"w+" : L"w+b");
 		if (err != 0)
 		{
 			//! @todo 等CodeConv完事了把这里的异常处理加上文件名
@@ -36,19 +184,41 @@ namespace Utilities
 		};
 
 		this->handle = fp;
+#else
+		// POSIX 系统不区分文本模式与二进制模式
+		(void)isTextMode;
+		int flags = O_CLOEXEC;
+		switch (ioType)
+		{
+		case Stream::Type::ReadOnly: flags |= O_RDONLY; break;
+		case Stream::Type::WriteOnly: flags |= O_WRONLY | O_CREAT | O_TRUNC; break;
+		case Stream::Type::ReadWrite: flags |= O_RDWR | O_CREAT; break;
+		default: throw Exception(u8"Unknow IO Mode 'Type::Unknown'");
+		};
+		auto path = _private::NarrowPath(fileName);
+		int fd;
+		do
+			fd = open(path.c_str(), flags, 0666);
+		while (fd < 0 && errno == EINTR);
+		if (fd < 0)
+			_private::ThrowSystemError(u8"Error occured when opening file :");
+
+		this->fd = fd;
+#endif
 	}
 	FileStream::~FileStream()
 	{
-		auto fp = reinterpret_cast<FILE*>(handle);
-		if (fp != nullptr)
-			fclose(fp);
+		Close();
 	}
 	void FileStream::Read(size_t len, void* data)
 	{
 		if (GetStreamType() == Type::WriteOnly)
 			throw Exception(u8"Error occured when reading stream : Cannot_Read_WriteOnly_Stream");
 
+#ifdef _WIN32
+		std::lock_guard<std::mutex> lock(positionalLock);
 		auto fp = reinterpret_cast<FILE*>(handle);
+		SwitchDirection(false);
 		auto readLen = fread(data, 1, len, fp);
 
 		if (readLen != len)
@@ -57,13 +227,22 @@ namespace Utilities
 			auto errInfo = u8string("Error occured when opening file :") + strerror(err);
 			throw Exception(errInfo.data());
 		}
+#else
+		if (fd < 0)
+			throw Exception("Stream Closed");
+		if (ReadFully(fd, len, data, -1) != len)
+			throw Exception(u8"Error occured when reading stream : End_Of_Stream");
+#endif
 	}
 	void FileStream::Write(size_t len, const void* data)
 	{
 		if (GetStreamType() == Type::ReadOnly)
 			throw Exception(u8"Error occured when reading stream : Cannot_Write_ReadOnly_Stream");
 
+#ifdef _WIN32
+		std::lock_guard<std::mutex> lock(positionalLock);
 		auto fp = reinterpret_cast<FILE*>(handle);
+		SwitchDirection(true);
 		auto writeLen = fwrite(data, 1, len, fp);
 
 		if (writeLen != len)
@@ -72,20 +251,217 @@ namespace Utilities
 			auto errInfo = u8string("Error occured when opening file :") + strerror(err);
 			throw Exception(errInfo.data());
 		}
+#else
+		if (fd < 0)
+			throw Exception("Stream Closed");
+		WriteFully(fd, len, data, -1);
+#endif
+	}
+	size_t FileStream::ReadSome(size_t maxLen, void* data)
+	{
+		if (GetStreamType() == Type::WriteOnly)
+			throw Exception(u8"Error occured when reading stream : Cannot_Read_WriteOnly_Stream");
+
+#ifdef _WIN32
+		std::lock_guard<std::mutex> lock(positionalLock);
+		auto fp = reinterpret_cast<FILE*>(handle);
+		SwitchDirection(false);
+		auto readLen = fread(data, 1, maxLen, fp);
+
+		if (readLen != maxLen && ferror(fp))
+		{
+			auto err = ferror(fp);
+			auto errInfo = u8string("Error occured when opening file :") + strerror(err);
+			throw Exception(errInfo.data());
+		}
+		return readLen;
+#else
+		if (fd < 0)
+			throw Exception("Stream Closed");
+		while (true)
+		{
+			auto readLen = read(fd, data, maxLen);
+			if (readLen < 0 && errno == EINTR)
+				continue;
+			if (readLen < 0)
+				_private::ThrowSystemError(u8"Error occured when reading file :");
+			return static_cast<size_t>(readLen);
+		}
+#endif
+	}
+	void FileStream::Flush()
+	{
+#ifdef _WIN32
+		std::lock_guard<std::mutex> lock(positionalLock);
+		auto fp = reinterpret_cast<FILE*>(handle);
+		if (fp != nullptr)
+			fflush(fp);
+#else
+		// 文件描述符没有用户态缓冲
+#endif
+	}
+	void FileStream::Sync()
+	{
+		if (!IsVaild())
+			throw Exception("Stream Closed");
+		// Windows 下先把 FILE* 的缓冲区交给系统
+		Flush();
+#ifdef _WIN32
+		auto osHandle = reinterpret_cast<HANDLE>(_get_osfhandle(_fileno(reinterpret_cast<FILE*>(handle))));
+		if (!FlushFileBuffers(osHandle))
+			throw Exception(u8"Error occured when syncing file : FlushFileBuffers_Failed");
+#else
+		int result;
+		do
+		{
+#if defined(__APPLE__)
+			// macOS 的 fsync 不保证数据写入介质
+			result = fcntl(fd, F_FULLFSYNC);
+#elif defined(__linux__)
+			result = fdatasync(fd);
+#else
+			result = fsync(fd);
+#endif
+		} while (result < 0 && errno == EINTR);
+		if (result < 0)
+			_private::ThrowSystemError(u8"Error occured when syncing file :");
+#endif
+	}
+	void FileStream::ReadV(size_t count, const Segment* segments)
+	{
+#ifdef _WIN32
+		Stream::ReadV(count, segments);
+#else
+		if (GetStreamType() == Type::WriteOnly)
+			throw Exception(u8"Error occured when reading stream : Cannot_Read_WriteOnly_Stream");
+		if (fd < 0)
+			throw Exception("Stream Closed");
+
+		std::vector<iovec> iov(count);
+		size_t total = 0;
+		for (size_t i = 0; i < count; i++)
+		{
+			iov[i].iov_base = segments[i].data;
+			iov[i].iov_len = segments[i].len;
+			total += segments[i].len;
+		}
+		if (TransferV<false>(fd, iov) != total)
+			throw Exception(u8"Error occured when reading stream : End_Of_Stream");
+#endif
+	}
+	void FileStream::WriteV(size_t count, const ConstSegment* segments)
+	{
+#ifdef _WIN32
+		Stream::WriteV(count, segments);
+#else
+		if (GetStreamType() == Type::ReadOnly)
+			throw Exception(u8"Error occured when reading stream : Cannot_Write_ReadOnly_Stream");
+		if (fd < 0)
+			throw Exception("Stream Closed");
+
+		std::vector<iovec> iov(count);
+		for (size_t i = 0; i < count; i++)
+		{
+			iov[i].iov_base = const_cast<void*>(segments[i].data);
+			iov[i].iov_len = segments[i].len;
+		}
+		TransferV<true>(fd, iov);
+#endif
+	}
+	void FileStream::CopyTo(Stream& dst, uint64_t len)
+	{
+#ifdef _WIN32
+		Stream::CopyTo(dst, len);
+#else
+		auto target = dynamic_cast<FileStream*>(&dst);
+		if (target == nullptr || len == 0)
+			return Stream::CopyTo(dst, len);
+		if (GetStreamType() == Type::WriteOnly)
+			throw Exception(u8"Error occured when reading stream : Cannot_Read_WriteOnly_Stream");
+		if (target->GetStreamType() == Type::ReadOnly)
+			throw Exception(u8"Error occured when writing stream : Cannot_Write_ReadOnly_Stream");
+		if (fd < 0 || target->fd < 0)
+			throw Exception("Stream Closed");
+
+		auto copied = KernelCopy(fd, target->fd, len);
+		if (copied < len)
+			Stream::CopyTo(dst, len - copied);
+#endif
+	}
+	void FileStream::ReadAt(uint64_t offset, size_t len, void* data)
+	{
+		if (GetStreamType() == Type::WriteOnly)
+			throw Exception(u8"Error occured when reading stream : Cannot_Read_WriteOnly_Stream");
+
+#ifdef _WIN32
+		// FILE* 只有一个共享的读写指针，需要加锁并在读取后恢复原来的位置
+		std::lock_guard<std::mutex> lock(positionalLock);
+		auto fp = reinterpret_cast<FILE*>(handle);
+		if (fp == nullptr)
+			throw Exception("Stream Closed");
+		auto currentPos = _ftelli64(fp);
+		_fseeki64(fp, static_cast<long long>(offset), SEEK_SET);
+		auto readLen = fread(data, 1, len, fp);
+		_fseeki64(fp, currentPos, SEEK_SET);
+		if (readLen != len)
+			throw Exception(u8"Error occured when reading stream : End_Of_Stream");
+#else
+		if (fd < 0)
+			throw Exception("Stream Closed");
+		if (ReadFully(fd, len, data, static_cast<int64_t>(offset)) != len)
+			throw Exception(u8"Error occured when reading stream : End_Of_Stream");
+#endif
+	}
+	void FileStream::WriteAt(uint64_t offset, size_t len, const void* data)
+	{
+		if (GetStreamType() == Type::ReadOnly)
+			throw Exception(u8"Error occured when reading stream : Cannot_Write_ReadOnly_Stream");
+
+#ifdef _WIN32
+		std::lock_guard<std::mutex> lock(positionalLock);
+		auto fp = reinterpret_cast<FILE*>(handle);
+		if (fp == nullptr)
+			throw Exception("Stream Closed");
+		auto currentPos = _ftelli64(fp);
+		_fseeki64(fp, static_cast<long long>(offset), SEEK_SET);
+		auto writeLen = fwrite(data, 1, len, fp);
+		_fseeki64(fp, currentPos, SEEK_SET);
+		if (writeLen != len)
+			throw Exception(u8"Error occured when writing stream : Write_Failed");
+#else
+		if (fd < 0)
+			throw Exception("Stream Closed");
+		WriteFully(fd, len, data, static_cast<int64_t>(offset));
+#endif
 	}
 	void FileStream::Close()
 	{
+#ifdef _WIN32
+		std::lock_guard<std::mutex> lock(positionalLock);
 		auto fp = reinterpret_cast<FILE*>(handle);
 		if (fp != nullptr)
 			fclose(fp);
+		// 避免析构函数再次关闭同一个文件
+		handle = nullptr;
+#else
+		if (fd >= 0)
+			::close(fd);
+		fd = -1;
+#endif
 	}
 	bool FileStream::IsVaild()
 	{
+#ifdef _WIN32
 		auto fp = reinterpret_cast<FILE*>(handle);
 		return fp != nullptr;
+#else
+		return fd >= 0;
+#endif
 	}
 	uint64_t FileStream::GetLength()
 	{
+#ifdef _WIN32
+		std::lock_guard<std::mutex> lock(positionalLock);
 		auto fp = reinterpret_cast<FILE*>(handle);
 		if (fp != nullptr)
 		{
@@ -97,9 +473,19 @@ namespace Utilities
 		}
 		else
 			throw Exception("Stream Closed");
+#else
+		if (fd < 0)
+			throw Exception("Stream Closed");
+		struct stat st;
+		if (fstat(fd, &st) != 0)
+			_private::ThrowSystemError(u8"Error occured when seeking file :");
+		return static_cast<uint64_t>(st.st_size);
+#endif
 	}
 	uint64_t FileStream::GetPosition()
 	{
+#ifdef _WIN32
+		std::lock_guard<std::mutex> lock(positionalLock);
 		auto fp = reinterpret_cast<FILE*>(handle);
 		if (fp != nullptr)
 		{
@@ -107,9 +493,19 @@ namespace Utilities
 		}
 		else
 			throw Exception("Stream Closed");
+#else
+		if (fd < 0)
+			throw Exception("Stream Closed");
+		auto pos = lseek(fd, 0, SEEK_CUR);
+		if (pos < 0)
+			_private::ThrowSystemError(u8"Error occured when seeking file :");
+		return static_cast<uint64_t>(pos);
+#endif
 	}
 	void FileStream::SetPosition(uint64_t pos)
 	{
+#ifdef _WIN32
+		std::lock_guard<std::mutex> lock(positionalLock);
 		auto fp = reinterpret_cast<FILE*>(handle);
 		if (fp != nullptr)
 		{
@@ -118,9 +514,17 @@ namespace Utilities
 		}
 		else
 			throw Exception("Stream Closed");
+#else
+		if (fd < 0)
+			throw Exception("Stream Closed");
+		if (lseek(fd, static_cast<off_t>(pos), SEEK_SET) < 0)
+			_private::ThrowSystemError(u8"Error occured when seeking file :");
+#endif
 	}
 	void FileStream::Seek(int64_t offset)
 	{
+#ifdef _WIN32
+		std::lock_guard<std::mutex> lock(positionalLock);
 		auto fp = reinterpret_cast<FILE*>(handle);
 		if (fp != nullptr)
 		{
@@ -129,9 +533,102 @@ namespace Utilities
 		}
 		else
 			throw Exception("Stream Closed");
+#else
+		if (fd < 0)
+			throw Exception("Stream Closed");
+		if (lseek(fd, static_cast<off_t>(offset), SEEK_CUR) < 0)
+			_private::ThrowSystemError(u8"Error occured when seeking file :");
+#endif
+	}
+	void FileStream::Advise(AccessHint hint, uint64_t offset, uint64_t len)
+	{
+		if (!IsVaild())
+			throw Exception("Stream Closed");
+		if (hint == AccessHint::WillNeed)
+		{
+			Prefetch(offset, len);
+			return;
+		}
+#if defined(_WIN32)
+		// 访问方式只能在打开文件时通过 CreateFile 的标志指定
+		(void)offset;
+		(void)len;
+#elif defined(POSIX_FADV_NORMAL)
+		int advice = POSIX_FADV_NORMAL;
+		switch (hint)
+		{
+		case AccessHint::Sequential: advice = POSIX_FADV_SEQUENTIAL; break;
+		case AccessHint::Random: advice = POSIX_FADV_RANDOM; break;
+		case AccessHint::DontNeed: advice = POSIX_FADV_DONTNEED; break;
+		default: break;
+		}
+		auto limit = static_cast<uint64_t>(INT64_MAX);
+		auto err = posix_fadvise(fd, static_cast<off_t>(offset < limit ? offset : limit), static_cast<off_t>(len < limit ? len : limit), advice);
+		// 管道等不支持提示的文件忽略
+		if (err != 0 && err != ESPIPE && err != EINVAL && err != ENOSYS)
+			_private::ThrowSystemError(u8"Error occured when advising file :", err);
+#elif defined(__APPLE__)
+		(void)offset;
+		(void)len;
+		// macOS 只能整体打开或关闭预读
+		if (hint != AccessHint::DontNeed)
+			fcntl(fd, F_RDAHEAD, hint == AccessHint::Random ? 0 : 1);
+#else
+		(void)offset;
+		(void)len;
+#endif
+	}
+	void FileStream::Prefetch(uint64_t offset, uint64_t len)
+	{
+		if (!IsVaild())
+			throw Exception("Stream Closed");
+#if defined(_WIN32)
+		(void)offset;
+		(void)len;
+#elif defined(POSIX_FADV_WILLNEED)
+		// 内核发起预读后立即返回，不等待数据读入
+		auto limit = static_cast<uint64_t>(INT64_MAX);
+		auto err = posix_fadvise(fd, static_cast<off_t>(offset < limit ? offset : limit), static_cast<off_t>(len < limit ? len : limit), POSIX_FADV_WILLNEED);
+		if (err != 0 && err != ESPIPE && err != EINVAL && err != ENOSYS)
+			_private::ThrowSystemError(u8"Error occured when advising file :", err);
+#elif defined(__APPLE__)
+		radvisory advisory;
+		advisory.ra_offset = static_cast<off_t>(offset);
+		advisory.ra_count = len == 0 || len > INT_MAX ? INT_MAX : static_cast<int>(len);
+		fcntl(fd, F_RDADVISE, &advisory);
+#else
+		(void)offset;
+		(void)len;
+#endif
 	}
+
 	Handle FileStream::GetHandle()
 	{
+#ifdef _WIN32
 		return handle;
+#else
+		if (fd < 0)
+			return nullptr;
+		return reinterpret_cast<Handle>(static_cast<intptr_t>(fd));
+#endif
+	}
+	int FileStream::GetDescriptor()
+	{
+#ifdef _WIN32
+		std::lock_guard<std::mutex> lock(positionalLock);
+		auto fp = reinterpret_cast<FILE*>(handle);
+		return fp != nullptr ? _fileno(fp) : -1;
+#else
+		return fd;
+#endif
+	}
+#ifdef _WIN32
+	void FileStream::SwitchDirection(bool isWrite)
+	{
+		// C 标准要求读写切换之间必须调用一次定位函数
+		if (GetStreamType() == Type::ReadWrite && lastWasWrite != isWrite)
+			_fseeki64(reinterpret_cast<FILE*>(handle), 0, SEEK_CUR);
+		lastWasWrite = isWrite;
 	}
-}
\ No newline at end of file
+#endif
+}
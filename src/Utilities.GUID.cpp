@@ -12,28 +12,10 @@
 
 
 #include "Utilities.GUID.h"
+#include "Utilities.Common.Endian.h"
+#include "Utilities.Common.Format.h"
 #include <random>
 #include <chrono>
-#include <sstream>
-#include <iomanip>
-/// <summary>
-/// 大小端转换函数
-/// <para>
-/// GUID对象的存储模式涉及到大小端转换，在这里设计一个函数进行处理
-/// </para>
-/// </summary>
-template<typename T>
-T BELEConvert(const T& value)
-{
-	T result = 0;
-	const uint8_t* ptr = (const uint8_t*)&value;
-	uint8_t * rptr = (uint8_t*)&result;
-	for (int i = 0; i < sizeof(T); i++)
-	{
-		rptr[sizeof(T) - 1 - i] = ptr[i];
-	}
-	return result;
-}
 
 namespace Utilities
 {
@@ -56,7 +38,7 @@ namespace Utilities
 		ptr[7] &= 0x0F;//版本号
 		ptr[7] |= 0x40;
 
-		temp.datas.data4 = BELEConvert(temp.datas.data4);
+		temp.datas.data4 = Common::ByteSwap(temp.datas.data4);
 		return temp;
 	}
 
@@ -106,9 +88,9 @@ namespace Utilities
 				throw std::exception("inv input");
 			}
 		}
-		datas.data1 = BELEConvert(datas.data1);
-		datas.data2 = BELEConvert(datas.data2);
-		datas.data3 = BELEConvert(datas.data3);
+		datas.data1 = Common::ByteSwap(datas.data1);
+		datas.data2 = Common::ByteSwap(datas.data2);
+		datas.data3 = Common::ByteSwap(datas.data3);
 		return;
 	}
 	GUID::GUID(const char * rhs) : GUID(std::string(rhs))
@@ -157,9 +139,9 @@ namespace Utilities
 				throw std::exception("inv input");
 			}
 		}
-		datas.data1 = BELEConvert(datas.data1);
-		datas.data2 = BELEConvert(datas.data2);
-		datas.data3 = BELEConvert(datas.data3);
+		datas.data1 = Common::ByteSwap(datas.data1);
+		datas.data2 = Common::ByteSwap(datas.data2);
+		datas.data3 = Common::ByteSwap(datas.data3);
 		return *this;
 	}
 
@@ -191,20 +173,20 @@ namespace Utilities
 
 	GUID::operator std::string() const
 	{
-		std::ostringstream result;
-		result << std::hex << std::setfill('0') << std::setw(8) << datas.data1;
-		result << '-';
-		result << std::hex << std::setfill('0') << std::setw(4) << datas.data2;
-		result << '-';
-		result << std::hex << std::setfill('0') << std::setw(4) << datas.data3;
-		result << '-';
+		char result[36];
+		auto p = Common::FormatHex(result, datas.data1, 8);
+		*p++ = '-';
+		p = Common::FormatHex(p, datas.data2, 4);
+		*p++ = '-';
+		p = Common::FormatHex(p, datas.data3, 4);
+		*p++ = '-';
 		auto ptr = (uint8_t*)&datas;
 		for (int i = 8; i < 10; i++)
-			result << std::hex << std::setfill('0') << std::setw(2) << (int)ptr[i];//不强转int会被当成字符输出
-		result << '-';
+			p = Common::FormatHex(p, ptr[i], 2);
+		*p++ = '-';
 		for (int i = 10; i < 16; i++)
-			result << std::hex << std::setfill('0') << std::setw(2) << (int)ptr[i];
-		return result.str();
+			p = Common::FormatHex(p, ptr[i], 2);
+		return std::string(result, p);
 	}
 	std::string GUID::ToString() const
 	{
@@ -0,0 +1,229 @@
+/**
+ @file
+ @brief 通用IO库 统计流实现
+
+ @author 司马坑
+ @date 2026/10/17
+*/
+#include "Utilities.InstrumentedStream.h"
+#include "Utilities.StreamWriter.h"
+#include "Utilities.Simd.h"
+
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+#include <vector>
+
+namespace Utilities
+{
+	namespace
+	{
+		/// <summary>
+		/// 所有存活的统计流
+		/// </summary>
+		struct Registry
+		{
+			std::mutex mutex;
+			std::vector<const InstrumentedStream*> streams;
+		};
+		Registry& GetRegistry()
+		{
+			static Registry registry;
+			return registry;
+		}
+
+		uint64_t Now()
+		{
+			return std::chrono::duration_cast<std::chrono::nanoseconds>(
+				std::chrono::steady_clock::now().time_since_epoch()).count();
+		}
+
+		const char* const OperationNames[InstrumentedStream::OperationCount] = { "read", "write", "seek", "flush" };
+	}
+
+	uint64_t InstrumentedStream::Statistics::Percentile(double ratio) const
+	{
+		if (calls == 0)
+			return 0;
+		auto target = static_cast<uint64_t>(ratio * calls);
+		if (target == 0)
+			target = 1;
+		uint64_t count = 0;
+		for (size_t i = 0; i < LatencyBucketCount; i++)
+		{
+			count += latency[i];
+			if (count >= target)
+				return uint64_t(2) << i;
+		}
+		return uint64_t(2) << (LatencyBucketCount - 1);
+	}
+
+	InstrumentedStream::InstrumentedStream(Stream& stream, std::string name)
+		: Stream(stream.GetStreamType()), stream(stream), name(std::move(name))
+	{
+		auto& registry = GetRegistry();
+		std::lock_guard<std::mutex> lock(registry.mutex);
+		registry.streams.push_back(this);
+	}
+	InstrumentedStream::~InstrumentedStream()
+	{
+		auto& registry = GetRegistry();
+		std::lock_guard<std::mutex> lock(registry.mutex);
+		registry.streams.erase(std::find(registry.streams.begin(), registry.streams.end(), this));
+	}
+
+	void InstrumentedStream::Read(size_t len, void* data)
+	{
+		auto start = Now();
+		stream.Read(len, data);
+		Record(Operation::Read, len, start);
+	}
+	void InstrumentedStream::Write(size_t len, const void* data)
+	{
+		auto start = Now();
+		stream.Write(len, data);
+		Record(Operation::Write, len, start);
+	}
+	void InstrumentedStream::Close()
+	{
+		stream.Close();
+	}
+	bool InstrumentedStream::IsVaild()
+	{
+		return stream.IsVaild();
+	}
+	size_t InstrumentedStream::ReadSome(size_t maxLen, void* data)
+	{
+		auto start = Now();
+		auto len = stream.ReadSome(maxLen, data);
+		Record(Operation::Read, len, start);
+		return len;
+	}
+	void InstrumentedStream::ReadV(size_t count, const Segment* segments)
+	{
+		auto start = Now();
+		stream.ReadV(count, segments);
+		uint64_t len = 0;
+		for (size_t i = 0; i < count; i++)
+			len += segments[i].len;
+		Record(Operation::Read, len, start);
+	}
+	void InstrumentedStream::WriteV(size_t count, const ConstSegment* segments)
+	{
+		auto start = Now();
+		stream.WriteV(count, segments);
+		uint64_t len = 0;
+		for (size_t i = 0; i < count; i++)
+			len += segments[i].len;
+		Record(Operation::Write, len, start);
+	}
+	void InstrumentedStream::Flush()
+	{
+		auto start = Now();
+		stream.Flush();
+		Record(Operation::Flush, 0, start);
+	}
+	void InstrumentedStream::ReadAt(uint64_t offset, size_t len, void* data)
+	{
+		auto start = Now();
+		stream.ReadAt(offset, len, data);
+		Record(Operation::Read, len, start);
+	}
+	void InstrumentedStream::WriteAt(uint64_t offset, size_t len, const void* data)
+	{
+		auto start = Now();
+		stream.WriteAt(offset, len, data);
+		Record(Operation::Write, len, start);
+	}
+
+	uint64_t InstrumentedStream::GetLength()
+	{
+		return stream.GetLength();
+	}
+	uint64_t InstrumentedStream::GetPosition()
+	{
+		return stream.GetPosition();
+	}
+	void InstrumentedStream::SetPosition(uint64_t pos)
+	{
+		auto start = Now();
+		stream.SetPosition(pos);
+		Record(Operation::Seek, 0, start);
+	}
+	void InstrumentedStream::Seek(int64_t offset)
+	{
+		auto start = Now();
+		stream.Seek(offset);
+		Record(Operation::Seek, 0, start);
+	}
+
+	void InstrumentedStream::Record(Operation operation, uint64_t bytes, uint64_t start)
+	{
+		auto elapsed = Now() - start;
+		size_t bucket = elapsed < 2 ? 0 : Utilities::_private::FloorLog2(elapsed);
+		if (bucket >= LatencyBucketCount)
+			bucket = LatencyBucketCount - 1;
+		auto& c = counters[static_cast<size_t>(operation)];
+		c.calls.fetch_add(1, std::memory_order_relaxed);
+		c.bytes.fetch_add(bytes, std::memory_order_relaxed);
+		c.nanoseconds.fetch_add(elapsed, std::memory_order_relaxed);
+		c.latency[bucket].fetch_add(1, std::memory_order_relaxed);
+	}
+
+	InstrumentedStream::Statistics InstrumentedStream::GetStatistics(Operation operation) const
+	{
+		auto& c = counters[static_cast<size_t>(operation)];
+		Statistics statistics;
+		statistics.calls = c.calls.load(std::memory_order_relaxed);
+		statistics.bytes = c.bytes.load(std::memory_order_relaxed);
+		statistics.nanoseconds = c.nanoseconds.load(std::memory_order_relaxed);
+		for (size_t i = 0; i < LatencyBucketCount; i++)
+			statistics.latency[i] = c.latency[i].load(std::memory_order_relaxed);
+		return statistics;
+	}
+	void InstrumentedStream::ResetStatistics()
+	{
+		for (auto& c : counters)
+		{
+			c.calls.store(0, std::memory_order_relaxed);
+			c.bytes.store(0, std::memory_order_relaxed);
+			c.nanoseconds.store(0, std::memory_order_relaxed);
+			for (auto& bucket : c.latency)
+				bucket.store(0, std::memory_order_relaxed);
+		}
+	}
+
+	void InstrumentedStream::Dump(Stream& output) const
+	{
+		auto sw = StreamWriter(output);
+		sw.Format("stream \"{}\"\n", name);
+		for (size_t op = 0; op < OperationCount; op++)
+		{
+			auto s = GetStatistics(static_cast<Operation>(op));
+			if (s.calls == 0)
+				continue;
+			sw.Format("  {} calls={} bytes={} avg_bytes={} total_us={} p50_ns<={} p99_ns<={}\n",
+				OperationNames[op], s.calls, s.bytes, s.bytes / s.calls, s.nanoseconds / 1000,
+				s.Percentile(0.5), s.Percentile(0.99));
+			// 只输出非空的桶，[a,b) 为耗时范围(纳秒)
+			sw.Format("    latency_ns");
+			for (size_t i = 0; i < LatencyBucketCount; i++)
+			{
+				if (s.latency[i] == 0)
+					continue;
+				if (i + 1 == LatencyBucketCount)
+					sw.Format(" [{},):{}", uint64_t(1) << i, s.latency[i]);
+				else
+					sw.Format(" [{},{}):{}", i == 0 ? 0 : uint64_t(1) << i, uint64_t(2) << i, s.latency[i]);
+			}
+			sw.Format("\n");
+		}
+	}
+	void InstrumentedStream::DumpAll(Stream& output)
+	{
+		auto& registry = GetRegistry();
+		std::lock_guard<std::mutex> lock(registry.mutex);
+		for (auto stream : registry.streams)
+			stream->Dump(output);
+	}
+}
@@ -0,0 +1,229 @@
+/**
+ @file
+ @brief 通用IO库 内存映射文件流实现
+
+ @author 司马坑
+ @date 2026/10/17
+*/
+#include "Utilities.MappedFileStream.h"
+#include "Utilities.Platform.h"
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+namespace Utilities
+{
+	MappedFileStream::MappedFileStream(const wchar_t* fileName) : Stream(Type::ReadOnly)
+	{
+#ifdef _WIN32
+		auto file = CreateFileW(fileName, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (file == INVALID_HANDLE_VALUE)
+			throw Exception(u8"Error occured when opening file : Cannot_Open_File");
+
+		LARGE_INTEGER size;
+		if (!GetFileSizeEx(file, &size))
+		{
+			CloseHandle(file);
+			throw Exception(u8"Error occured when opening file : Cannot_Get_File_Size");
+		}
+		length = static_cast<uint64_t>(size.QuadPart);
+
+		// 长度为 0 的文件无法被映射
+		if (length != 0)
+		{
+			auto mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+			if (mapping != nullptr)
+			{
+				mapped = static_cast<const uint8*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+				// 视图会持有对映射对象的引用
+				CloseHandle(mapping);
+			}
+			if (mapped == nullptr)
+			{
+				CloseHandle(file);
+				throw Exception(u8"Error occured when mapping file : Cannot_Map_File");
+			}
+		}
+		CloseHandle(file);
+#else
+		auto path = _private::NarrowPath(fileName);
+		auto fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+		if (fd < 0)
+			_private::ThrowSystemError(u8"Error occured when opening file :");
+
+		struct stat st;
+		if (fstat(fd, &st) != 0)
+		{
+			auto err = errno;
+			::close(fd);
+			_private::ThrowSystemError(u8"Error occured when opening file :", err);
+		}
+		length = static_cast<uint64_t>(st.st_size);
+
+		// 长度为 0 的文件无法被映射
+		if (length != 0)
+		{
+			auto addr = mmap(nullptr, static_cast<size_t>(length), PROT_READ, MAP_PRIVATE, fd, 0);
+			if (addr == MAP_FAILED)
+			{
+				auto err = errno;
+				::close(fd);
+				_private::ThrowSystemError(u8"Error occured when mapping file :", err);
+			}
+			mapped = static_cast<const uint8*>(addr);
+		}
+		// 映射区域在文件描述符关闭后依然有效
+		::close(fd);
+#endif
+	}
+	MappedFileStream::~MappedFileStream()
+	{
+		Close();
+	}
+	void MappedFileStream::ReadSlow(size_t len)
+	{
+		if (closed)
+			throw Exception("Stream Closed");
+		if (len == 0)
+			return;
+		throw Exception(u8"Error occured when reading stream : End_Of_Stream");
+	}
+	void MappedFileStream::Write(size_t, const void*)
+	{
+		throw Exception(u8"Error occured when reading stream : Cannot_Write_ReadOnly_Stream");
+	}
+	void MappedFileStream::Close()
+	{
+		if (mapped != nullptr)
+		{
+#ifdef _WIN32
+			UnmapViewOfFile(mapped);
+#else
+			munmap(const_cast<uint8*>(mapped), static_cast<size_t>(length));
+#endif
+		}
+		mapped = nullptr;
+		length = 0;
+		position = 0;
+		closed = true;
+	}
+	bool MappedFileStream::IsVaild()
+	{
+		return !closed;
+	}
+	size_t MappedFileStream::ReadSome(size_t maxLen, void* data)
+	{
+		if (closed)
+			throw Exception("Stream Closed");
+		if (position >= length)
+			return 0;
+
+		auto len = length - position < maxLen ? static_cast<size_t>(length - position) : maxLen;
+		memcpy(data, mapped + position, len);
+		position += len;
+		return len;
+	}
+	void MappedFileStream::CopyTo(Stream& dst, uint64_t len)
+	{
+		if (closed)
+			throw Exception("Stream Closed");
+
+		auto available = position < length ? length - position : 0;
+		auto copyLen = len < available ? len : available;
+		dst.Write(static_cast<size_t>(copyLen), mapped + position);
+		position += copyLen;
+		if (copyLen != len)
+			throw Exception(u8"Error occured when reading stream : End_Of_Stream");
+	}
+	void MappedFileStream::ReadAt(uint64_t offset, size_t len, void* data)
+	{
+		if (closed)
+			throw Exception("Stream Closed");
+		if (offset > length || len > length - offset)
+			throw Exception(u8"Error occured when reading stream : End_Of_Stream");
+		if (len != 0)
+			memcpy(data, mapped + offset, len);
+	}
+	uint64_t MappedFileStream::GetLength()
+	{
+		if (closed)
+			throw Exception("Stream Closed");
+		return length;
+	}
+	uint64_t MappedFileStream::GetPosition()
+	{
+		if (closed)
+			throw Exception("Stream Closed");
+		return position;
+	}
+	void MappedFileStream::SetPosition(uint64_t pos)
+	{
+		if (closed)
+			throw Exception("Stream Closed");
+		if (pos > length)
+			throw Exception(u8"Error occured when seeking stream : Position_Out_Of_Range");
+		position = pos;
+	}
+	void MappedFileStream::Seek(int64_t offset)
+	{
+		if (closed)
+			throw Exception("Stream Closed");
+		if (offset < 0 && static_cast<uint64_t>(-offset) > position)
+			throw Exception(u8"Error occured when seeking stream : Position_Out_Of_Range");
+		SetPosition(position + offset);
+	}
+	Common::Span<const uint8> MappedFileStream::View() const
+	{
+		return Common::Span<const uint8>(mapped, static_cast<size_t>(length));
+	}
+	Common::Span<const uint8> MappedFileStream::ReadView(size_t len)
+	{
+		if (closed)
+			throw Exception("Stream Closed");
+		if (len > length - position)
+			throw Exception(u8"Error occured when reading stream : End_Of_Stream");
+		auto view = Common::Span<const uint8>(mapped + position, len);
+		position += len;
+		return view;
+	}
+	void MappedFileStream::Advise(AccessHint hint, uint64_t offset, uint64_t len)
+	{
+		if (closed)
+			throw Exception("Stream Closed");
+		if (offset >= length)
+			return;
+		if (len == 0 || len > length - offset)
+			len = length - offset;
+#ifdef _WIN32
+		if (hint == AccessHint::WillNeed)
+		{
+			WIN32_MEMORY_RANGE_ENTRY range;
+			range.VirtualAddress = const_cast<uint8*>(mapped + offset);
+			range.NumberOfBytes = static_cast<SIZE_T>(len);
+			// 只是建议，失败时忽略
+			PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+		}
+#else
+		int advice = MADV_NORMAL;
+		switch (hint)
+		{
+		case AccessHint::Sequential: advice = MADV_SEQUENTIAL; break;
+		case AccessHint::Random: advice = MADV_RANDOM; break;
+		case AccessHint::WillNeed: advice = MADV_WILLNEED; break;
+		case AccessHint::DontNeed: advice = MADV_DONTNEED; break;
+		default: break;
+		}
+		// madvise 要求起始地址按页对齐，映射的起始地址本身是对齐的
+		static const auto pageSize = static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+		auto begin = offset / pageSize * pageSize;
+		if (madvise(const_cast<uint8*>(mapped + begin), static_cast<size_t>(offset + len - begin), advice) != 0)
+			_private::ThrowSystemError(u8"Error occured when advising mapped file :");
+#endif
+	}
+}
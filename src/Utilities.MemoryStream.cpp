@@ -0,0 +1,217 @@
+/**
+ @file
+ @brief 通用IO库 内存流实现
+
+ @author 司马坑
+ @date 2026/10/17
+*/
+#include "Utilities.MemoryStream.h"
+
+#include <cstring>
+#include <cstdlib>
+
+namespace Utilities
+{
+	//! 缓冲区第一次分配时的最小容量
+	constexpr size_t MinimumCapacity = 64;
+
+	MemoryStream::MemoryStream(size_t initialCapacity) : Stream(Type::ReadWrite)
+	{
+		if (initialCapacity != 0)
+			Reserve(initialCapacity);
+	}
+	MemoryStream::MemoryStream(Common::Span<uint8> arena) : Stream(Type::ReadWrite)
+	{
+		this->buffer = arena.data();
+		this->capacity = arena.size();
+	}
+	MemoryStream::MemoryStream(const void* data, size_t length) : Stream(Type::ReadOnly)
+	{
+		// 只读流不会写入该缓冲区
+		this->buffer = static_cast<uint8*>(const_cast<void*>(data));
+		this->capacity = length;
+		this->length = length;
+	}
+	MemoryStream::MemoryStream(MemoryStream&& rhs) noexcept :
+		Stream(std::move(rhs)),
+		buffer(rhs.buffer), capacity(rhs.capacity), length(rhs.length), position(rhs.position),
+		ownsBuffer(rhs.ownsBuffer), closed(rhs.closed)
+	{
+		rhs.buffer = nullptr;
+		rhs.capacity = 0;
+		rhs.length = 0;
+		rhs.position = 0;
+		rhs.ownsBuffer = false;
+		rhs.closed = true;
+	}
+	MemoryStream::~MemoryStream()
+	{
+		if (ownsBuffer)
+			free(buffer);
+	}
+	void MemoryStream::Read(size_t len, void* data)
+	{
+		if (GetStreamType() == Type::WriteOnly)
+			throw Exception(u8"Error occured when reading stream : Cannot_Read_WriteOnly_Stream");
+		if (closed)
+			throw Exception("Stream Closed");
+		if (position > length || len > length - position)
+			throw Exception(u8"Error occured when reading stream : End_Of_Stream");
+
+		memcpy(data, buffer + position, len);
+		position += len;
+	}
+	void MemoryStream::Write(size_t len, const void* data)
+	{
+		if (GetStreamType() == Type::ReadOnly)
+			throw Exception(u8"Error occured when reading stream : Cannot_Write_ReadOnly_Stream");
+		if (closed)
+			throw Exception("Stream Closed");
+
+		auto end = position + len;
+		if (end < position)
+			throw Exception(u8"Error occured when writing stream : Length_Overflow");
+		if (end > capacity)
+			Grow(end);
+		// 读写指针曾被移动到数据末尾之后
+		if (position > length)
+			memset(buffer + length, 0, position - length);
+
+		memcpy(buffer + position, data, len);
+		position = end;
+		if (end > length)
+			length = end;
+	}
+	void MemoryStream::Close()
+	{
+		if (ownsBuffer)
+			free(buffer);
+		buffer = nullptr;
+		capacity = 0;
+		length = 0;
+		position = 0;
+		ownsBuffer = false;
+		closed = true;
+	}
+	bool MemoryStream::IsVaild()
+	{
+		return !closed;
+	}
+	size_t MemoryStream::ReadSome(size_t maxLen, void* data)
+	{
+		if (GetStreamType() == Type::WriteOnly)
+			throw Exception(u8"Error occured when reading stream : Cannot_Read_WriteOnly_Stream");
+		if (closed)
+			throw Exception("Stream Closed");
+		if (position >= length)
+			return 0;
+
+		auto len = length - position < maxLen ? length - position : maxLen;
+		memcpy(data, buffer + position, len);
+		position += len;
+		return len;
+	}
+	void MemoryStream::CopyTo(Stream& dst, uint64_t len)
+	{
+		// 写入自身可能导致缓冲区重新分配
+		if (&dst == this)
+			return Stream::CopyTo(dst, len);
+		if (GetStreamType() == Type::WriteOnly)
+			throw Exception(u8"Error occured when reading stream : Cannot_Read_WriteOnly_Stream");
+		if (closed)
+			throw Exception("Stream Closed");
+
+		auto available = position < length ? length - position : 0;
+		auto copyLen = len < available ? static_cast<size_t>(len) : available;
+		dst.Write(copyLen, buffer + position);
+		position += copyLen;
+		if (copyLen != len)
+			throw Exception(u8"Error occured when reading stream : End_Of_Stream");
+	}
+	void MemoryStream::ReadAt(uint64_t offset, size_t len, void* data)
+	{
+		if (GetStreamType() == Type::WriteOnly)
+			throw Exception(u8"Error occured when reading stream : Cannot_Read_WriteOnly_Stream");
+		if (closed)
+			throw Exception("Stream Closed");
+		if (offset > length || len > length - offset)
+			throw Exception(u8"Error occured when reading stream : End_Of_Stream");
+		if (len != 0)
+			memcpy(data, buffer + offset, len);
+	}
+	uint64_t MemoryStream::GetLength()
+	{
+		if (closed)
+			throw Exception("Stream Closed");
+		return length;
+	}
+	uint64_t MemoryStream::GetPosition()
+	{
+		if (closed)
+			throw Exception("Stream Closed");
+		return position;
+	}
+	void MemoryStream::SetPosition(uint64_t pos)
+	{
+		if (closed)
+			throw Exception("Stream Closed");
+		if (pos > SIZE_MAX)
+			throw Exception(u8"Error occured when seeking stream : Position_Out_Of_Range");
+		position = static_cast<size_t>(pos);
+	}
+	void MemoryStream::Seek(int64_t offset)
+	{
+		if (closed)
+			throw Exception("Stream Closed");
+		if (offset < 0 && static_cast<uint64_t>(-offset) > position)
+			throw Exception(u8"Error occured when seeking stream : Position_Out_Of_Range");
+		SetPosition(position + offset);
+	}
+	Common::Span<const uint8> MemoryStream::View() const
+	{
+		return Common::Span<const uint8>(buffer, length);
+	}
+	size_t MemoryStream::GetCapacity() const
+	{
+		return capacity;
+	}
+	void MemoryStream::Reserve(size_t required)
+	{
+		if (GetStreamType() == Type::ReadOnly)
+			throw Exception(u8"Error occured when reading stream : Cannot_Write_ReadOnly_Stream");
+		if (required <= capacity)
+			return;
+
+		uint8* newBuffer = nullptr;
+		if (ownsBuffer)
+			newBuffer = static_cast<uint8*>(realloc(buffer, required));
+		else
+		{
+			// 外部缓冲区不能被 realloc，需要迁移到自己的内存中
+			newBuffer = static_cast<uint8*>(malloc(required));
+			if (newBuffer != nullptr && length != 0)
+				memcpy(newBuffer, buffer, length);
+		}
+		if (newBuffer == nullptr)
+			throw Exception(u8"Error occured when writing stream : Out_Of_Memory");
+
+		buffer = newBuffer;
+		capacity = required;
+		ownsBuffer = true;
+	}
+	void MemoryStream::Grow(size_t required)
+	{
+		// 按倍数增长以保证连续写入的均摊复杂度为 O(1)
+		auto newCapacity = capacity < MinimumCapacity ? MinimumCapacity : capacity;
+		while (newCapacity < required)
+		{
+			if (newCapacity > SIZE_MAX / 2)
+			{
+				newCapacity = required;
+				break;
+			}
+			newCapacity *= 2;
+		}
+		Reserve(newCapacity);
+	}
+}
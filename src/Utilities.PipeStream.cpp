@@ -0,0 +1,195 @@
+/**
+ @file
+ @brief 通用IO库 管道流实现
+
+ 休眠与唤醒：
+	- 等待方持有 waitLock 设置 xxxWaiting 标记，再次检查条件后才在条件变量上休眠
+	- 通知方发布新的索引后检查标记，只有对方确实在休眠时才获取 waitLock 通知
+	- 两侧都以 seq_cst 栅栏分隔“写索引/读标记”与“写标记/读索引”，不会丢失唤醒
+
+ @author 司马坑
+ @date 2026/10/17
+*/
+#include "Utilities.PipeStream.h"
+
+#include <cstring>
+#include <thread>
+
+namespace Utilities
+{
+	//! 休眠前自旋等待的次数
+	constexpr int SpinCount = 128;
+
+	PipeStream::PipeStream(size_t capacity) : Stream(Type::ReadWrite)
+	{
+		size_t size = CacheLineSize;
+		while (size < capacity)
+			size <<= 1;
+		this->capacity = size;
+		mask = size - 1;
+		buffer = new uint8[size];
+	}
+	PipeStream::~PipeStream()
+	{
+		delete[] buffer;
+	}
+
+	size_t PipeStream::TryWrite(size_t maxLen, const void* data)
+	{
+		if (closed.load(std::memory_order_acquire))
+			throw Exception("Stream Closed");
+
+		auto w = writeIndex.load(std::memory_order_relaxed);
+		auto free = capacity - (w - cachedReadIndex);
+		if (free < maxLen)
+		{
+			cachedReadIndex = readIndex.load(std::memory_order_acquire);
+			free = capacity - (w - cachedReadIndex);
+		}
+		auto len = free < maxLen ? free : maxLen;
+		if (len == 0)
+			return 0;
+
+		auto offset = w & mask;
+		auto first = capacity - offset < len ? capacity - offset : len;
+		memcpy(buffer + offset, data, first);
+		memcpy(buffer, static_cast<const uint8*>(data) + first, len - first);
+		writeIndex.store(w + len, std::memory_order_release);
+		WakeReader();
+		return len;
+	}
+	size_t PipeStream::TryRead(size_t maxLen, void* data)
+	{
+		auto r = readIndex.load(std::memory_order_relaxed);
+		auto available = cachedWriteIndex - r;
+		if (available < maxLen)
+		{
+			cachedWriteIndex = writeIndex.load(std::memory_order_acquire);
+			available = cachedWriteIndex - r;
+		}
+		auto len = available < maxLen ? available : maxLen;
+		if (len == 0)
+			return 0;
+
+		auto offset = r & mask;
+		auto first = capacity - offset < len ? capacity - offset : len;
+		memcpy(data, buffer + offset, first);
+		memcpy(static_cast<uint8*>(data) + first, buffer, len - first);
+		readIndex.store(r + len, std::memory_order_release);
+		WakeWriter();
+		return len;
+	}
+
+	void PipeStream::WakeReader()
+	{
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		if (readerWaiting.load(std::memory_order_relaxed))
+		{
+			std::lock_guard<std::mutex> lock(waitLock);
+			readable.notify_one();
+		}
+	}
+	void PipeStream::WakeWriter()
+	{
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		if (writerWaiting.load(std::memory_order_relaxed))
+		{
+			std::lock_guard<std::mutex> lock(waitLock);
+			writable.notify_one();
+		}
+	}
+	void PipeStream::WaitReadable()
+	{
+		auto ready = [this]()
+		{
+			return writeIndex.load(std::memory_order_acquire) != readIndex.load(std::memory_order_relaxed) || closed.load(std::memory_order_acquire);
+		};
+		for (int i = 0; i < SpinCount; i++)
+		{
+			if (ready())
+				return;
+			std::this_thread::yield();
+		}
+
+		std::unique_lock<std::mutex> lock(waitLock);
+		readerWaiting.store(true, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		readable.wait(lock, ready);
+		readerWaiting.store(false, std::memory_order_relaxed);
+	}
+	void PipeStream::WaitWritable()
+	{
+		auto ready = [this]()
+		{
+			return writeIndex.load(std::memory_order_relaxed) - readIndex.load(std::memory_order_acquire) != capacity || closed.load(std::memory_order_acquire);
+		};
+		for (int i = 0; i < SpinCount; i++)
+		{
+			if (ready())
+				return;
+			std::this_thread::yield();
+		}
+
+		std::unique_lock<std::mutex> lock(waitLock);
+		writerWaiting.store(true, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		writable.wait(lock, ready);
+		writerWaiting.store(false, std::memory_order_relaxed);
+	}
+
+	void PipeStream::Read(size_t len, void* data)
+	{
+		auto dst = static_cast<uint8*>(data);
+		while (len != 0)
+		{
+			auto n = ReadSome(len, dst);
+			if (n == 0)
+				throw Exception(u8"Error occured when reading stream : End_Of_Stream");
+			dst += n;
+			len -= n;
+		}
+	}
+	size_t PipeStream::ReadSome(size_t maxLen, void* data)
+	{
+		if (maxLen == 0)
+			return 0;
+		while (true)
+		{
+			auto n = TryRead(maxLen, data);
+			if (n != 0)
+				return n;
+			if (closed.load(std::memory_order_acquire))
+			{
+				// 关闭之前写入的数据仍然可以读出
+				return TryRead(maxLen, data);
+			}
+			WaitReadable();
+		}
+	}
+	void PipeStream::Write(size_t len, const void* data)
+	{
+		auto src = static_cast<const uint8*>(data);
+		while (len != 0)
+		{
+			auto n = TryWrite(len, src);
+			if (n == 0)
+			{
+				WaitWritable();
+				continue;
+			}
+			src += n;
+			len -= n;
+		}
+	}
+	void PipeStream::Close()
+	{
+		closed.store(true, std::memory_order_release);
+		std::lock_guard<std::mutex> lock(waitLock);
+		readable.notify_all();
+		writable.notify_all();
+	}
+	bool PipeStream::IsVaild()
+	{
+		return !closed.load(std::memory_order_acquire) || GetReadableLength() != 0;
+	}
+}
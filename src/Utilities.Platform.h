@@ -0,0 +1,45 @@
+/**
+ @file
+ @brief 通用IO库 平台相关的内部工具函数
+
+ 该文件仅供库内部的实现文件使用，不属于公开接口
+
+ @author 司马坑
+ @date 2026/10/17
+*/
+#pragma once
+#include <Utilities.h>
+
+#include <cstring>
+#include <cstdlib>
+#include <cerrno>
+
+namespace Utilities::_private
+{
+	/// <summary>
+	/// 将宽字符文件名转换为当前区域设置下的多字节文件名
+	/// <para>
+	/// POSIX 系统调用只接受 char 类型的路径
+	/// </para>
+	/// </summary>
+	inline u8string NarrowPath(const wchar_t* fileName)
+	{
+		auto len = wcstombs(nullptr, fileName, 0);
+		if (len == static_cast<size_t>(-1))
+			throw Exception(u8"Error occured when opening file : Invalid_File_Name");
+		u8string path(len, '\0');
+		wcstombs(path.data(), fileName, len + 1);
+		return path;
+	}
+
+	/// <summary>
+	/// 以 errno 的描述构造一个异常并抛出
+	/// </summary>
+	/// <param name="what">出错时正在进行的操作</param>
+	/// <param name="err">错误码</param>
+	[[noreturn]] inline void ThrowSystemError(const char* what, int err = errno)
+	{
+		auto errInfo = u8string(what) + strerror(err);
+		throw Exception(errInfo.data());
+	}
+}
@@ -0,0 +1,366 @@
+/**
+ @file
+ @brief 通用IO库 记录日志格式实现
+
+ @author 司马坑
+ @date 2026/10/17
+*/
+#include "Utilities.RecordLog.h"
+#include "Utilities.Common.Endian.h"
+#include "Utilities.Common.Scan.h"
+#include "Utilities.Encryption.CRC32.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+namespace Utilities
+{
+	namespace
+	{
+		constexpr uint32_t SyncMarkerTag = 0xFFFFFFFF;
+		constexpr uint8_t SyncMagic[8] = { 0xE1, 0x5F, 0x52, 0x45, 0x43, 0x53, 0x59, 0x4E };
+		//! 负载不超过该长度时与帧头合并为一次写入
+		constexpr size_t CoalesceLength = 64 * 1024;
+		//! 恢复扫描每次读取的窗口大小
+		constexpr size_t ScanWindow = 1024 * 1024;
+
+		uint32_t LoadLE32(const uint8_t* p)
+		{
+			uint32_t value;
+			memcpy(&value, p, sizeof(value));
+			return Common::ConvertEndian<Common::Endian::Little>(value);
+		}
+		uint64_t LoadLE64(const uint8_t* p)
+		{
+			uint64_t value;
+			memcpy(&value, p, sizeof(value));
+			return Common::ConvertEndian<Common::Endian::Little>(value);
+		}
+		void StoreLE32(uint8_t* p, uint32_t value)
+		{
+			value = Common::ConvertEndian<Common::Endian::Little>(value);
+			memcpy(p, &value, sizeof(value));
+		}
+		void StoreLE64(uint8_t* p, uint64_t value)
+		{
+			value = Common::ConvertEndian<Common::Endian::Little>(value);
+			memcpy(p, &value, sizeof(value));
+		}
+		uint32_t Checksum(const void* data, size_t len)
+		{
+			return Encryption::CRC32(data, len).Get().HashData;
+		}
+
+		/// <summary>
+		/// 检查 p 处是否是偏移量为 offset 的有效同步标记，p 之后至少有 SyncMarkerSize 字节
+		/// </summary>
+		bool IsSyncMarker(const uint8_t* p, uint64_t offset)
+		{
+			return LoadLE32(p) == SyncMarkerTag &&
+				memcmp(p + 4, SyncMagic, sizeof(SyncMagic)) == 0 &&
+				LoadLE64(p + 12) == offset &&
+				LoadLE32(p + 20) == Checksum(p + 4, 16);
+		}
+
+		/// <summary>
+		/// 以 ScanWindow 为单位缓存流中 [base, base + data.size()) 的数据
+		/// </summary>
+		class WindowReader
+		{
+		public:
+			WindowReader(Stream& stream, uint64_t end) : stream(stream), end(end) { }
+			/// <summary>
+			/// 获取 [pos, pos + len) 的数据，调用者保证 pos + len 不超过 end
+			/// </summary>
+			const uint8_t* Get(uint64_t pos, size_t len)
+			{
+				if (pos < base || pos + len > base + data.size())
+				{
+					auto size = static_cast<size_t>(std::min<uint64_t>(std::max(len, ScanWindow), end - pos));
+					data.resize(size);
+					stream.ReadAt(pos, size, data.data());
+					base = pos;
+				}
+				return data.data() + (pos - base);
+			}
+		private:
+			Stream& stream;
+			uint64_t end;
+			uint64_t base = 0;
+			std::vector<uint8_t> data;
+		};
+
+		/// <summary>
+		/// 一块的校验结果
+		/// </summary>
+		struct Chunk
+		{
+			Chunk(uint64_t begin, bool startsWithMarker) : begin(begin), startsWithMarker(startsWithMarker) { }
+
+			uint64_t begin;
+			//! 下一段的开始，划分完所有段后填入
+			uint64_t end = 0;
+			bool startsWithMarker;
+			std::vector<RecordReader::RecordLocation> records;
+			//! 最后一个有效帧的结尾
+			uint64_t validEnd = 0;
+			bool ok = false;
+		};
+
+		/// <summary>
+		/// 查找 [begin, end) 中开始的所有有效同步标记
+		/// </summary>
+		void FindSyncMarkers(Stream& stream, uint64_t length, uint64_t begin, uint64_t end, std::vector<uint64_t>& markers)
+		{
+			std::vector<uint8_t> buffer;
+			for (auto window = begin; window < end; window += ScanWindow)
+			{
+				auto windowEnd = std::min<uint64_t>(window + ScanWindow, end);
+				// 多读入一个标记的长度，使跨越窗口边界的标记也能被识别
+				auto size = static_cast<size_t>(std::min<uint64_t>(windowEnd - window + RecordReader::SyncMarkerSize - 1, length - window));
+				if (size < RecordReader::SyncMarkerSize)
+					break;
+				buffer.resize(size);
+				stream.ReadAt(window, size, buffer.data());
+
+				// 以魔数的第一个字节定位候选位置，它不是 ASCII 字符，在文本负载中很少出现
+				auto first = reinterpret_cast<const char*>(buffer.data());
+				auto last = first + size;
+				auto p = first + 4;
+				while ((p = Common::FindByte(p, last, static_cast<char>(SyncMagic[0]))) != last)
+				{
+					size_t start = (p - first) - 4;
+					if (window + start >= windowEnd || start + RecordReader::SyncMarkerSize > size)
+						break;
+					if (IsSyncMarker(buffer.data() + start, window + start))
+						markers.push_back(window + start);
+					p++;
+				}
+			}
+		}
+
+		/// <summary>
+		/// 独立校验一块中的所有帧，块中不应再有同步标记
+		/// </summary>
+		void ValidateChunk(Stream& stream, Chunk& chunk)
+		{
+			WindowReader reader(stream, chunk.end);
+			auto pos = chunk.begin + (chunk.startsWithMarker ? RecordReader::SyncMarkerSize : 0);
+			chunk.ok = false;
+			while (pos < chunk.end)
+			{
+				if (chunk.end - pos < RecordReader::HeaderSize)
+					break;
+				auto header = reader.Get(pos, RecordReader::HeaderSize);
+				auto len = LoadLE32(header);
+				auto crc = LoadLE32(header + 4);
+				// 这里出现的同步标记没有通过查找阶段的校验，与超长的长度字段一样视为损坏
+				if (len > RecordReader::MaxRecordLength || len > chunk.end - pos - RecordReader::HeaderSize)
+					break;
+				if (Checksum(reader.Get(pos + RecordReader::HeaderSize, len), len) != crc)
+					break;
+				chunk.records.push_back({ pos + RecordReader::HeaderSize, len });
+				pos += RecordReader::HeaderSize + len;
+			}
+			chunk.ok = pos == chunk.end;
+			chunk.validEnd = pos;
+		}
+
+		/// <summary>
+		/// 在 threadCount 个线程中对 0 到 count - 1 调用 work，每个线程依次领取下一个序号
+		/// </summary>
+		template<typename Work>
+		void ParallelFor(size_t count, size_t threadCount, Work work)
+		{
+			std::atomic<size_t> next{ 0 };
+			std::mutex mutex;
+			std::exception_ptr failure;
+			auto run = [&]() {
+				try
+				{
+					for (size_t i; (i = next.fetch_add(1)) < count;)
+						work(i);
+				}
+				catch (...)
+				{
+					std::lock_guard<std::mutex> lock(mutex);
+					if (!failure)
+						failure = std::current_exception();
+					next.store(count);
+				}
+			};
+			std::vector<std::thread> threads;
+			auto n = std::min(threadCount, count);
+			for (size_t i = 1; i < n; i++)
+				threads.emplace_back(run);
+			run();
+			for (auto& thread : threads)
+				thread.join();
+			if (failure)
+				std::rethrow_exception(failure);
+		}
+	}
+
+	RecordWriter::RecordWriter(Stream& stream, uint64_t offset, size_t syncInterval)
+		: writer(stream), offset(offset), syncInterval(syncInterval)
+	{
+
+	}
+
+	void RecordWriter::Write(size_t len, const void* data)
+	{
+		if (len > RecordReader::MaxRecordLength)
+			throw Exception(u8"Error occured when writing record : Record_Too_Large");
+		frame.clear();
+		if (!lastMarker || offset - *lastMarker >= syncInterval)
+			AppendSyncMarker();
+
+		auto headerPos = frame.size();
+		frame.resize(headerPos + RecordReader::HeaderSize);
+		StoreLE32(frame.data() + headerPos, static_cast<uint32_t>(len));
+		StoreLE32(frame.data() + headerPos + 4, Checksum(data, len));
+		if (len <= CoalesceLength)
+		{
+			auto src = static_cast<const uint8_t*>(data);
+			frame.insert(frame.end(), src, src + len);
+			writer.WriteArray(frame);
+		}
+		else
+		{
+			writer.WriteArray(frame);
+			writer.WriteArray(static_cast<const uint8_t*>(data), len);
+		}
+		offset += RecordReader::HeaderSize + len;
+	}
+	void RecordWriter::WriteSyncMarker()
+	{
+		frame.clear();
+		AppendSyncMarker();
+		writer.WriteArray(frame);
+	}
+	void RecordWriter::AppendSyncMarker()
+	{
+		auto markerOffset = offset + frame.size();
+		auto pos = frame.size();
+		frame.resize(pos + RecordReader::SyncMarkerSize);
+		auto p = frame.data() + pos;
+		StoreLE32(p, SyncMarkerTag);
+		memcpy(p + 4, SyncMagic, sizeof(SyncMagic));
+		StoreLE64(p + 12, markerOffset);
+		StoreLE32(p + 20, Checksum(p + 4, 16));
+		lastMarker = markerOffset;
+		offset += RecordReader::SyncMarkerSize;
+	}
+
+	RecordReader::RecordReader(Stream& stream, uint64_t offset)
+		: stream(stream), offset(offset)
+	{
+
+	}
+
+	std::optional<Common::Span<const uint8_t>> RecordReader::Read()
+	{
+		while (true)
+		{
+			uint8_t header[HeaderSize];
+			auto got = ReadFully(HeaderSize, header);
+			if (got == 0)
+				return std::nullopt;
+			if (got < HeaderSize)
+				throw Exception(u8"Error occured when reading record : Truncated_Record");
+
+			auto len = LoadLE32(header);
+			if (len == SyncMarkerTag)
+			{
+				uint8_t marker[SyncMarkerSize];
+				memcpy(marker, header, HeaderSize);
+				if (ReadFully(SyncMarkerSize - HeaderSize, marker + HeaderSize) < SyncMarkerSize - HeaderSize)
+					throw Exception(u8"Error occured when reading record : Truncated_Record");
+				if (!IsSyncMarker(marker, offset))
+					throw Exception(u8"Error occured when reading record : Invalid_Sync_Marker");
+				offset += SyncMarkerSize;
+				continue;
+			}
+			if (len > MaxRecordLength)
+				throw Exception(u8"Error occured when reading record : Invalid_Record_Length");
+			payload.resize(len);
+			if (ReadFully(len, payload.data()) < len)
+				throw Exception(u8"Error occured when reading record : Truncated_Record");
+			if (Checksum(payload.data(), len) != LoadLE32(header + 4))
+				throw Exception(u8"Error occured when reading record : Checksum_Mismatch");
+			offset += HeaderSize + len;
+			return Common::Span<const uint8_t>(payload.data(), len);
+		}
+	}
+	size_t RecordReader::ReadFully(size_t len, void* data)
+	{
+		auto dst = static_cast<uint8_t*>(data);
+		size_t done = 0;
+		while (done < len)
+		{
+			auto n = stream.ReadSome(len - done, dst + done);
+			if (n == 0)
+				break;
+			done += n;
+		}
+		return done;
+	}
+
+	RecordReader::RecoveryResult RecordReader::Recover(Stream& stream, size_t threadCount)
+	{
+		if (threadCount == 0)
+			threadCount = std::max(1u, std::thread::hardware_concurrency());
+		auto length = stream.GetLength();
+		RecoveryResult result;
+		if (length == 0)
+			return result;
+
+		// 第一阶段：按窗口分段，并行查找有效的同步标记
+		auto windowCount = static_cast<size_t>((length + ScanWindow - 1) / ScanWindow);
+		auto segmentCount = std::min(windowCount, threadCount);
+		auto windowsPerSegment = (windowCount + segmentCount - 1) / segmentCount;
+		std::vector<std::vector<uint64_t>> found(segmentCount);
+		ParallelFor(segmentCount, threadCount, [&](size_t i) {
+			auto begin = static_cast<uint64_t>(i) * windowsPerSegment * ScanWindow;
+			auto end = std::min<uint64_t>(begin + static_cast<uint64_t>(windowsPerSegment) * ScanWindow, length);
+			FindSyncMarkers(stream, length, begin, end, found[i]);
+		});
+
+		// 第二阶段：以同步标记为界分块，并行校验
+		std::vector<Chunk> chunks;
+		for (auto& markers : found)
+		{
+			for (auto marker : markers)
+			{
+				if (chunks.empty() && marker != 0)
+					chunks.emplace_back(0, false);
+				chunks.emplace_back(marker, true);
+			}
+		}
+		if (chunks.empty())
+			chunks.emplace_back(0, false);
+		for (size_t i = 0; i < chunks.size(); i++)
+			chunks[i].end = i + 1 < chunks.size() ? chunks[i + 1].begin : length;
+		ParallelFor(chunks.size(), threadCount, [&](size_t i) {
+			ValidateChunk(stream, chunks[i]);
+		});
+
+		// 按顺序拼接各块的结果
+		size_t recordCount = 0;
+		for (auto& chunk : chunks)
+			recordCount += chunk.records.size();
+		result.records.reserve(recordCount);
+		for (auto& chunk : chunks)
+		{
+			result.records.insert(result.records.end(), chunk.records.begin(), chunk.records.end());
+			if (!chunk.ok)
+				result.damaged.push_back({ chunk.validEnd, chunk.end });
+		}
+		result.validLength = chunks.back().validEnd;
+		return result;
+	}
+}
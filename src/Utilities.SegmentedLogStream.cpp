@@ -0,0 +1,272 @@
+/**
+ @file
+ @brief 通用IO库 分段日志流实现
+
+ @author 司马坑
+ @date 2026/10/17
+*/
+#define _CRT_SECURE_NO_WARNINGS
+#include "Utilities.SegmentedLogStream.h"
+#include "Utilities.Platform.h"
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace Utilities
+{
+	namespace
+	{
+		bool FileExists(const std::wstring& path)
+		{
+#ifdef _WIN32
+			return _waccess(path.c_str(), 0) == 0;
+#else
+			return access(_private::NarrowPath(path.c_str()).c_str(), F_OK) == 0;
+#endif
+		}
+
+		/// <summary>
+		/// 同步文件所在的目录，使新建的段文件在掉电后仍然存在
+		/// </summary>
+		void SyncDirectory(const std::wstring& path)
+		{
+#ifndef _WIN32
+			auto narrow = _private::NarrowPath(path.c_str());
+			auto slash = narrow.rfind('/');
+			auto directory = slash == u8string::npos ? u8string(".") : slash == 0 ? u8string("/") : narrow.substr(0, slash);
+			int fd;
+			do
+				fd = open(directory.c_str(), O_RDONLY | O_CLOEXEC);
+			while (fd < 0 && errno == EINTR);
+			if (fd < 0)
+				_private::ThrowSystemError(u8"Error occured when syncing directory :");
+			auto result = fsync(fd);
+			auto err = errno;
+			close(fd);
+			// 部分文件系统不支持同步目录
+			if (result < 0 && err != EINVAL && err != EBADF)
+				_private::ThrowSystemError(u8"Error occured when syncing directory :", err);
+#else
+			// NTFS 的目录项随元数据日志提交，不需要单独同步
+			(void)path;
+#endif
+		}
+	}
+
+	SegmentedLogStream::SegmentedLogStream(const wchar_t* basePath, uint64_t segmentSize)
+		: Stream(Type::WriteOnly), basePath(basePath), segmentSize(segmentSize)
+	{
+		if (segmentSize == 0)
+			throw Exception(u8"Error occured when creating stream : Invalid_Segment_Size");
+		uint64_t index = 0;
+		while (FileExists(GetSegmentPath(index + 1)))
+			index++;
+		OpenSegment(index);
+	}
+	SegmentedLogStream::~SegmentedLogStream()
+	{
+		try
+		{
+			Close();
+		}
+		catch (...)
+		{
+			// 析构函数中无法报告错误
+		}
+	}
+
+	void SegmentedLogStream::Read(size_t, void*)
+	{
+		throw Exception(u8"Error occured when reading stream : Cannot_Read_WriteOnly_Stream");
+	}
+	void SegmentedLogStream::Write(size_t len, const void* data)
+	{
+		Append(len, data);
+	}
+	void SegmentedLogStream::Close()
+	{
+		std::lock_guard<std::mutex> lock(appendMutex);
+		if (closed)
+			return;
+		closed = true;
+		if (failure)
+		{
+			segment.reset();
+			std::rethrow_exception(failure);
+		}
+		try
+		{
+			segment->Sync();
+		}
+		catch (...)
+		{
+			// 同步失败后记录不再视为落盘，段文件照常关闭
+			Fail(std::current_exception());
+			segment.reset();
+			throw;
+		}
+		// 正在同步的线程可能仍持有当前段，文件在其完成后关闭
+		segment.reset();
+		std::lock_guard<std::mutex> syncLock(syncMutex);
+		if (durable < written)
+			durable = written;
+		synced.notify_all();
+	}
+	bool SegmentedLogStream::IsVaild()
+	{
+		std::lock_guard<std::mutex> lock(appendMutex);
+		return !closed && !failure && segment->IsVaild();
+	}
+	void SegmentedLogStream::Flush()
+	{
+		WaitDurable(GetWrittenLength());
+	}
+
+	uint64_t SegmentedLogStream::Append(size_t len, const void* data)
+	{
+		std::lock_guard<std::mutex> lock(appendMutex);
+		if (closed)
+			throw Exception("Stream Closed");
+		if (failure)
+			std::rethrow_exception(failure);
+		if (segmentLength != 0 && segmentLength + len > segmentSize)
+			Rotate();
+		segment->Write(len, data);
+		segmentLength += len;
+		written += len;
+		return written;
+	}
+	void SegmentedLogStream::WaitDurable(uint64_t lsn)
+	{
+		{
+			std::lock_guard<std::mutex> appendLock(appendMutex);
+			if (lsn > written)
+				throw Exception(u8"Error occured when waiting for log : Invalid_Lsn");
+		}
+		std::unique_lock<std::mutex> lock(syncMutex);
+		while (durable < lsn)
+		{
+			if (failure)
+				std::rethrow_exception(failure);
+			if (syncing)
+			{
+				synced.wait(lock);
+				continue;
+			}
+
+			// 成为本轮的同步者，同步开始前已经写入的记录都由这一次同步覆盖
+			syncing = true;
+			lock.unlock();
+			uint64_t target;
+			std::shared_ptr<FileStream> current;
+			{
+				std::lock_guard<std::mutex> appendLock(appendMutex);
+				target = written;
+				current = segment;
+			}
+			std::exception_ptr error;
+			// 已经关闭时 Close 已经同步了所有记录
+			if (current)
+			{
+				try
+				{
+					current->Sync();
+				}
+				catch (...)
+				{
+					error = std::current_exception();
+				}
+			}
+			if (error)
+			{
+				std::lock_guard<std::mutex> appendLock(appendMutex);
+				lock.lock();
+				syncing = false;
+				if (!failure)
+					failure = error;
+				synced.notify_all();
+				std::rethrow_exception(failure);
+			}
+			lock.lock();
+			syncing = false;
+			if (durable < target)
+				durable = target;
+			syncCount++;
+			synced.notify_all();
+		}
+	}
+	uint64_t SegmentedLogStream::Commit(size_t len, const void* data)
+	{
+		auto lsn = Append(len, data);
+		WaitDurable(lsn);
+		return lsn;
+	}
+
+	uint64_t SegmentedLogStream::GetWrittenLength()
+	{
+		std::lock_guard<std::mutex> lock(appendMutex);
+		return written;
+	}
+	uint64_t SegmentedLogStream::GetDurableLength()
+	{
+		std::lock_guard<std::mutex> lock(syncMutex);
+		return durable;
+	}
+	uint64_t SegmentedLogStream::GetSegmentIndex()
+	{
+		std::lock_guard<std::mutex> lock(appendMutex);
+		return segmentIndex;
+	}
+	uint64_t SegmentedLogStream::GetSyncCount()
+	{
+		std::lock_guard<std::mutex> lock(syncMutex);
+		return syncCount;
+	}
+	std::wstring SegmentedLogStream::GetSegmentPath(uint64_t index) const
+	{
+		auto number = std::to_wstring(index);
+		if (number.size() < 8)
+			number.insert(0, 8 - number.size(), L'0');
+		return basePath + L"." + number;
+	}
+
+	void SegmentedLogStream::OpenSegment(uint64_t index)
+	{
+		auto path = GetSegmentPath(index);
+		auto created = !FileExists(path);
+		// 可读写模式不会截断已有的段
+		auto file = std::make_shared<FileStream>(path.c_str(), Type::ReadWrite, false);
+		auto length = file->GetLength();
+		file->SetPosition(length);
+		if (created)
+			SyncDirectory(path);
+		segment = std::move(file);
+		segmentIndex = index;
+		segmentLength = length;
+	}
+	void SegmentedLogStream::Rotate()
+	{
+		// 先让旧段完整落盘，之后的同步只需要覆盖新段
+		try
+		{
+			segment->Sync();
+		}
+		catch (...)
+		{
+			Fail(std::current_exception());
+			throw;
+		}
+		OpenSegment(segmentIndex + 1);
+	}
+	void SegmentedLogStream::Fail(std::exception_ptr error)
+	{
+		std::lock_guard<std::mutex> lock(syncMutex);
+		if (!failure)
+			failure = error;
+		synced.notify_all();
+	}
+}
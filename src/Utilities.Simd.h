@@ -0,0 +1,126 @@
+/**
+ @file
+ @brief 通用编程库 SIMD 指令集检测的内部工具
+
+ 该文件仅供库内部的实现文件使用，不属于公开接口
+
+ 库以基础指令集编译，用到 SSSE3 / AVX2 的函数以 UTILITIES_TARGET 单独声明目标指令集，
+ 并在运行时根据 GetSimdLevel() 的结果选择调用
+
+ @author 司马坑
+ @date 2026/10/17
+*/
+#pragma once
+#include <cstdint>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define UTILITIES_SIMD_X86
+#include <immintrin.h>
+#ifdef _MSC_VER
+// MSVC 不需要为使用扩展指令集的函数单独声明目标
+#define UTILITIES_TARGET(isa)
+#else
+#define UTILITIES_TARGET(isa) __attribute__((target(isa)))
+#endif
+#endif
+
+namespace Utilities::_private
+{
+	/// <summary>
+	/// 可用的 SIMD 指令集等级
+	/// </summary>
+	enum class SimdLevel
+	{
+		None,
+		SSSE3,
+		AVX2
+	};
+
+#ifdef UTILITIES_SIMD_X86
+	/// <summary>
+	/// 检测 CPU 与操作系统支持的 SIMD 指令集
+	/// </summary>
+	inline SimdLevel DetectSimd()
+	{
+#ifdef _MSC_VER
+		int info[4];
+		__cpuid(info, 0);
+		auto maxLeaf = info[0];
+		__cpuid(info, 1);
+		bool ssse3 = (info[2] & (1 << 9)) != 0;
+		bool osxsave = (info[2] & (1 << 27)) != 0;
+		bool avx = (info[2] & (1 << 28)) != 0;
+		bool avx2 = false;
+		if (maxLeaf >= 7 && osxsave && avx && (_xgetbv(0) & 6) == 6)
+		{
+			__cpuidex(info, 7, 0);
+			avx2 = (info[1] & (1 << 5)) != 0;
+		}
+#else
+		__builtin_cpu_init();
+		bool ssse3 = __builtin_cpu_supports("ssse3");
+		bool avx2 = __builtin_cpu_supports("avx2");
+#endif
+		return avx2 ? SimdLevel::AVX2 : ssse3 ? SimdLevel::SSSE3 : SimdLevel::None;
+	}
+#endif
+
+	/// <summary>
+	/// 计算末尾 0 的个数，用于从比较掩码中找到第一个命中的位置
+	/// </summary>
+	/// <param name="v">不为 0 的数值</param>
+	inline unsigned CountTrailingZeros(uint64_t v)
+	{
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+		unsigned long index;
+		_BitScanForward64(&index, v);
+		return index;
+#elif defined(_MSC_VER)
+		unsigned long index;
+		if (_BitScanForward(&index, static_cast<unsigned long>(v)))
+			return index;
+		_BitScanForward(&index, static_cast<unsigned long>(v >> 32));
+		return index + 32;
+#else
+		return __builtin_ctzll(v);
+#endif
+	}
+
+	/// <summary>
+	/// 计算以 2 为底的对数并向下取整，即最高的 1 所在的位置
+	/// </summary>
+	/// <param name="v">不为 0 的数值</param>
+	inline unsigned FloorLog2(uint64_t v)
+	{
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+		unsigned long index;
+		_BitScanReverse64(&index, v);
+		return index;
+#elif defined(_MSC_VER)
+		unsigned long index;
+		if (_BitScanReverse(&index, static_cast<unsigned long>(v >> 32)))
+			return index + 32;
+		_BitScanReverse(&index, static_cast<unsigned long>(v));
+		return index;
+#else
+		return 63 - __builtin_clzll(v);
+#endif
+	}
+
+	/// <summary>
+	/// 获取可用的 SIMD 指令集等级，只在第一次调用时检测
+	/// </summary>
+	inline SimdLevel GetSimdLevel()
+	{
+#ifdef UTILITIES_SIMD_X86
+		static const SimdLevel level = DetectSimd();
+		return level;
+#else
+		return SimdLevel::None;
+#endif
+	}
+}
@@ -8,6 +8,8 @@
 
 #include "Utilities.Stream.h"
 
+#include <memory>
+
 Utilities::Stream::Stream(Stream&& rhs) noexcept : streamType(rhs.streamType)
 {
 	rhs.streamType = Type::Unkonwn;
@@ -20,3 +22,130 @@ Utilities::Stream::~Stream()
 
 }
 
+size_t Utilities::Stream::ReadSome(size_t maxLen, void* data)
+{
+	if (maxLen == 0)
+		return 0;
+	uint64_t remain;
+	bool seekable = true;
+	try
+	{
+		remain = GetLength() - GetPosition();
+	}
+	catch (const Exception&)
+	{
+		seekable = false;
+	}
+	if (seekable)
+	{
+		if (remain < maxLen)
+			maxLen = static_cast<size_t>(remain);
+		if (maxLen != 0)
+			Read(maxLen, data);
+		return maxLen;
+	}
+
+	// 不支持定位的流无法预先知道剩余的长度，逐字节读取直到读满或 Read 因到达末尾而失败
+	auto dst = static_cast<uint8*>(data);
+	size_t done = 0;
+	try
+	{
+		for (; done < maxLen; done++)
+			Read(1, dst + done);
+	}
+	catch (const Exception&)
+	{
+		// 一个字节都没有读到时区分流末尾与流已不可用
+		if (done == 0 && !IsVaild())
+			throw;
+	}
+	return done;
+}
+
+void Utilities::Stream::ReadV(size_t count, const Segment* segments)
+{
+	for (size_t i = 0; i < count; i++)
+		Read(segments[i].len, segments[i].data);
+}
+
+void Utilities::Stream::WriteV(size_t count, const ConstSegment* segments)
+{
+	for (size_t i = 0; i < count; i++)
+		Write(segments[i].len, segments[i].data);
+}
+
+void Utilities::Stream::Flush()
+{
+
+}
+
+void Utilities::Stream::CopyTo(Stream& dst, uint64_t len)
+{
+	constexpr uint64_t chunkSize = 64 * 1024;
+	if (len == 0)
+		return;
+
+	auto bufferSize = static_cast<size_t>(len < chunkSize ? len : chunkSize);
+	std::unique_ptr<uint8[]> buffer(new uint8[bufferSize]);
+	while (len != 0)
+	{
+		auto chunk = static_cast<size_t>(len < bufferSize ? len : bufferSize);
+		auto readLen = ReadSome(chunk, buffer.get());
+		if (readLen == 0)
+			throw Exception(u8"Error occured when reading stream : End_Of_Stream");
+		dst.Write(readLen, buffer.get());
+		len -= readLen;
+	}
+}
+
+void Utilities::Stream::ReadAt(uint64_t offset, size_t len, void* data)
+{
+	auto pos = GetPosition();
+	SetPosition(offset);
+	try
+	{
+		Read(len, data);
+	}
+	catch (...)
+	{
+		SetPosition(pos);
+		throw;
+	}
+	SetPosition(pos);
+}
+
+void Utilities::Stream::WriteAt(uint64_t offset, size_t len, const void* data)
+{
+	auto pos = GetPosition();
+	SetPosition(offset);
+	try
+	{
+		Write(len, data);
+	}
+	catch (...)
+	{
+		SetPosition(pos);
+		throw;
+	}
+	SetPosition(pos);
+}
+
+uint64_t Utilities::Stream::GetLength()
+{
+	throw Exception(u8"Error occured when seeking stream : Stream_Not_Seekable");
+}
+
+uint64_t Utilities::Stream::GetPosition()
+{
+	throw Exception(u8"Error occured when seeking stream : Stream_Not_Seekable");
+}
+
+void Utilities::Stream::SetPosition(uint64_t)
+{
+	throw Exception(u8"Error occured when seeking stream : Stream_Not_Seekable");
+}
+
+void Utilities::Stream::Seek(int64_t)
+{
+	throw Exception(u8"Error occured when seeking stream : Stream_Not_Seekable");
+}
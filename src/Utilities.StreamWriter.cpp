@@ -5,6 +5,7 @@
  @author 司马坑
  @date 2020/2/12
 */ 
+#include <cstdio>
 #include "Utilities.StreamWriter.h"
 namespace Utilities 
 {
@@ -27,7 +28,6 @@ namespace Utilities
 		WriteString(string);
 	}
 
-	template<>
 	void StreamWriter<FILE*>::Write(const u8string& obj)
 	{
 		WriteString(obj);
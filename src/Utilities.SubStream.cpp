@@ -0,0 +1,94 @@
+/**
+ @file
+ @brief 通用IO库 子流实现
+
+ @author 司马坑
+ @date 2026/10/17
+*/
+#include "Utilities.SubStream.h"
+
+namespace Utilities
+{
+	SubStream::SubStream(Stream& parent, uint64_t offset, uint64_t length)
+		: Stream(parent.GetStreamType()), parent(parent), offset(offset), length(length)
+	{
+		if (offset + length < offset)
+			throw Exception(u8"Error occured when creating stream : Range_Overflow");
+	}
+
+	void SubStream::Read(size_t len, void* data)
+	{
+		ReadAt(position, len, data);
+		position += len;
+	}
+	void SubStream::Write(size_t len, const void* data)
+	{
+		WriteAt(position, len, data);
+		position += len;
+	}
+	size_t SubStream::ReadSome(size_t maxLen, void* data)
+	{
+		if (closed)
+			throw Exception("Stream Closed");
+		if (position >= length)
+			return 0;
+		auto len = length - position < maxLen ? static_cast<size_t>(length - position) : maxLen;
+		Read(len, data);
+		return len;
+	}
+	void SubStream::ReadAt(uint64_t pos, size_t len, void* data)
+	{
+		if (GetStreamType() == Type::WriteOnly)
+			throw Exception(u8"Error occured when reading stream : Cannot_Read_WriteOnly_Stream");
+		if (closed)
+			throw Exception("Stream Closed");
+		if (pos > length || len > length - pos)
+			throw Exception(u8"Error occured when reading stream : End_Of_Stream");
+		parent.ReadAt(offset + pos, len, data);
+	}
+	void SubStream::WriteAt(uint64_t pos, size_t len, const void* data)
+	{
+		if (GetStreamType() == Type::ReadOnly)
+			throw Exception(u8"Error occured when writing stream : Cannot_Write_ReadOnly_Stream");
+		if (closed)
+			throw Exception("Stream Closed");
+		if (pos > length || len > length - pos)
+			throw Exception(u8"Error occured when writing stream : Write_Out_Of_Range");
+		parent.WriteAt(offset + pos, len, data);
+	}
+	void SubStream::Close()
+	{
+		closed = true;
+	}
+	bool SubStream::IsVaild()
+	{
+		return !closed && parent.IsVaild();
+	}
+
+	uint64_t SubStream::GetLength()
+	{
+		if (closed)
+			throw Exception("Stream Closed");
+		return length;
+	}
+	uint64_t SubStream::GetPosition()
+	{
+		if (closed)
+			throw Exception("Stream Closed");
+		return position;
+	}
+	void SubStream::SetPosition(uint64_t pos)
+	{
+		if (closed)
+			throw Exception("Stream Closed");
+		if (pos > length)
+			throw Exception(u8"Error occured when seeking stream : Position_Out_Of_Range");
+		position = pos;
+	}
+	void SubStream::Seek(int64_t offset)
+	{
+		if (offset < 0 && static_cast<uint64_t>(-offset) > position)
+			throw Exception(u8"Error occured when seeking stream : Position_Out_Of_Range");
+		SetPosition(position + offset);
+	}
+}
@@ -0,0 +1,140 @@
+/**
+ @file
+ @brief 对 Utilities::AsyncIOEngine 进行单元测试
+
+ 这个文件里面是通过几组函数对 Utilities::AsyncIOEngine 进行功能上的单元测试
+
+ @author 司马坑
+ @date 2026/10/17
+*/
+#define _CRT_SECURE_NO_WARNINGS
+
+#include <string>
+#include <cstring>
+#include <ctime>
+#include <vector>
+#include <future>
+
+#include <gtest/gtest.h>
+
+#include <Utilities.AsyncIO.h>
+#pragma comment(lib,"E15Utilities.lib")
+
+using namespace std;
+using namespace Utilities;
+
+/// <summary>
+/// 测试批量发起的异步读取
+/// </summary>
+TEST(Utilities_AsyncIO, Read)
+{
+	wchar_t fileName[L_tmpnam];
+	_wtmpnam(fileName);
+
+	srand(static_cast<uint32_t>(time(nullptr)));
+	const auto size = 64 * 1024;
+	vector<char> buf(size);
+	for (auto& c : buf)
+		c = rand() & 255;
+	{
+		FileStream fs = FileStream(fileName, Stream::Type::WriteOnly, false);
+		fs.Write(size, buf.data());
+	}
+
+	FileStream fs = FileStream(fileName, Stream::Type::ReadOnly, false);
+	const auto chunk = 1000;
+	vector<char> cmp(size);
+	vector<future<void>> pending;
+	{
+		AsyncIOEngine::Batch batch;
+		for (auto offset = 0; offset < size; offset += chunk)
+		{
+			auto len = offset + chunk > size ? size - offset : chunk;
+			pending.push_back(fs.ReadAsync(offset, len, cmp.data() + offset));
+		}
+	}
+	for (auto& f : pending)
+		f.get();
+	EXPECT_EQ(memcmp(cmp.data(), buf.data(), size), 0);
+	EXPECT_EQ(fs.GetPosition(), 0);
+
+	// 读到文件末尾时通过 future 抛出异常
+	char tail[16];
+	auto f = fs.ReadAsync(size - 8, sizeof(tail), tail);
+	EXPECT_THROW(f.get(), Exception);
+}
+
+/// <summary>
+/// 测试使用独立引擎的异步写入
+/// </summary>
+TEST(Utilities_AsyncIO, Write)
+{
+	wchar_t fileName[L_tmpnam];
+	_wtmpnam(fileName);
+
+	AsyncIOEngine engine(4, 2);
+	const auto count = 100;
+	vector<uint32_t> values(count);
+	{
+		FileStream fs = FileStream(fileName, Stream::Type::ReadWrite, false);
+		vector<future<void>> pending;
+		for (uint32_t i = 0; i < count; i++)
+		{
+			values[i] = i * 7;
+			// 超过队列深度的请求会等待空位
+			pending.push_back(engine.Write(fs, i * sizeof(uint32_t), sizeof(uint32_t), &values[i]));
+		}
+		for (auto& f : pending)
+			f.get();
+		EXPECT_EQ(fs.GetLength(), count * sizeof(uint32_t));
+	}
+
+	FileStream fs = FileStream(fileName, Stream::Type::ReadOnly, false);
+	vector<uint32_t> cmp(count);
+	fs.Read(count * sizeof(uint32_t), cmp.data());
+	EXPECT_EQ(cmp, values);
+	EXPECT_THROW(engine.Write(fs, 0, 1, "x"), Exception);
+}
+
+/// <summary>
+/// 测试在一个批量提交作用域内发起超过队列深度的请求
+/// </summary>
+TEST(Utilities_AsyncIO, BatchOverflow)
+{
+	wchar_t fileName[L_tmpnam];
+	_wtmpnam(fileName);
+
+	const auto count = 40;
+	vector<uint32_t> values(count);
+	for (uint32_t i = 0; i < count; i++)
+		values[i] = i * 13;
+	{
+		FileStream fs = FileStream(fileName, Stream::Type::WriteOnly, false);
+		fs.Write(count * sizeof(uint32_t), values.data());
+	}
+
+	AsyncIOEngine engine(8, 2);
+	FileStream fs = FileStream(fileName, Stream::Type::ReadOnly, false);
+	vector<uint32_t> cmp(count);
+	vector<future<void>> pending;
+	{
+		// 队列已满时先提交作用域内已准备的请求，再等待空位
+		AsyncIOEngine::Batch batch(engine);
+		for (uint32_t i = 0; i < count; i++)
+			pending.push_back(engine.Read(fs, i * sizeof(uint32_t), sizeof(uint32_t), &cmp[i]));
+	}
+	for (auto& f : pending)
+		f.get();
+	EXPECT_EQ(cmp, values);
+
+	// 批量提交作用域只影响它所属的引擎
+	AsyncIOEngine other(8, 2);
+	uint32_t v = 0;
+	{
+		AsyncIOEngine::Batch batch(engine);
+		auto f = other.Read(fs, 4 * sizeof(uint32_t), sizeof(uint32_t), &v);
+		ASSERT_EQ(f.wait_for(chrono::seconds(10)), future_status::ready);
+		f.get();
+	}
+	EXPECT_EQ(v, values[4]);
+}
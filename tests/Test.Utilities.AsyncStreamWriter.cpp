@@ -0,0 +1,186 @@
+/**
+ @file
+ @brief 对 Utilities::AsyncStreamWriter 进行单元测试
+
+ @author 司马坑
+ @date 2026/10/17
+*/
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+#include <Utilities.AsyncStreamWriter.h>
+#include <Utilities.FileStream.h>
+#include <Utilities.MemoryStream.h>
+#include <Utilities.StreamWriter.h>
+
+#pragma comment(lib,"E15Utilities.lib")
+
+using namespace Utilities;
+
+namespace
+{
+	/// <summary>
+	/// 每次写入都很慢的流，可以设置为写入失败
+	/// </summary>
+	class SlowStream : public Stream
+	{
+	public:
+		SlowStream() : Stream(Type::WriteOnly) { }
+		virtual void Read(size_t, void*) override { }
+		virtual void Write(size_t len, const void* data) override
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(5));
+			if (fail)
+				throw Exception(u8"Error occured when writing stream : Device_Error");
+			auto p = static_cast<const char*>(data);
+			text.append(p, p + len);
+		}
+		virtual void Flush() override { flushes++; }
+		virtual void Close() override { closed = true; }
+		virtual bool IsVaild() override { return !closed; }
+		std::string text;
+		int flushes = 0;
+		bool fail = false;
+		bool closed = false;
+	};
+
+	std::string ToString(MemoryStream& ms)
+	{
+		auto view = ms.View();
+		return std::string(reinterpret_cast<const char*>(view.data()), view.size());
+	}
+}
+
+TEST(Utilities_AsyncStreamWriter, Default)
+{
+	MemoryStream ms;
+	std::string expect;
+	{
+		AsyncStreamWriter async(ms, 256);
+		auto sw = StreamWriter(async);
+		for (auto i = 0; i < 1000; i++)
+		{
+			sw.Format("{},", i);
+			expect += std::to_string(i) + ",";
+		}
+		// 超过缓冲区大小的单次写入
+		std::string large(1000, 'x');
+		async.Write(large.size(), large.data());
+		expect += large;
+		async.Flush();
+		EXPECT_EQ(ToString(ms), expect);
+
+		async.Write(3, "end");
+		expect += "end";
+	}
+	// 析构时写入剩余数据
+	EXPECT_EQ(ToString(ms), expect);
+}
+
+TEST(Utilities_AsyncStreamWriter, Policy)
+{
+	const std::string record = "0123456789abcdef";
+
+	SlowStream blocking;
+	{
+		AsyncStreamWriter async(blocking, 64);
+		for (auto i = 0; i < 50; i++)
+			async.Write(record.size(), record.data());
+		async.Flush();
+		EXPECT_GT(async.GetStallCount(), 0);
+		EXPECT_EQ(async.GetDroppedBytes(), 0);
+	}
+	EXPECT_EQ(blocking.text.size(), record.size() * 50);
+	// Flush 与析构各一次
+	EXPECT_EQ(blocking.flushes, 2);
+
+	SlowStream dropping;
+	AsyncStreamWriter async(dropping, 64, AsyncStreamWriter::OverflowPolicy::Drop);
+	auto start = std::chrono::steady_clock::now();
+	for (auto i = 0; i < 50; i++)
+		async.Write(record.size(), record.data());
+	// 写入方不等待后台线程
+	EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(100));
+	async.Close();
+	EXPECT_TRUE(dropping.closed);
+	EXPECT_GT(async.GetDroppedBytes(), 0);
+	EXPECT_EQ(dropping.text.size() + async.GetDroppedBytes(), record.size() * 50);
+	// 只会丢弃整条记录
+	for (size_t i = 0; i < dropping.text.size(); i += record.size())
+		EXPECT_EQ(dropping.text.substr(i, record.size()), record);
+	EXPECT_THROW(async.Write(1, "x"), Exception);
+}
+
+TEST(Utilities_AsyncStreamWriter, Error)
+{
+	SlowStream failing;
+	failing.fail = true;
+	AsyncStreamWriter async(failing, 16);
+	async.Write(20, "01234567890123456789");
+	EXPECT_THROW(async.Flush(), Exception);
+	EXPECT_FALSE(async.IsVaild());
+	EXPECT_THROW(async.Write(1, "x"), Exception);
+	EXPECT_THROW(async.Close(), Exception);
+}
+
+TEST(Utilities_AsyncStreamWriter, Sync)
+{
+	SlowStream slow;
+	std::vector<size_t> synced;
+	{
+		AsyncStreamWriter async(slow, 64, AsyncStreamWriter::OverflowPolicy::Block,
+			[&synced](Stream& s) { synced.push_back(static_cast<SlowStream&>(s).text.size()); });
+		async.Write(100, std::string(100, 'a').data());
+		async.Flush();
+		// 同步回调在数据全部写入并 Flush 之后调用
+		ASSERT_EQ(synced.size(), 1);
+		EXPECT_EQ(synced[0], 100);
+		EXPECT_EQ(slow.flushes, 1);
+
+		async.Write(10, "0123456789");
+		async.Close();
+		ASSERT_EQ(synced.size(), 2);
+		EXPECT_EQ(synced[1], 110);
+	}
+	EXPECT_EQ(synced.size(), 2);
+
+	// 包装 FileStream 时缺省调用 FileStream::Sync
+	wchar_t fileName[L_tmpnam];
+	_wtmpnam(fileName);
+	FileStream fs(fileName, Stream::Type::WriteOnly, false);
+	{
+		AsyncStreamWriter async(fs, 64);
+		async.Write(100, std::string(100, 'b').data());
+		async.Flush();
+		EXPECT_EQ(fs.GetLength(), 100);
+	}
+	fs.Close();
+	EXPECT_THROW(fs.Sync(), Exception);
+}
+
+TEST(Utilities_AsyncStreamWriter, Concurrent)
+{
+	MemoryStream ms;
+	{
+		AsyncStreamWriter async(ms, 1000);
+		std::vector<std::thread> threads;
+		for (auto t = 0; t < 4; t++)
+		{
+			threads.emplace_back([&async, t]()
+			{
+				// 每条记录由同一个字符组成，交错时可以发现
+				std::string record(37, static_cast<char>('a' + t));
+				for (auto i = 0; i < 2000; i++)
+					async.Write(record.size(), record.data());
+			});
+		}
+		for (auto& thread : threads)
+			thread.join();
+	}
+	auto text = ToString(ms);
+	ASSERT_EQ(text.size(), 37 * 2000 * 4);
+	for (size_t i = 0; i < text.size(); i += 37)
+		ASSERT_EQ(text.substr(i, 37), std::string(37, text[i]));
+}
@@ -0,0 +1,248 @@
+/**
+ @file
+ @brief 对 Utilities::BufferedStream 进行单元测试
+
+ 这个文件里面是通过几组函数对 Utilities::BufferedStream 进行功能上的单元测试
+
+ @author 司马坑
+ @date 2026/10/17
+*/
+#define _CRT_SECURE_NO_WARNINGS
+
+#include <string>
+#include <cstring>
+#include <ctime>
+
+#include <gtest/gtest.h>
+
+#include <Utilities.BufferedStream.h>
+#include <Utilities.MemoryStream.h>
+#include <Utilities.FileStream.h>
+#include <Utilities.StreamReader.h>
+#pragma comment(lib,"E15Utilities.lib")
+
+using namespace std;
+using namespace Utilities;
+
+/// <summary>
+/// 记录读写次数的内存流
+/// </summary>
+class CountingStream : public MemoryStream
+{
+public:
+	size_t reads = 0;
+	size_t writes = 0;
+	virtual void Read(size_t len, void* data) override { reads++; MemoryStream::Read(len, data); }
+	virtual size_t ReadSome(size_t len, void* data) override { reads++; return MemoryStream::ReadSome(len, data); }
+	virtual void Write(size_t len, const void* data) override { writes++; MemoryStream::Write(len, data); }
+};
+
+/// <summary>
+/// 测试小块读取会被合并
+/// </summary>
+TEST(Utilities_BufferedStream, Read)
+{
+	CountingStream ms;
+	for (uint32_t i = 0; i < 1000; i++)
+		ms.Write(sizeof(i), &i);
+	ms.SetPosition(0);
+
+	BufferedStream bs(ms, 1024);
+	auto sr = StreamReader(bs);
+	for (uint32_t i = 0; i < 1000; i++)
+		EXPECT_EQ(sr.Read<uint32_t>(), i);
+	EXPECT_LE(ms.reads, 4);
+	EXPECT_EQ(bs.GetPosition(), 4000);
+
+	uint32_t v;
+	EXPECT_THROW(bs.Read(sizeof(v), &v), Exception);
+}
+
+/// <summary>
+/// 测试小块写入会被合并，并在 Flush 时提交
+/// </summary>
+TEST(Utilities_BufferedStream, Write)
+{
+	CountingStream ms;
+	{
+		BufferedStream bs(ms, 1024);
+		for (uint32_t i = 0; i < 1000; i++)
+			bs.Write(sizeof(i), &i);
+		EXPECT_EQ(bs.GetPosition(), 4000);
+		EXPECT_LE(ms.writes, 4);
+		bs.Flush();
+		EXPECT_EQ(ms.GetLength(), 4000);
+
+		// 析构时提交剩余的数据
+		uint32_t tail = 0xFFFFFFFF;
+		bs.Write(sizeof(tail), &tail);
+	}
+	EXPECT_EQ(ms.GetLength(), 4004);
+
+	auto view = ms.View();
+	for (uint32_t i = 0; i < 1000; i++)
+	{
+		uint32_t v;
+		memcpy(&v, view.data() + i * sizeof(v), sizeof(v));
+		EXPECT_EQ(v, i);
+	}
+}
+
+/// <summary>
+/// 测试交替读写以及在缓冲区内定位
+/// </summary>
+TEST(Utilities_BufferedStream, Seek)
+{
+	MemoryStream ms;
+	const char data[] = "0123456789abcdef";
+	ms.Write(16, data);
+	ms.SetPosition(0);
+
+	BufferedStream bs(ms, 8);
+	char c;
+	bs.Read(1, &c);
+	EXPECT_EQ(c, '0');
+	bs.SetPosition(5);
+	bs.Read(1, &c);
+	EXPECT_EQ(c, '5');
+
+	// 预读的数据被丢弃后写入到逻辑位置
+	bs.Write(1, "X");
+	bs.Seek(-1);
+	bs.Read(1, &c);
+	EXPECT_EQ(c, 'X');
+	bs.Read(1, &c);
+	EXPECT_EQ(c, '7');
+
+	char big[12];
+	bs.SetPosition(4);
+	bs.Read(12, big);
+	EXPECT_EQ(memcmp(big, "45X789abcdef", 12), 0);
+	EXPECT_EQ(bs.GetLength(), 16);
+}
+
+/// <summary>
+/// 不支持定位的内存流
+/// </summary>
+class UnseekableStream : public MemoryStream
+{
+public:
+	virtual void SetPosition(uint64_t) override { throw Exception(u8"Error occured when seeking stream : Not_Supported"); }
+	virtual void Seek(int64_t) override { throw Exception(u8"Error occured when seeking stream : Not_Supported"); }
+};
+
+/// <summary>
+/// 测试 Flush 不丢弃预读的数据，包装不支持定位的流时也能继续读取
+/// </summary>
+TEST(Utilities_BufferedStream, FlushKeepsReadBuffer)
+{
+	UnseekableStream ms;
+	const char data[] = "0123456789abcdef";
+	ms.Write(16, data);
+	ms.MemoryStream::SetPosition(0);
+
+	BufferedStream bs(ms, 8);
+	char c;
+	bs.Read(1, &c);
+	EXPECT_EQ(c, '0');
+	bs.Flush();
+	EXPECT_EQ(bs.GetBufferedLength(), 7);
+	char rest[15];
+	bs.Read(15, rest);
+	EXPECT_EQ(memcmp(rest, data + 1, 15), 0);
+
+	// 写入前需要退回读写指针，定位失败时预读的数据不会丢失
+	UnseekableStream ms2;
+	ms2.Write(16, data);
+	ms2.MemoryStream::SetPosition(0);
+	BufferedStream bs2(ms2, 8);
+	bs2.Read(1, &c);
+	EXPECT_THROW(bs2.Write(1, "X"), Exception);
+	EXPECT_EQ(bs2.GetBufferedLength(), 7);
+	bs2.Read(1, &c);
+	EXPECT_EQ(c, '1');
+}
+
+/// <summary>
+/// 只实现必需接口的只读流，ReadSome 使用缺省实现
+/// </summary>
+class MinimalStream : public Stream
+{
+public:
+	MinimalStream(const std::string& text, bool seekable) : Stream(Type::ReadOnly), text(text), seekable(seekable) { }
+	virtual void Read(size_t len, void* data) override
+	{
+		if (len > text.size() - position)
+			throw Exception(u8"Error occured when reading stream : End_Of_Stream");
+		memcpy(data, text.data() + position, len);
+		position += len;
+	}
+	virtual void Write(size_t, const void*) override { throw Exception(u8"Error occured when writing stream : Cannot_Write_ReadOnly_Stream"); }
+	virtual void Close() override { }
+	virtual bool IsVaild() override { return true; }
+	virtual uint64_t GetLength() override { return seekable ? text.size() : Stream::GetLength(); }
+	virtual uint64_t GetPosition() override { return seekable ? position : Stream::GetPosition(); }
+private:
+	std::string text;
+	size_t position = 0;
+	bool seekable;
+};
+
+/// <summary>
+/// 测试 Stream::ReadSome 的缺省实现在数据不足时返回实际读取的长度
+/// </summary>
+TEST(Utilities_BufferedStream, DefaultReadSome)
+{
+	for (auto seekable : { true, false })
+	{
+		MinimalStream raw("abc", seekable);
+		char buf[8];
+		EXPECT_EQ(raw.ReadSome(8, buf), 3);
+		EXPECT_EQ(memcmp(buf, "abc", 3), 0);
+		EXPECT_EQ(raw.ReadSome(8, buf), 0);
+
+		MinimalStream small("xyz", seekable);
+		BufferedStream bs(small, 16);
+		char c;
+		bs.Read(1, &c);
+		EXPECT_EQ(c, 'x');
+		bs.Read(2, buf);
+		EXPECT_EQ(memcmp(buf, "yz", 2), 0);
+		EXPECT_THROW(bs.Read(1, &c), Exception);
+
+		MinimalStream lines("first\nsecond", seekable);
+		auto sr = StreamReader(lines);
+		EXPECT_EQ(*sr.ReadLine(), "first");
+		EXPECT_EQ(*sr.ReadLine(), "second");
+		EXPECT_FALSE(sr.ReadLine());
+	}
+}
+
+/// <summary>
+/// 测试包装文件流
+/// </summary>
+TEST(Utilities_BufferedStream, FileStream)
+{
+	wchar_t fileName[L_tmpnam];
+	_wtmpnam(fileName);
+
+	srand(static_cast<uint32_t>(time(nullptr)));
+	const auto size = 1024;
+	char buf[size] = { 0 };
+	for (auto i = 0; i < size; i++)
+		buf[i] ^= rand() & 255;
+
+	{
+		FileStream fs = FileStream(fileName, Stream::Type::WriteOnly, false);
+		BufferedStream bs(fs, 100);
+		for (auto i = 0; i < size; i++)
+			bs.Write(1, &buf[i]);
+		bs.Close();
+	}
+
+	FileStream fs = FileStream(fileName, Stream::Type::ReadOnly, false);
+	BufferedStream bs(fs, 100);
+	auto sr = StreamReader(bs);
+	for (auto i = 0; i < size; i++)
+		EXPECT_EQ(sr.Read<char>(), buf[i]);
+}
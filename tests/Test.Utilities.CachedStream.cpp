@@ -0,0 +1,181 @@
+/**
+ @file
+ @brief 对 Utilities::BlockCache 与 Utilities::CachedStream 进行单元测试
+
+ @author 司马坑
+ @date 2026/10/17
+*/
+#include <random>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+#include <Utilities.CachedStream.h>
+#include <Utilities.MemoryStream.h>
+
+#pragma comment(lib,"E15Utilities.lib")
+
+using namespace Utilities;
+
+namespace
+{
+	std::vector<uint8_t> MakeData(size_t size)
+	{
+		std::vector<uint8_t> data(size);
+		for (size_t i = 0; i < size; i++)
+			data[i] = static_cast<uint8_t>(i * 7 + (i >> 8));
+		return data;
+	}
+}
+
+TEST(Utilities_CachedStream, Default)
+{
+	auto data = MakeData(10000);
+	MemoryStream ms(data.data(), data.size());
+	BlockCache cache(64 * 1024, 1024, 4);
+	CachedStream cs(ms, cache);
+	EXPECT_EQ(cs.GetLength(), data.size());
+
+	// 跨越多个块以及不完整的最后一块
+	std::vector<uint8_t> buf(3000);
+	cs.SetPosition(500);
+	cs.Read(3000, buf.data());
+	EXPECT_EQ(memcmp(buf.data(), data.data() + 500, 3000), 0);
+	EXPECT_EQ(cache.GetStatistics().misses, 4);
+	cs.ReadAt(9500, 500, buf.data());
+	EXPECT_EQ(memcmp(buf.data(), data.data() + 9500, 500), 0);
+
+	// 再次读取全部命中
+	auto misses = cache.GetStatistics().misses;
+	cs.ReadAt(600, 2000, buf.data());
+	EXPECT_EQ(memcmp(buf.data(), data.data() + 600, 2000), 0);
+	EXPECT_EQ(cache.GetStatistics().misses, misses);
+	EXPECT_EQ(cache.GetStatistics().hits, 3);
+
+	cs.SetPosition(9990);
+	EXPECT_EQ(cs.ReadSome(100, buf.data()), 10);
+	EXPECT_EQ(cs.ReadSome(100, buf.data()), 0);
+	EXPECT_THROW(cs.ReadAt(9990, 11, buf.data()), Exception);
+}
+
+TEST(Utilities_CachedStream, Eviction)
+{
+	auto data = MakeData(64 * 1024);
+	MemoryStream ms(data.data(), data.size());
+	BlockCache cache(8 * 1024, 1024, 1);
+	EXPECT_EQ(cache.GetBlockCount(), 8);
+	CachedStream cs(ms, cache);
+
+	std::mt19937 rng(1);
+	uint8_t buf[64];
+	for (auto i = 0; i < 2000; i++)
+	{
+		// 大部分读取集中在前 4 块，它们应当一直留在缓存中
+		auto pos = rng() % 4 == 0 ? rng() % (data.size() - 64) : rng() % (4 * 1024 - 64);
+		cs.ReadAt(pos, 64, buf);
+		ASSERT_EQ(memcmp(buf, data.data() + pos, 64), 0);
+	}
+	auto statistics = cache.GetStatistics();
+	EXPECT_GT(statistics.evictions, 0);
+	EXPECT_GT(statistics.hits, statistics.misses * 2);
+
+	cache.Clear();
+	cs.ReadAt(0, 64, buf);
+	EXPECT_EQ(cache.GetStatistics().misses, statistics.misses + 1);
+}
+
+TEST(Utilities_CachedStream, Write)
+{
+	MemoryStream ms;
+	auto data = MakeData(5000);
+	ms.Write(data.size(), data.data());
+	BlockCache cache(64 * 1024, 1024, 4);
+	CachedStream cs(ms, cache);
+
+	uint8_t buf[16];
+	cs.ReadAt(1020, 8, buf);
+	const uint8_t patch[8] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+	cs.WriteAt(1020, 8, patch);
+	cs.ReadAt(1020, 8, buf);
+	EXPECT_EQ(memcmp(buf, patch, 8), 0);
+
+	// 写入超出末尾后长度增长，原来不完整的最后一块重新读取
+	cs.ReadAt(4990, 10, buf);
+	cs.SetPosition(5000);
+	cs.Write(8, patch);
+	EXPECT_EQ(cs.GetLength(), 5008);
+	cs.ReadAt(4996, 12, buf);
+	EXPECT_EQ(memcmp(buf, data.data() + 4996, 4), 0);
+	EXPECT_EQ(memcmp(buf + 4, patch, 8), 0);
+}
+
+TEST(Utilities_CachedStream, Shared)
+{
+	MemoryStream ms;
+	auto data = MakeData(5000);
+	ms.Write(data.size(), data.data());
+	BlockCache cache(64 * 1024, 1024, 4);
+	CachedStream a(ms, cache);
+	{
+		CachedStream b(ms, cache);
+
+		// 包装同一个流的缓存流共享块，经过 a 写入后 b 不会读到过时的数据
+		uint8_t byte;
+		b.ReadAt(0, 1, &byte);
+		EXPECT_EQ(byte, data[0]);
+		a.WriteAt(0, 1, "X");
+		b.ReadAt(0, 1, &byte);
+		EXPECT_EQ(byte, 'X');
+		a.ReadAt(0, 1, &byte);
+		EXPECT_EQ(byte, 'X');
+		EXPECT_EQ(cache.GetStatistics().misses, 2);
+		EXPECT_EQ(cache.GetStatistics().hits, 1);
+
+		// 经过 b 增长的长度对 a 同样可见
+		b.WriteAt(5000, 4, "tail");
+		EXPECT_EQ(a.GetLength(), 5004);
+		a.SetPosition(5004);
+		a.Flush();
+	}
+
+	// b 关闭后 a 仍然使用原来的块
+	uint8_t byte;
+	a.ReadAt(0, 1, &byte);
+	EXPECT_EQ(cache.GetStatistics().hits, 2);
+
+	// 最后一个缓存流关闭时丢弃该流的块，重新包装后需要重新读取
+	a.Close();
+	CachedStream c(ms, cache);
+	c.ReadAt(0, 1, &byte);
+	EXPECT_EQ(byte, 'X');
+	EXPECT_EQ(cache.GetStatistics().misses, 3);
+}
+
+TEST(Utilities_CachedStream, Concurrent)
+{
+	auto data = MakeData(256 * 1024);
+	MemoryStream ms(data.data(), data.size());
+	BlockCache cache(64 * 1024, 4096);
+
+	std::vector<std::thread> threads;
+	std::vector<int> ok(4, 1);
+	for (auto t = 0; t < 4; t++)
+	{
+		threads.emplace_back([&, t]()
+		{
+			CachedStream cs(ms, cache);
+			std::mt19937 rng(t);
+			uint8_t buf[100];
+			for (auto i = 0; i < 5000; i++)
+			{
+				auto pos = rng() % (data.size() - sizeof(buf));
+				cs.ReadAt(pos, sizeof(buf), buf);
+				if (memcmp(buf, data.data() + pos, sizeof(buf)) != 0)
+					ok[t] = 0;
+			}
+		});
+	}
+	for (auto& thread : threads)
+		thread.join();
+	for (auto v : ok)
+		EXPECT_EQ(v, 1);
+}
@@ -0,0 +1,67 @@
+/**
+	 @file
+	 @brief 对通用模板库 Utilities::Common::ByteSwap 等字节序转换函数的单元测试
+
+	 @author 司马坑
+	 @date 2026/10/17
+*/
+#include <cstring>
+#include <vector>
+#include <gtest/gtest.h>
+#include <Utilities.Common.Endian.h>
+#pragma comment(lib,"E15Utilities.lib")
+
+using namespace std;
+using namespace Utilities::Common;
+
+/// <summary>
+/// 测试单个数值的转换
+/// </summary>
+TEST(Utilities_Common_Endian, Scalar)
+{
+	EXPECT_EQ(ByteSwap<uint16_t>(0x1234), 0x3412);
+	EXPECT_EQ(ByteSwap<uint32_t>(0x12345678u), 0x78563412u);
+	EXPECT_EQ(ByteSwap<uint64_t>(0x0102030405060708ull), 0x0807060504030201ull);
+	EXPECT_EQ(ByteSwap<int8_t>(-5), -5);
+	EXPECT_EQ(ByteSwap(ByteSwap(3.14159)), 3.14159);
+
+	const uint8_t be[4] = { 0x12, 0x34, 0x56, 0x78 };
+	uint32_t v;
+	memcpy(&v, be, 4);
+	EXPECT_EQ(ConvertEndian<Endian::Big>(v), 0x12345678u);
+	EXPECT_EQ(ConvertEndian<Endian::Native>(v), v);
+}
+
+/// <summary>
+/// 测试批量转换，覆盖向量宽度的边界和未对齐的地址
+/// </summary>
+TEST(Utilities_Common_Endian, Buffer)
+{
+	for (size_t elementSize : { 2, 3, 4, 8 })
+	{
+		for (size_t count : { 0, 1, 7, 8, 15, 16, 17, 33, 64, 1000 })
+		{
+			vector<uint8_t> src(count * elementSize + 1), dst(src.size()), expect(count * elementSize);
+			for (size_t i = 0; i < src.size(); i++)
+				src[i] = static_cast<uint8_t>(i * 7 + elementSize);
+			for (size_t i = 0; i < count; i++)
+				for (size_t b = 0; b < elementSize; b++)
+					expect[i * elementSize + b] = src[1 + i * elementSize + elementSize - 1 - b];
+
+			ByteSwapBuffer(dst.data() + 1, src.data() + 1, count, elementSize);
+			EXPECT_TRUE(expect.empty() || memcmp(dst.data() + 1, expect.data(), expect.size()) == 0);
+
+			ByteSwapBuffer(src.data() + 1, src.data() + 1, count, elementSize);
+			EXPECT_TRUE(expect.empty() || memcmp(src.data() + 1, expect.data(), expect.size()) == 0);
+		}
+	}
+
+	vector<uint32_t> a(100);
+	for (uint32_t i = 0; i < 100; i++)
+		a[i] = i * 0x01010101u;
+	ConvertEndianArray<Endian::Native>(a.data(), a.size());
+	EXPECT_EQ(a[3], 0x03030303u);
+	a[3] = 0x11223344u;
+	ByteSwapArray(a.data(), a.size());
+	EXPECT_EQ(a[3], 0x44332211u);
+}
@@ -0,0 +1,94 @@
+/**
+	 @file
+	 @brief 对通用模板库 Utilities::Common 文本格式化函数的单元测试
+
+	 @author 司马坑
+	 @date 2026/10/17
+*/
+#include <string>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <Utilities.Common.Format.h>
+#pragma comment(lib,"E15Utilities.lib")
+
+using namespace Utilities;
+using namespace Utilities::Common;
+
+namespace
+{
+	template<typename... Args>
+	std::string Format(std::string_view format, const Args&... args)
+	{
+		std::string result;
+		const FormatArg list[] = { FormatArg(args)..., FormatArg() };
+		FormatTo(format, list, sizeof...(Args), [](void* context, const char* data, size_t len)
+			{
+				static_cast<std::string*>(context)->append(data, len);
+			}, &result);
+		return result;
+	}
+}
+
+/// <summary>
+/// 测试数值格式化
+/// </summary>
+TEST(Utilities_Common_Format, Number)
+{
+	char buf[MaxNumberChars];
+	EXPECT_EQ(std::string(buf, FormatInt(buf, 0)), "0");
+	EXPECT_EQ(std::string(buf, FormatInt(buf, INT64_MIN)), "-9223372036854775808");
+	EXPECT_EQ(std::string(buf, FormatInt(buf, UINT64_MAX)), "18446744073709551615");
+
+	EXPECT_EQ(std::string(buf, FormatHex(buf, 0x414fa339u, 8)), "414fa339");
+	EXPECT_EQ(std::string(buf, FormatHex(buf, 0xABu, 6, true)), "0000AB");
+	EXPECT_EQ(std::string(buf, FormatHex(buf, uint8_t(5), 8)), "05");
+	EXPECT_EQ(std::string(buf, FormatHex(buf, int16_t(-1))), "ffff");
+	EXPECT_EQ(std::string(buf, FormatHex(buf, 0)), "0");
+
+	EXPECT_EQ(std::string(buf, FormatFloat(buf, 0.1)), "0.1");
+	EXPECT_EQ(std::string(buf, FormatFloat(buf, 0.1f)), "0.1");
+	EXPECT_EQ(std::string(buf, FormatFloat(buf, -1.7976931348623157e308)), "-1.7976931348623157e+308");
+	EXPECT_EQ(std::string(buf, FormatFloat(buf, 3.14159, 2)), "3.14");
+	EXPECT_EQ(std::string(buf, FormatFloat(buf, 2.5, 0)), "2");
+	auto end = FormatFloat(buf, 1e300, 17);
+	EXPECT_LE(end - buf, MaxNumberChars);
+	EXPECT_EQ(std::stod(std::string(buf, end)), 1e300);
+}
+
+/// <summary>
+/// 测试格式字符串
+/// </summary>
+TEST(Utilities_Common_Format, Format)
+{
+	std::string name = "apple";
+	EXPECT_EQ(Format("{},{},{:.2}", 42, name, 3.5), "42,apple,3.50");
+	EXPECT_EQ(Format("{{{}}} {:x} {:X} {}", 'c', 255, uint16_t(0xBEEF), true), "{c} ff BEEF true");
+	EXPECT_EQ(Format("no args"), "no args");
+	EXPECT_EQ(Format("{}{}", std::string_view("ab"), -7ll), "ab-7");
+
+	// 超过内部缓冲区的输出
+	std::string longText(2000, 'x');
+	auto result = Format("[{}]{}", longText, 1);
+	EXPECT_EQ(result, "[" + longText + "]1");
+	std::string many;
+	std::string expect;
+	FormatArg args[300];
+	for (int i = 0; i < 300; i++)
+	{
+		many += "{} ";
+		expect += std::to_string(i * 1000003) + " ";
+		args[i] = FormatArg(i * 1000003);
+	}
+	result.clear();
+	FormatTo(many, args, 300, [](void* context, const char* data, size_t len)
+		{
+			static_cast<std::string*>(context)->append(data, len);
+		}, &result);
+	EXPECT_EQ(result, expect);
+
+	EXPECT_THROW(Format("{}"), Exception);
+	EXPECT_THROW(Format("{", 1), Exception);
+	EXPECT_THROW(Format("}", 1), Exception);
+	EXPECT_THROW(Format("{:q}", 1), Exception);
+	EXPECT_THROW(Format("{:x}", 1.5), Exception);
+}
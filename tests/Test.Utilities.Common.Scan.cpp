@@ -0,0 +1,65 @@
+/**
+	 @file
+	 @brief 对通用模板库 Utilities::Common 字节查找的单元测试
+
+	 @author 司马坑
+	 @date 2026/10/17
+*/
+#include <cstring>
+#include <vector>
+#include <random>
+#include <gtest/gtest.h>
+#include <Utilities.Common.Scan.h>
+#pragma comment(lib,"E15Utilities.lib")
+
+using namespace std;
+using namespace Utilities::Common;
+
+/// <summary>
+/// 测试各种长度与对齐下的查找结果与 memchr 一致
+/// </summary>
+TEST(Utilities_Common_Scan, FindByte)
+{
+	vector<char> text(300);
+	for (size_t offset = 0; offset < 4; offset++)
+	{
+		for (size_t len = 0; len + offset <= text.size(); len += 7)
+		{
+			auto first = text.data() + offset;
+			auto last = first + len;
+			memset(text.data(), 'a', text.size());
+			EXPECT_EQ(FindByte(first, last, '\n'), last);
+			for (size_t pos = 0; pos < len; pos += 5)
+			{
+				memset(text.data(), 'a', text.size());
+				first[pos] = '\n';
+				if (pos + 3 < len)
+					first[pos + 3] = '\n';
+				EXPECT_EQ(FindByte(first, last, '\n'), first + pos);
+			}
+		}
+	}
+	// 查找范围之外的字节不应被命中
+	memset(text.data(), 'a', text.size());
+	text[100] = '\n';
+	EXPECT_EQ(FindByte(text.data(), text.data() + 100, '\n'), text.data() + 100);
+	EXPECT_EQ(FindByte(text.data(), text.data(), '\n'), text.data());
+}
+
+/// <summary>
+/// 测试随机数据与高位字节
+/// </summary>
+TEST(Utilities_Common_Scan, Random)
+{
+	mt19937 rng(42);
+	vector<char> text(4096);
+	for (auto& c : text)
+		c = static_cast<char>(rng());
+	for (int value = 0; value < 256; value++)
+	{
+		auto c = static_cast<char>(value);
+		auto hit = memchr(text.data(), c, text.size());
+		auto expect = hit ? static_cast<const char*>(hit) : text.data() + text.size();
+		EXPECT_EQ(FindByte(text.data(), text.data() + text.size(), c), expect);
+	}
+}
@@ -0,0 +1,86 @@
+/**
+	 @file
+	 @brief 对通用模板库 Utilities::Common 变长整数编码的单元测试
+
+	 @author 司马坑
+	 @date 2026/10/17
+*/
+#include <vector>
+#include <random>
+#include <gtest/gtest.h>
+#include <Utilities.Common.Varint.h>
+#pragma comment(lib,"E15Utilities.lib")
+
+using namespace std;
+using namespace Utilities;
+using namespace Utilities::Common;
+
+/// <summary>
+/// 测试单个数值的编码与 zigzag 映射
+/// </summary>
+TEST(Utilities_Common_Varint, Encode)
+{
+	uint8_t buf[MaxVarintLength];
+	EXPECT_EQ(EncodeVarint(0, buf), 1);
+	EXPECT_EQ(EncodeVarint(127, buf), 1);
+	EXPECT_EQ(EncodeVarint(300, buf), 2);
+	EXPECT_EQ(buf[0], 0xAC);
+	EXPECT_EQ(buf[1], 0x02);
+	EXPECT_EQ(EncodeVarint(UINT64_MAX, buf), MaxVarintLength);
+	EXPECT_EQ(buf[9], 0x01);
+
+	EXPECT_EQ(ZigZagEncode(0), 0);
+	EXPECT_EQ(ZigZagEncode(-1), 1);
+	EXPECT_EQ(ZigZagEncode(1), 2);
+	EXPECT_EQ(ZigZagEncode(INT64_MIN), UINT64_MAX);
+	EXPECT_EQ(ZigZagDecode(ZigZagEncode(INT64_MIN)), INT64_MIN);
+	EXPECT_EQ(ZigZagDecode(ZigZagEncode(-123456789)), -123456789);
+
+	EXPECT_EQ(FromVarint<int8_t>(ToVarint<int8_t>(-128)), -128);
+	EXPECT_THROW(FromVarint<uint8_t>(256), Exception);
+	EXPECT_THROW(FromVarint<int16_t>(ToVarint<int32_t>(-40000)), Exception);
+}
+
+/// <summary>
+/// 测试批量解码，混合各种长度并在任意位置截断
+/// </summary>
+TEST(Utilities_Common_Varint, Decode)
+{
+	mt19937_64 random(42);
+	vector<uint64_t> values;
+	for (size_t i = 0; i < 5000; i++)
+	{
+		// 大部分是小数值，夹杂各种长度
+		auto bits = i % 7 == 0 ? random() % 65 : random() % 8;
+		values.push_back(bits == 0 ? 0 : bits == 64 ? random() : random() & ((1ull << bits) - 1));
+	}
+	vector<uint8_t> encoded;
+	for (auto v : values)
+	{
+		uint8_t buf[MaxVarintLength];
+		encoded.insert(encoded.end(), buf, buf + EncodeVarint(v, buf));
+	}
+
+	vector<uint64_t> decoded(values.size());
+	size_t consumed;
+	EXPECT_EQ(DecodeVarints(encoded.data(), encoded.size(), decoded.data(), decoded.size(), consumed), values.size());
+	EXPECT_EQ(consumed, encoded.size());
+	EXPECT_EQ(decoded, values);
+
+	// 截断的数据只解出完整的部分，剩余部分补齐后可以继续
+	for (size_t cut : { size_t(1), size_t(17), encoded.size() / 3, encoded.size() - 1 })
+	{
+		fill(decoded.begin(), decoded.end(), 0);
+		auto n = DecodeVarints(encoded.data(), cut, decoded.data(), decoded.size(), consumed);
+		EXPECT_LE(consumed, cut);
+		auto m = DecodeVarints(encoded.data() + consumed, encoded.size() - consumed, decoded.data() + n, decoded.size() - n, consumed);
+		EXPECT_EQ(n + m, values.size());
+		EXPECT_EQ(decoded, values);
+	}
+
+	// count 限制解码个数
+	EXPECT_EQ(DecodeVarints(encoded.data(), encoded.size(), decoded.data(), 3, consumed), 3);
+
+	const uint8_t overlong[11] = { 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x02, 0x00 };
+	EXPECT_THROW(DecodeVarints(overlong, sizeof(overlong), decoded.data(), 1, consumed), Exception);
+}
@@ -0,0 +1,168 @@
+/**
+ @file
+ @brief 对 Utilities::Coroutine 以及 CoStreamReader / CoStreamWriter 进行单元测试
+
+ 这个文件里面是通过几组函数对协程任务、调度器以及可等待的流读写器进行功能上的单元测试
+
+ @author 司马坑
+ @date 2026/10/17
+*/
+#define _CRT_SECURE_NO_WARNINGS
+
+#include <string>
+#include <cstring>
+#include <ctime>
+#include <vector>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include <Utilities.CoStream.h>
+#pragma comment(lib,"E15Utilities.lib")
+
+#ifdef UTILITIES_HAS_COROUTINE
+using namespace std;
+using namespace Utilities;
+using namespace Utilities::Coroutine;
+
+static Task<int> Add(Executor& ex, int a, int b)
+{
+	co_await ex.Schedule();
+	co_return a + b;
+}
+
+static Task<void> Sum(Executor& ex, int n, int& result)
+{
+	for (int i = 0; i < n; i++)
+		result = co_await Add(ex, result, i);
+}
+
+static Task<void> Fail()
+{
+	throw Exception(u8"Error occured when testing : Expected");
+	co_return;
+}
+
+/// <summary>
+/// 测试任务的嵌套等待以及异常传递
+/// </summary>
+TEST(Utilities_Coroutine, Task)
+{
+	Executor ex;
+	int a = 0, b = 0;
+	ex.Spawn(Sum(ex, 100, a));
+	ex.Spawn(Sum(ex, 10, b));
+	ex.Run();
+	EXPECT_EQ(a, 4950);
+	EXPECT_EQ(b, 45);
+
+	ex.Spawn(Fail());
+	EXPECT_THROW(ex.Run(), Exception);
+}
+
+static Task<void> WriteFile(Executor& ex, FileStream& fs, uint32_t count, AsyncIOEngine& engine = AsyncIOEngine::Default())
+{
+	CoStreamWriter sw(fs, ex, 256, engine);
+	co_await sw.Write(count);
+	for (uint32_t i = 0; i < count; i++)
+		co_await sw.Write(i);
+	vector<uint32_t> tail(1000, 0xDEADBEEF);
+	co_await sw.WriteArray(tail.data(), tail.size());
+	co_await sw.Flush();
+}
+
+static Task<void> ReadFile(Executor& ex, FileStream& fs, bool& ok, AsyncIOEngine& engine = AsyncIOEngine::Default())
+{
+	CoStreamReader sr(fs, ex, 256, engine);
+	auto count = co_await sr.Read<uint32_t>();
+	ok = true;
+	for (uint32_t i = 0; i < count; i++)
+		ok = ok && co_await sr.Read<uint32_t>() == i;
+	vector<uint32_t> tail(1000);
+	co_await sr.ReadArray(Common::Span<uint32_t>(tail));
+	ok = ok && tail == vector<uint32_t>(1000, 0xDEADBEEF);
+
+	// 读到文件末尾时在 co_await 处抛出异常
+	bool eof = false;
+	try
+	{
+		co_await sr.Read<uint8>();
+	}
+	catch (const Exception&)
+	{
+		eof = true;
+	}
+	ok = ok && eof;
+}
+
+/// <summary>
+/// 测试多个协程在少量线程上并发读写文件
+/// </summary>
+TEST(Utilities_Coroutine, Stream)
+{
+	const auto fileCount = 16;
+	vector<wstring> names;
+	for (auto i = 0; i < fileCount; i++)
+	{
+		wchar_t fileName[L_tmpnam];
+		_wtmpnam(fileName);
+		names.push_back(fileName);
+	}
+
+	Executor ex;
+	{
+		vector<unique_ptr<FileStream>> files;
+		for (auto i = 0; i < fileCount; i++)
+		{
+			files.push_back(make_unique<FileStream>(names[i].c_str(), Stream::Type::WriteOnly, false));
+			ex.Spawn(WriteFile(ex, *files.back(), 500 + i * 100));
+		}
+		ex.Run();
+	}
+
+	vector<unique_ptr<FileStream>> files;
+	bool ok[fileCount] = {};
+	for (auto i = 0; i < fileCount; i++)
+	{
+		files.push_back(make_unique<FileStream>(names[i].c_str(), Stream::Type::ReadOnly, false));
+		ex.Spawn(ReadFile(ex, *files.back(), ok[i]));
+	}
+	// 两个线程共同驱动同一个调度器
+	thread helper([&ex]() { ex.Run(); });
+	ex.Run();
+	helper.join();
+	for (auto i = 0; i < fileCount; i++)
+		EXPECT_TRUE(ok[i]);
+}
+/// <summary>
+/// 测试队列深度远小于并发协程数时，后续请求在调度器线程上发起，不会阻塞 IO 引擎的完成线程
+/// </summary>
+TEST(Utilities_Coroutine, SmallQueue)
+{
+	const auto fileCount = 8;
+	AsyncIOEngine engine(1, 1);
+	Executor ex;
+	vector<wstring> names;
+	vector<unique_ptr<FileStream>> files;
+	for (auto i = 0; i < fileCount; i++)
+	{
+		wchar_t fileName[L_tmpnam];
+		_wtmpnam(fileName);
+		names.push_back(fileName);
+		files.push_back(make_unique<FileStream>(fileName, Stream::Type::WriteOnly, false));
+		ex.Spawn(WriteFile(ex, *files.back(), 300 + i * 50, engine));
+	}
+	ex.Run();
+
+	files.clear();
+	bool ok[fileCount] = {};
+	for (auto i = 0; i < fileCount; i++)
+	{
+		files.push_back(make_unique<FileStream>(names[i].c_str(), Stream::Type::ReadOnly, false));
+		ex.Spawn(ReadFile(ex, *files.back(), ok[i], engine));
+	}
+	ex.Run();
+	for (auto i = 0; i < fileCount; i++)
+		EXPECT_TRUE(ok[i]);
+}
+#endif
@@ -0,0 +1,134 @@
+/**
+ @file
+ @brief 对 Utilities::CsvReader 进行单元测试
+
+ @author 司马坑
+ @date 2026/10/17
+*/
+#include <string>
+#include <vector>
+#include <random>
+#include <gtest/gtest.h>
+#include <Utilities.CsvReader.h>
+#include <Utilities.MemoryStream.h>
+
+#pragma comment(lib,"E15Utilities.lib")
+
+using namespace Utilities;
+
+namespace
+{
+	using Rows = std::vector<std::vector<std::string>>;
+
+	/// <summary>
+	/// 每次 ReadSome 只返回几个字节的流，用于测试跨越多次填充的行与字段
+	/// </summary>
+	class TrickleStream : public Stream
+	{
+	public:
+		TrickleStream(const std::string& text) : Stream(Type::ReadOnly), text(text) { }
+		virtual void Read(size_t len, void* data) override
+		{
+			if (ReadSome(len, data) != len)
+				throw Exception(u8"Error occured when reading stream : End_Of_Stream");
+		}
+		virtual void Write(size_t, const void*) override { }
+		virtual void Close() override { }
+		virtual bool IsVaild() override { return true; }
+		virtual size_t ReadSome(size_t maxLen, void* data) override
+		{
+			auto len = std::min({ maxLen, text.size() - position, static_cast<size_t>(rng() % 97 + 1) });
+			memcpy(data, text.data() + position, len);
+			position += len;
+			return len;
+		}
+	private:
+		std::string text;
+		size_t position = 0;
+		std::mt19937 rng{ 7 };
+	};
+
+	Rows ReadAll(CsvReader& csv)
+	{
+		Rows rows;
+		while (auto row = csv.ReadRow())
+			rows.emplace_back(row->begin(), row->end());
+		return rows;
+	}
+
+	Rows Parse(const std::string& text, char delimiter = ',', char quote = '"')
+	{
+		MemoryStream ms(text.data(), text.size());
+		CsvReader csv(ms, delimiter, quote);
+		return ReadAll(csv);
+	}
+}
+
+TEST(Utilities_CsvReader, Default)
+{
+	EXPECT_EQ(Parse("a,b,c\n1,2,3\n"), (Rows{ { "a", "b", "c" }, { "1", "2", "3" } }));
+	// 最后一行没有换行符、CRLF、空字段与空行
+	EXPECT_EQ(Parse("a,,c\r\n\r\n,\nlast"), (Rows{ { "a", "", "c" }, { "" }, { "", "" }, { "last" } }));
+	EXPECT_EQ(Parse(""), Rows{});
+
+	// TSV 不处理引号
+	EXPECT_EQ(Parse("a\t\"b\tc\n", '\t', '\0'), (Rows{ { "a", "\"b", "c" } }));
+}
+
+TEST(Utilities_CsvReader, Quote)
+{
+	EXPECT_EQ(Parse("\"a,b\",\"say \"\"hi\"\"\"\r\n\"multi\nline\",\"\"\n"),
+		(Rows{ { "a,b", "say \"hi\"" }, { "multi\nline", "" } }));
+	EXPECT_EQ(Parse("\"\"\"\"\n"), (Rows{ { "\"" } }));
+	EXPECT_THROW(Parse("a,\"unterminated\n"), Exception);
+}
+
+TEST(Utilities_CsvReader, Large)
+{
+	// 随机生成包含各种边界情况的字段，与期望结果逐行比较
+	std::mt19937 rng(42);
+	const char alphabet[] = "abc,\"\n\r ";
+	Rows expect;
+	std::string text;
+	for (auto r = 0; r < 5000; r++)
+	{
+		std::vector<std::string> row;
+		auto count = rng() % 6 + 1;
+		for (size_t f = 0; f < count; f++)
+		{
+			std::string field;
+			auto length = rng() % 20 == 0 ? rng() % 300 : rng() % 12;
+			for (size_t i = 0; i < length; i++)
+				field += alphabet[rng() % (sizeof(alphabet) - 1)];
+			bool quoted = field.find_first_of(",\"\n\r") != std::string::npos;
+			if (quoted)
+			{
+				text += '"';
+				for (auto c : field)
+				{
+					if (c == '"')
+						text += '"';
+					text += c;
+				}
+				text += '"';
+			}
+			else
+				text += field;
+			if (f + 1 != count)
+				text += ',';
+			row.push_back(field);
+		}
+		text += rng() % 2 ? "\r\n" : "\n";
+		expect.push_back(row);
+	}
+	// 超过初始缓冲区大小的一个字段
+	expect.push_back({ std::string(200000, 'x'), "y" });
+	text += expect.back()[0] + ",y";
+
+	EXPECT_EQ(Parse(text), expect);
+
+	TrickleStream ts(text);
+	CsvReader csv(ts);
+	EXPECT_EQ(ReadAll(csv), expect);
+	EXPECT_EQ(csv.GetRowCount(), expect.size());
+}
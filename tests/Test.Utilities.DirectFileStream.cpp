@@ -0,0 +1,117 @@
+/**
+ @file
+ @brief 对 Utilities::DirectFileStream 进行单元测试
+
+ 这个文件里面是通过几组函数对 Utilities::DirectFileStream 进行功能上的单元测试
+
+ @author 司马坑
+ @date 2026/10/17
+*/
+#define _CRT_SECURE_NO_WARNINGS
+
+#include <string>
+#include <cstring>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <Utilities.DirectFileStream.h>
+#include <Utilities.FileStream.h>
+#include <Utilities.StreamWriter.h>
+#include <Utilities.StreamReader.h>
+#include <Utilities.Common.AlignedAllocator.h>
+#pragma comment(lib,"E15Utilities.lib")
+
+using namespace std;
+using namespace Utilities;
+
+/// <summary>
+/// 测试对齐分配器
+/// </summary>
+TEST(Utilities_DirectFileStream, AlignedAllocator)
+{
+	Common::AlignedVector<uint8> block(10000);
+	EXPECT_EQ(reinterpret_cast<uintptr_t>(block.data()) % 4096, 0);
+	Common::AlignedVector<double, 64> v;
+	for (auto i = 0; i < 1000; i++)
+	{
+		v.push_back(i);
+		ASSERT_EQ(reinterpret_cast<uintptr_t>(v.data()) % 64, 0);
+	}
+	Common::Span<const double> s = v;
+	EXPECT_EQ(s.size(), 1000);
+}
+
+/// <summary>
+/// 测试不对齐的小块写入以及尾部截断
+/// </summary>
+TEST(Utilities_DirectFileStream, Write)
+{
+	wchar_t fileName[L_tmpnam];
+	_wtmpnam(fileName);
+
+	const uint32_t count = 5000;
+	{
+		DirectFileStream fs(fileName, Stream::Type::WriteOnly, 8192);
+		auto sw = StreamWriter(fs);
+		sw.Write<uint8>(0xAB);
+		for (uint32_t i = 0; i < count; i++)
+			sw.Write<uint32_t>(i);
+		EXPECT_EQ(fs.GetLength(), 1 + count * sizeof(uint32_t));
+	}
+
+	FileStream rs(fileName, Stream::Type::ReadOnly, false);
+	EXPECT_EQ(rs.GetLength(), 1 + count * sizeof(uint32_t));
+	auto sr = StreamReader(rs);
+	EXPECT_EQ(sr.Read<uint8>(), 0xAB);
+	for (uint32_t i = 0; i < count; i++)
+		ASSERT_EQ(sr.Read<uint32_t>(), i);
+}
+
+/// <summary>
+/// 测试对齐的大块读写绕过内部缓冲区，以及随机位置的改写
+/// </summary>
+TEST(Utilities_DirectFileStream, ReadWrite)
+{
+	wchar_t fileName[L_tmpnam];
+	_wtmpnam(fileName);
+
+	const size_t bufferSize = 16384;
+	Common::AlignedVector<uint8> block(bufferSize * 3);
+	for (size_t i = 0; i < block.size(); i++)
+		block[i] = static_cast<uint8>(i * 7);
+
+	DirectFileStream fs(fileName, Stream::Type::ReadWrite, bufferSize);
+	fs.Write(block.size(), block.data());
+	fs.Write(3, "xyz");
+	EXPECT_EQ(fs.GetLength(), block.size() + 3);
+
+	// 改写跨越扇区边界的不对齐区域
+	fs.SetPosition(4090);
+	fs.Write(12, "hello world!");
+	fs.Flush();
+
+	fs.SetPosition(0);
+	Common::AlignedVector<uint8> cmp(block.size() + 3);
+	fs.Read(cmp.size(), cmp.data());
+	memcpy(block.data() + 4090, "hello world!", 12);
+	EXPECT_EQ(memcmp(cmp.data(), block.data(), block.size()), 0);
+	EXPECT_EQ(memcmp(cmp.data() + block.size(), "xyz", 3), 0);
+
+	char c;
+	EXPECT_THROW(fs.Read(1, &c), Exception);
+	EXPECT_EQ(fs.ReadSome(1, &c), 0);
+
+	// 越过末尾写入时中间以 0 填充
+	fs.SetPosition(fs.GetLength() + 10000);
+	fs.Write(1, "!");
+	fs.Close();
+
+	FileStream rs(fileName, Stream::Type::ReadOnly, false);
+	EXPECT_EQ(rs.GetLength(), block.size() + 3 + 10001);
+	rs.SetPosition(block.size() + 3 + 9999);
+	char tail[2];
+	rs.Read(2, tail);
+	EXPECT_EQ(tail[0], 0);
+	EXPECT_EQ(tail[1], '!');
+}
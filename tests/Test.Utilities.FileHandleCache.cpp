@@ -0,0 +1,162 @@
+/**
+ @file
+ @brief 对 Utilities::FileHandleCache 进行单元测试
+
+ @author 司马坑
+ @date 2026/10/17
+*/
+#include <string>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+#include <Utilities.FileHandleCache.h>
+
+#pragma comment(lib,"E15Utilities.lib")
+
+using namespace Utilities;
+
+namespace
+{
+	std::wstring MakeTempFile(const std::string& text)
+	{
+		wchar_t fileName[L_tmpnam];
+		_wtmpnam(fileName);
+		FileStream fs(fileName, Stream::Type::WriteOnly, false);
+		fs.Write(text.size(), text.data());
+		return fileName;
+	}
+}
+
+TEST(Utilities_FileHandleCache, Default)
+{
+	auto a = MakeTempFile("aaaa");
+	auto b = MakeTempFile("bbbb");
+	FileHandleCache cache(2);
+	char buffer[4];
+
+	FileStream* first;
+	{
+		auto lease = cache.Acquire(a.c_str(), Stream::Type::ReadOnly, false);
+		first = &lease.Get();
+		lease->ReadAt(0, 4, buffer);
+		EXPECT_EQ(std::string(buffer, 4), std::string("aaaa"));
+	}
+	{
+		// 归还后再次租借复用同一个文件流
+		auto lease = cache.Acquire(a.c_str(), Stream::Type::ReadOnly, false);
+		EXPECT_EQ(&*lease, first);
+
+		// 同一个文件正在被租借时打开新的文件流
+		auto other = cache.Acquire(a.c_str(), Stream::Type::ReadOnly, false);
+		EXPECT_NE(&*other, first);
+		EXPECT_EQ(cache.GetOpenCount(), 2);
+	}
+	auto statistics = cache.GetStatistics();
+	EXPECT_EQ(statistics.hits, 1);
+	EXPECT_EQ(statistics.misses, 2);
+	EXPECT_EQ(cache.GetOpenCount(), 2);
+
+	// 不同的操作类型使用不同的文件流，超过容量时关闭最久未使用的
+	{
+		auto lease = cache.Acquire(b.c_str(), Stream::Type::ReadOnly, false);
+		lease->ReadAt(0, 4, buffer);
+		EXPECT_EQ(std::string(buffer, 4), std::string("bbbb"));
+		EXPECT_EQ(cache.GetOpenCount(), 2);
+		auto rw = cache.Acquire(b.c_str(), Stream::Type::ReadWrite, false);
+		rw->WriteAt(0, 2, "BB");
+	}
+	EXPECT_EQ(cache.GetStatistics().evictions, 2);
+	EXPECT_EQ(cache.GetOpenCount(), 2);
+	{
+		auto lease = cache.Acquire(b.c_str(), Stream::Type::ReadOnly, false);
+		lease->ReadAt(0, 4, buffer);
+		EXPECT_EQ(std::string(buffer, 4), std::string("BBbb"));
+	}
+	EXPECT_EQ(cache.GetStatistics().hits, 2);
+
+	// 失效后重新打开
+	cache.Invalidate(b.c_str());
+	EXPECT_EQ(cache.GetOpenCount(), 0);
+	{
+		auto lease = cache.Acquire(b.c_str(), Stream::Type::ReadOnly, false);
+		cache.Invalidate(b.c_str());
+		EXPECT_EQ(cache.GetOpenCount(), 1);
+	}
+	// 租借期间失效的文件流在归还时关闭
+	EXPECT_EQ(cache.GetOpenCount(), 0);
+	EXPECT_THROW(cache.Acquire(L"/nonexistent/file", Stream::Type::ReadOnly, false), Exception);
+	EXPECT_EQ(cache.GetOpenCount(), 0);
+
+	// 移动与提前归还
+	auto lease = cache.Acquire(a.c_str(), Stream::Type::ReadOnly, false);
+	auto moved = std::move(lease);
+	moved.Release();
+	EXPECT_EQ(cache.GetOpenCount(), 1);
+	cache.Clear();
+	EXPECT_EQ(cache.GetOpenCount(), 0);
+}
+
+TEST(Utilities_FileHandleCache, Reuse)
+{
+	auto a = MakeTempFile("0123456789");
+	FileHandleCache cache(4);
+	char buffer[10];
+	{
+		auto lease = cache.Acquire(a.c_str(), Stream::Type::ReadOnly, false);
+		lease->Read(10, buffer);
+	}
+	{
+		// 复用的文件流从文件开头开始读取
+		auto lease = cache.Acquire(a.c_str(), Stream::Type::ReadOnly, false);
+		EXPECT_EQ(cache.GetStatistics().hits, 1);
+		EXPECT_EQ(lease->GetPosition(), 0);
+		lease->Read(4, buffer);
+		EXPECT_EQ(std::string(buffer, 4), std::string("0123"));
+	}
+
+	// 只写的文件流每次都重新打开并截断文件
+	{
+		auto lease = cache.Acquire(a.c_str(), Stream::Type::WriteOnly, false);
+		lease->Write(10, "AAAAAAAAAA");
+	}
+	EXPECT_EQ(cache.GetOpenCount(), 1);
+	{
+		auto lease = cache.Acquire(a.c_str(), Stream::Type::WriteOnly, false);
+		lease->Write(2, "BB");
+	}
+	EXPECT_EQ(cache.GetStatistics().hits, 1);
+	FileStream fs(a.c_str(), Stream::Type::ReadOnly, false);
+	EXPECT_EQ(fs.GetLength(), 2);
+	fs.Read(2, buffer);
+	EXPECT_EQ(std::string(buffer, 2), std::string("BB"));
+}
+
+TEST(Utilities_FileHandleCache, Concurrent)
+{
+	std::vector<std::wstring> files;
+	for (int i = 0; i < 16; i++)
+		files.push_back(MakeTempFile(std::to_string(i * 1111 % 10000 + 10000)));
+
+	FileHandleCache cache(8);
+	std::vector<std::thread> threads;
+	for (int t = 0; t < 4; t++)
+	{
+		threads.emplace_back([&, t]() {
+			char buffer[5];
+			for (int i = 0; i < 2000; i++)
+			{
+				// 大部分访问集中在前 4 个文件
+				auto index = i % 5 == 0 ? (i * 7 + t) % 16 : (i + t) % 4;
+				auto lease = cache.Acquire(files[index].c_str(), Stream::Type::ReadOnly, false);
+				lease->ReadAt(0, 5, buffer);
+				EXPECT_EQ(std::string(buffer, 5), std::to_string(index * 1111 % 10000 + 10000));
+			}
+		});
+	}
+	for (auto& thread : threads)
+		thread.join();
+	auto statistics = cache.GetStatistics();
+	EXPECT_EQ(statistics.hits + statistics.misses, 8000);
+	EXPECT_GT(statistics.hits, statistics.misses);
+	EXPECT_LE(cache.GetOpenCount(), 8);
+}
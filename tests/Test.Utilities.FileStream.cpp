@@ -10,10 +10,14 @@
 #define _CRT_SECURE_NO_WARNINGS
 
 #include <string> 
+#include <vector>
+#include <thread>
+#include <atomic>
 
 #include <gtest/gtest.h>
 
 #include <Utilities.FileStream.h>
+#include <Utilities.MemoryStream.h>
 #pragma comment(lib,"E15Utilities.lib")
 
 using namespace std;
@@ -30,8 +34,11 @@ TEST(Utilities_FileStream, Creat)
 	_wtmpnam(fileName);
 	FileStream fs = FileStream(fileName, Stream::Type::WriteOnly);
 	EXPECT_NE(nullptr, fs.GetHandle());
+	EXPECT_GE(fs.GetDescriptor(), 0);
 	
 	fs.Close();
+	EXPECT_EQ(nullptr, fs.GetHandle());
+	EXPECT_EQ(fs.GetDescriptor(), -1);
 	// 判断文件是否存在
 	// https://docs.microsoft.com/en-us/cpp/c-runtime-library/reference/access-waccess?view=vs-2019
 	EXPECT_EQ(_waccess(fileName, 0), 0);
@@ -108,4 +115,186 @@ TEST(Utilities_FileStream, Length)
 
 	auto fs = FileStream(fileName, Stream::Type::ReadOnly, false);
 	EXPECT_EQ(fs.GetLength(), size);	
-}
\ No newline at end of file
+}
+
+/// <summary>
+/// 测试文件流的分散读取与聚集写入功能
+/// </summary>
+TEST(Utilities_FileStream, Vectored)
+{
+	wchar_t fileName[L_tmpnam];
+	_wtmpnam(fileName);
+
+	const char header[] = "HEAD";
+	char payload[1000];
+	for (auto i = 0; i < 1000; i++)
+		payload[i] = static_cast<char>(rand() & 255);
+	const char trailer[] = "TAIL";
+
+	auto fs = FileStream(fileName, Stream::Type::WriteOnly, false);
+	fs.Write(1, "#");
+	Stream::ConstSegment out[] = { { header, 4 }, { payload, sizeof(payload) }, { trailer, 4 } };
+	fs.WriteV(3, out);
+	fs.Write(1, "#");
+	fs.Close();
+
+	auto rs = FileStream(fileName, Stream::Type::ReadOnly, false);
+	EXPECT_EQ(rs.GetLength(), 1010);
+	char c;
+	rs.Read(1, &c);
+	char h[4], p[1000], t[4];
+	Stream::Segment in[] = { { h, 4 }, { p, sizeof(p) }, { t, 4 } };
+	rs.ReadV(3, in);
+	EXPECT_EQ(memcmp(h, header, 4), 0);
+	EXPECT_EQ(memcmp(p, payload, sizeof(p)), 0);
+	EXPECT_EQ(memcmp(t, trailer, 4), 0);
+	EXPECT_EQ(rs.GetPosition(), 1009);
+	rs.Read(1, &c);
+	EXPECT_EQ(c, '#');
+	EXPECT_THROW(rs.ReadV(1, in), Exception);
+}
+
+/// <summary>
+/// 测试文件流的可读写模式
+/// </summary>
+TEST(Utilities_FileStream, ReadWrite)
+{
+	wchar_t fileName[L_tmpnam];
+	_wtmpnam(fileName);
+
+	auto fs = FileStream(fileName, Stream::Type::ReadWrite, false);
+	fs.Write(10, "0123456789");
+	fs.SetPosition(2);
+	char c[3];
+	fs.Read(3, c);
+	EXPECT_EQ(memcmp(c, "234", 3), 0);
+	fs.Write(2, "ab");
+	fs.SetPosition(0);
+	char all[10];
+	fs.Read(10, all);
+	EXPECT_EQ(memcmp(all, "01234ab789", 10), 0);
+	fs.Close();
+
+	// 再次打开时保留原有内容
+	auto rs = FileStream(fileName, Stream::Type::ReadWrite, false);
+	EXPECT_EQ(rs.GetLength(), 10);
+}
+
+/// <summary>
+/// 测试文件流的定位读写功能
+/// </summary>
+TEST(Utilities_FileStream, Positional)
+{
+	wchar_t fileName[L_tmpnam];
+	_wtmpnam(fileName);
+
+	const auto size = 4096;
+	std::vector<uint32_t> buf(size);
+	for (auto i = 0; i < size; i++)
+		buf[i] = i;
+
+	auto ws = FileStream(fileName, Stream::Type::WriteOnly, false);
+	ws.WriteAt(0, size * sizeof(uint32_t), buf.data());
+	ws.WriteAt(4, sizeof(uint32_t), &buf[100]);
+	EXPECT_EQ(ws.GetPosition(), 0);
+	ws.Close();
+
+	auto fs = FileStream(fileName, Stream::Type::ReadOnly, false);
+	std::vector<std::thread> workers;
+	std::atomic<int> errors = 0;
+	for (auto t = 0; t < 4; t++)
+		workers.emplace_back([&, t]()
+			{
+				for (auto i = 2 + t; i < size; i += 4)
+				{
+					uint32_t v;
+					fs.ReadAt(i * sizeof(uint32_t), sizeof(v), &v);
+					if (v != static_cast<uint32_t>(i))
+						errors++;
+				}
+			});
+	for (auto& w : workers)
+		w.join();
+	EXPECT_EQ(errors, 0);
+
+	uint32_t v;
+	fs.ReadAt(4, sizeof(v), &v);
+	EXPECT_EQ(v, 100);
+	EXPECT_EQ(fs.GetPosition(), 0);
+	EXPECT_THROW(fs.ReadAt(size * sizeof(uint32_t), sizeof(v), &v), Exception);
+}
+
+/// <summary>
+/// 测试访问方式提示不影响读取的数据
+/// </summary>
+TEST(Utilities_FileStream, Advise)
+{
+	wchar_t fileName[L_tmpnam];
+	_wtmpnam(fileName);
+
+	const auto size = 64 * 1024;
+	std::vector<uint8_t> buf(size);
+	for (auto i = 0; i < size; i++)
+		buf[i] = static_cast<uint8_t>(i * 7);
+	auto ws = FileStream(fileName, Stream::Type::WriteOnly, false);
+	ws.Write(size, buf.data());
+	ws.Close();
+
+	auto fs = FileStream(fileName, Stream::Type::ReadOnly, false);
+	fs.Advise(Stream::AccessHint::Sequential);
+	fs.Prefetch(size / 2, size / 2);
+	std::vector<uint8_t> cmp(size);
+	fs.Read(size / 2, cmp.data());
+	fs.Advise(Stream::AccessHint::DontNeed, 0, size / 2);
+	fs.Advise(Stream::AccessHint::Random);
+	fs.Read(size / 2, cmp.data() + size / 2);
+	EXPECT_EQ(cmp, buf);
+	fs.Advise(Stream::AccessHint::Normal);
+
+	fs.Close();
+	EXPECT_THROW(fs.Advise(Stream::AccessHint::WillNeed), Exception);
+	EXPECT_THROW(fs.Prefetch(0, 0), Exception);
+}
+
+/// <summary>
+/// 测试文件流之间以及文件流与内存流之间的复制
+/// </summary>
+TEST(Utilities_FileStream, CopyTo)
+{
+	wchar_t srcName[L_tmpnam];
+	_wtmpnam(srcName);
+	wchar_t dstName[L_tmpnam];
+	_wtmpnam(dstName);
+
+	const auto size = 200000;
+	std::vector<uint8> buf(size);
+	for (auto i = 0; i < size; i++)
+		buf[i] = static_cast<uint8>(i * 31);
+	MemoryStream ms(buf.data(), size);
+	{
+		auto ws = FileStream(srcName, Stream::Type::WriteOnly, false);
+		ms.CopyTo(ws, size);
+		EXPECT_EQ(ws.GetLength(), size);
+	}
+
+	auto rs = FileStream(srcName, Stream::Type::ReadOnly, false);
+	{
+		auto ws = FileStream(dstName, Stream::Type::WriteOnly, false);
+		ws.Write(3, "abc");
+		rs.SetPosition(10);
+		rs.CopyTo(ws, size - 10);
+		EXPECT_EQ(rs.GetPosition(), size);
+		EXPECT_EQ(ws.GetPosition(), size - 7);
+	}
+
+	auto cs = FileStream(dstName, Stream::Type::ReadOnly, false);
+	MemoryStream out;
+	cs.CopyTo(out, size - 7);
+	ASSERT_EQ(out.GetLength(), size - 7);
+	EXPECT_EQ(memcmp(out.View().data(), "abc", 3), 0);
+	EXPECT_EQ(memcmp(out.View().data() + 3, buf.data() + 10, size - 10), 0);
+
+	// 剩余数据不足时抛出异常
+	cs.SetPosition(size - 8);
+	EXPECT_THROW(cs.CopyTo(out, 2), Exception);
+}
@@ -0,0 +1,71 @@
+/**
+ @file
+ @brief 对 Utilities::HashingStream 进行单元测试
+
+ 这个文件里面是通过几组函数对 Utilities::HashingStream 进行功能上的单元测试
+
+ @author 司马坑
+ @date 2026/10/17
+*/
+#define _CRT_SECURE_NO_WARNINGS
+
+#include <string>
+#include <cstring>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <Utilities.HashingStream.h>
+#include <Utilities.MemoryStream.h>
+#include <Utilities.StreamWriter.h>
+#pragma comment(lib,"E15Utilities.lib")
+
+using namespace std;
+using namespace Utilities;
+using namespace Utilities::Encryption;
+
+/// <summary>
+/// 测试写入时计算散列值
+/// </summary>
+TEST(Utilities_HashingStream, Write)
+{
+	vector<uint8> data(100000);
+	for (size_t i = 0; i < data.size(); i++)
+		data[i] = static_cast<uint8>(i * 13 + 7);
+
+	MemoryStream ms;
+	HashingStream<CRC32::Core, SHA1::Core> hs(ms);
+	EXPECT_EQ(hs.Get<SHA1::Core>().ToString(), "da39a3ee5e6b4b0d3255bfef95601890afd80709");
+
+	hs.Write(3, "123");
+	EXPECT_EQ(hs.Get<1>().ToString(), "40bd001563085fc35165329ea1ff5c5ecbdbbeef");
+
+	hs.Reset();
+	auto sw = StreamWriter(hs);
+	sw.WriteArray(data.data(), 1000);
+	Stream::ConstSegment segments[] = { { data.data() + 1000, 500 }, { data.data() + 1500, data.size() - 1500 } };
+	hs.WriteV(2, segments);
+
+	EXPECT_EQ(ms.GetLength(), 3 + data.size());
+	EXPECT_TRUE(hs.Get<0>() == CRC32(data.data(), data.size()).Get());
+	EXPECT_TRUE(hs.Get<SHA1::Core>() == SHA1(data.data(), data.size()).Get());
+}
+
+/// <summary>
+/// 测试读取时计算散列值
+/// </summary>
+TEST(Utilities_HashingStream, Read)
+{
+	const std::string s = "The quick brown fox jumps over the lazy dog";
+	MemoryStream ms(s.data(), s.size());
+	HashingStream<SHA1::Core> hs(ms);
+	EXPECT_EQ(hs.GetStreamType(), Stream::Type::ReadOnly);
+
+	char buf[64];
+	hs.Read(4, buf);
+	EXPECT_EQ(hs.ReadSome(sizeof(buf), buf), s.size() - 4);
+	EXPECT_EQ(hs.ReadSome(sizeof(buf), buf), 0);
+	EXPECT_EQ(hs.Get<0>().ToString(), "2fd4e1c67a2d28fced849ee1bb76e7391b93eb12");
+	EXPECT_EQ(hs.GetPosition(), s.size());
+	EXPECT_THROW(hs.SetPosition(0), Exception);
+}
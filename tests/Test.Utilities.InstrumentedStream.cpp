@@ -0,0 +1,105 @@
+/**
+ @file
+ @brief 对 Utilities::InstrumentedStream 进行单元测试
+
+ @author 司马坑
+ @date 2026/10/17
+*/
+#include <string>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+#include <Utilities.InstrumentedStream.h>
+#include <Utilities.MemoryStream.h>
+#include <Utilities.StreamReader.h>
+
+#pragma comment(lib,"E15Utilities.lib")
+
+using namespace Utilities;
+
+TEST(Utilities_InstrumentedStream, Default)
+{
+	MemoryStream ms;
+	InstrumentedStream is(ms, "memory");
+	using Op = InstrumentedStream::Operation;
+
+	char data[100] = { 0 };
+	for (auto i = 0; i < 10; i++)
+		is.Write(10, data);
+	Stream::ConstSegment segments[] = { { data, 30 }, { data, 20 } };
+	is.WriteV(2, segments);
+	is.SetPosition(0);
+	is.Seek(5);
+	is.Read(45, data);
+	EXPECT_EQ(is.ReadSome(100, data), 100);
+	EXPECT_EQ(is.ReadSome(100, data), 0);
+	is.Flush();
+
+	auto write = is.GetStatistics(Op::Write);
+	EXPECT_EQ(write.calls, 11);
+	EXPECT_EQ(write.bytes, 150);
+	uint64_t buckets = 0;
+	for (auto count : write.latency)
+		buckets += count;
+	EXPECT_EQ(buckets, write.calls);
+	EXPECT_GE(write.Percentile(0.99), write.Percentile(0.5));
+
+	auto read = is.GetStatistics(Op::Read);
+	EXPECT_EQ(read.calls, 3);
+	EXPECT_EQ(read.bytes, 145);
+	EXPECT_EQ(is.GetStatistics(Op::Seek).calls, 2);
+	EXPECT_EQ(is.GetStatistics(Op::Flush).calls, 1);
+
+	is.ResetStatistics();
+	EXPECT_EQ(is.GetStatistics(Op::Write).calls, 0);
+	EXPECT_EQ(is.GetStatistics(Op::Write).Percentile(0.5), 0);
+}
+
+TEST(Utilities_InstrumentedStream, Dump)
+{
+	MemoryStream first, second;
+	InstrumentedStream a(first, "first");
+	InstrumentedStream b(second, "second");
+	a.Write(4, "abcd");
+
+	MemoryStream report;
+	InstrumentedStream::DumpAll(report);
+	{
+		InstrumentedStream c(second, "third");
+	}
+	auto view = report.View();
+	std::string text(reinterpret_cast<const char*>(view.data()), view.size());
+	EXPECT_NE(text.find("stream \"first\"\n  write calls=1 bytes=4 avg_bytes=4"), std::string::npos);
+	EXPECT_NE(text.find("stream \"second\"\n"), std::string::npos);
+	EXPECT_NE(text.find("latency_ns ["), std::string::npos);
+
+	// 析构后不再出现在登记表中
+	MemoryStream after;
+	InstrumentedStream::DumpAll(after);
+	auto afterView = after.View();
+	std::string afterText(reinterpret_cast<const char*>(afterView.data()), afterView.size());
+	EXPECT_EQ(afterText.find("third"), std::string::npos);
+}
+
+TEST(Utilities_InstrumentedStream, Concurrent)
+{
+	std::vector<char> data(4096, 'x');
+	MemoryStream ms(data.data(), data.size());
+	InstrumentedStream is(ms, "concurrent");
+
+	std::vector<std::thread> threads;
+	for (auto t = 0; t < 4; t++)
+	{
+		threads.emplace_back([&is, t]()
+		{
+			char buf[16];
+			for (auto i = 0; i < 1000; i++)
+				is.ReadAt((t * 1000 + i) % 4000, sizeof(buf), buf);
+		});
+	}
+	for (auto& thread : threads)
+		thread.join();
+	auto read = is.GetStatistics(InstrumentedStream::Operation::Read);
+	EXPECT_EQ(read.calls, 4000);
+	EXPECT_EQ(read.bytes, 4000 * 16);
+}
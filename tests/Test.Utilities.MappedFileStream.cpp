@@ -0,0 +1,137 @@
+/**
+ @file
+ @brief 对 Utilities::MappedFileStream 进行单元测试
+
+ 这个文件里面是通过几组函数对 Utilities::MappedFileStream 进行功能上的单元测试
+
+ @author 司马坑
+ @date 2026/10/17
+*/
+#define _CRT_SECURE_NO_WARNINGS
+
+#include <string>
+#include <cstring>
+#include <ctime>
+
+#include <gtest/gtest.h>
+
+#include <Utilities.MappedFileStream.h>
+#include <Utilities.StreamReader.h>
+#include <Utilities.Encryption.CRC32.h>
+#pragma comment(lib,"E15Utilities.lib")
+
+using namespace std;
+using namespace Utilities;
+
+/// <summary>
+/// 测试映射文件流的读取以及定位功能
+/// </summary>
+TEST(Utilities_MappedFileStream, Read)
+{
+	wchar_t fileName[L_tmpnam];
+	_wtmpnam(fileName);
+
+	srand(static_cast<uint32_t>(time(nullptr)));
+
+	const auto size = 1024;
+	char buf[size] = { 0 };
+	for (auto i = 0; i < size; i++)
+		buf[i] ^= rand() & 255;
+
+	FILE* fp = _wfopen(fileName, L"wb");
+	fwrite(buf, 1, size, fp);
+	fclose(fp);
+
+	MappedFileStream fs(fileName);
+	EXPECT_EQ(fs.GetLength(), size);
+
+	char cmp[size];
+	fs.Read(size, cmp);
+	EXPECT_EQ(memcmp(cmp, buf, size), 0);
+	EXPECT_THROW(fs.Read(1, cmp), Exception);
+
+	fs.SetPosition(size / 2);
+	auto sr = StreamReader(fs);
+	for (auto i = size / 2; i < size; i++)
+		EXPECT_EQ(sr.Read<char>(), buf[i]);
+	EXPECT_THROW(fs.Write(1, buf), Exception);
+}
+
+/// <summary>
+/// 测试映射区域的零复制视图
+/// </summary>
+TEST(Utilities_MappedFileStream, View)
+{
+	wchar_t fileName[L_tmpnam];
+	_wtmpnam(fileName);
+
+	const auto str = "123";
+	FILE* fp = _wfopen(fileName, L"wb");
+	fwrite(str, 1, 3, fp);
+	fclose(fp);
+
+	MappedFileStream fs(fileName);
+	auto view = fs.View();
+	ASSERT_EQ(view.size(), 3);
+	EXPECT_EQ(2286445522, Encryption::CRC32(view.data(), view.size()).Get().HashData);
+
+	fs.Seek(1);
+	auto part = fs.ReadView(2);
+	EXPECT_EQ(part.data(), view.data() + 1);
+	EXPECT_EQ(fs.GetPosition(), 3);
+	EXPECT_THROW(fs.ReadView(1), Exception);
+
+	fs.Close();
+	EXPECT_FALSE(fs.IsVaild());
+}
+
+/// <summary>
+/// 测试映射区域的访问方式提示
+/// </summary>
+TEST(Utilities_MappedFileStream, Advise)
+{
+	wchar_t fileName[L_tmpnam];
+	_wtmpnam(fileName);
+
+	const auto size = 3 * 4096 + 100;
+	std::string text(size, '\0');
+	for (auto i = 0; i < size; i++)
+		text[i] = static_cast<char>('a' + i % 26);
+	FILE* fp = _wfopen(fileName, L"wb");
+	fwrite(text.data(), 1, size, fp);
+	fclose(fp);
+
+	MappedFileStream fs(fileName);
+	fs.Advise(Stream::AccessHint::Sequential);
+	fs.Advise(Stream::AccessHint::WillNeed, 5000, 100);
+	auto view = fs.View();
+	EXPECT_EQ(std::string(reinterpret_cast<const char*>(view.data()), view.size()), text);
+
+	// 丢弃的页在下次访问时重新从文件读入
+	fs.Advise(Stream::AccessHint::DontNeed, 100, 4096 * 2);
+	EXPECT_EQ(std::string(reinterpret_cast<const char*>(view.data()), view.size()), text);
+	fs.Advise(Stream::AccessHint::Random, size - 1, 1000);
+	fs.Advise(Stream::AccessHint::Normal, size + 10);
+
+	fs.Close();
+	EXPECT_THROW(fs.Advise(Stream::AccessHint::Normal), Exception);
+}
+
+/// <summary>
+/// 测试映射空文件
+/// </summary>
+TEST(Utilities_MappedFileStream, Empty)
+{
+	wchar_t fileName[L_tmpnam];
+	_wtmpnam(fileName);
+
+	FILE* fp = _wfopen(fileName, L"wb");
+	fclose(fp);
+
+	MappedFileStream fs(fileName);
+	EXPECT_EQ(fs.GetLength(), 0);
+	EXPECT_TRUE(fs.View().empty());
+	char c;
+	fs.Read(0, &c);
+	EXPECT_THROW(fs.Read(1, &c), Exception);
+}
@@ -0,0 +1,113 @@
+/**
+ @file
+ @brief 对 Utilities::MemoryStream 进行单元测试
+
+ 这个文件里面是通过几组函数对 Utilities::MemoryStream 进行功能上的单元测试
+
+ @author 司马坑
+ @date 2026/10/17
+*/
+#define _CRT_SECURE_NO_WARNINGS
+
+#include <string>
+#include <cstring>
+#include <ctime>
+
+#include <gtest/gtest.h>
+
+#include <Utilities.MemoryStream.h>
+#pragma comment(lib,"E15Utilities.lib")
+
+using namespace std;
+using namespace Utilities;
+
+/// <summary>
+/// 测试内存流的读写功能
+/// </summary>
+TEST(Utilities_MemoryStream, ReadWrite)
+{
+	srand(static_cast<uint32_t>(time(nullptr)));
+
+	const auto size = 1024;
+	char buf[size] = { 0 };
+	for (auto i = 0; i < size; i++)
+		buf[i] ^= rand() & 255;
+
+	MemoryStream ms;
+	ms.Write(size / 2, buf);
+	ms.Write(size / 2, buf + size / 2);
+	EXPECT_EQ(ms.GetLength(), size);
+	EXPECT_EQ(ms.GetPosition(), size);
+
+	ms.SetPosition(0);
+	char cmp[size];
+	ms.Read(size, cmp);
+	EXPECT_EQ(memcmp(cmp, buf, size), 0);
+
+	EXPECT_THROW(ms.Read(1, cmp), Exception);
+}
+
+/// <summary>
+/// 测试内存流的缓冲区增长以及零复制视图
+/// </summary>
+TEST(Utilities_MemoryStream, View)
+{
+	MemoryStream ms;
+	for (uint32_t i = 0; i < 4096; i++)
+		ms.Write(sizeof(i), &i);
+
+	EXPECT_GE(ms.GetCapacity(), 4096 * sizeof(uint32_t));
+	auto view = ms.View();
+	ASSERT_EQ(view.size(), 4096 * sizeof(uint32_t));
+	for (uint32_t i = 0; i < 4096; i++)
+	{
+		uint32_t v;
+		memcpy(&v, view.data() + i * sizeof(uint32_t), sizeof(v));
+		EXPECT_EQ(v, i);
+	}
+}
+
+/// <summary>
+/// 测试使用外部缓冲区的内存流
+/// </summary>
+TEST(Utilities_MemoryStream, Arena)
+{
+	uint8 arena[16];
+	MemoryStream ms{ Common::Span<uint8>(arena) };
+
+	const char* str = u8"0123456789";
+	ms.Write(10, str);
+	EXPECT_EQ(ms.View().data(), arena);
+
+	// 超出外部缓冲区容量后迁移到堆内存
+	ms.Write(10, str);
+	EXPECT_NE(ms.View().data(), arena);
+	EXPECT_EQ(memcmp(ms.View().data(), u8"01234567890123456789", 20), 0);
+}
+
+/// <summary>
+/// 测试只读内存流以及指针定位
+/// </summary>
+TEST(Utilities_MemoryStream, ReadOnly)
+{
+	const char data[] = u8"hello world";
+	MemoryStream ms(data, sizeof(data) - 1);
+	EXPECT_EQ(ms.GetStreamType(), Stream::Type::ReadOnly);
+	EXPECT_THROW(ms.Write(1, data), Exception);
+
+	ms.Seek(6);
+	char cmp[5];
+	ms.Read(5, cmp);
+	EXPECT_EQ(memcmp(cmp, "world", 5), 0);
+
+	// 写入位置越过末尾时以 0 填充
+	MemoryStream ws;
+	ws.SetPosition(4);
+	ws.Write(1, data);
+	EXPECT_EQ(ws.GetLength(), 5);
+	EXPECT_EQ(ws.View()[0], 0);
+	EXPECT_EQ(ws.View()[4], 'h');
+
+	ws.Close();
+	EXPECT_FALSE(ws.IsVaild());
+}
@@ -0,0 +1,114 @@
+/**
+ @file
+ @brief 对 Utilities::PipeStream 进行单元测试
+
+ 这个文件里面是通过几组函数对 Utilities::PipeStream 进行功能上的单元测试
+
+ @author 司马坑
+ @date 2026/10/17
+*/
+#define _CRT_SECURE_NO_WARNINGS
+
+#include <string>
+#include <cstring>
+#include <vector>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include <Utilities.PipeStream.h>
+#include <Utilities.StreamReader.h>
+#include <Utilities.StreamWriter.h>
+#pragma comment(lib,"E15Utilities.lib")
+
+using namespace std;
+using namespace Utilities;
+
+/// <summary>
+/// 测试非阻塞读写以及环形缓冲区回绕
+/// </summary>
+TEST(Utilities_PipeStream, TryReadWrite)
+{
+	PipeStream pipe(100);
+	EXPECT_EQ(pipe.GetCapacity(), 128);
+
+	char buf[200];
+	EXPECT_EQ(pipe.TryRead(10, buf), 0);
+
+	vector<char> data(200);
+	for (auto i = 0; i < 200; i++)
+		data[i] = static_cast<char>(i);
+	EXPECT_EQ(pipe.TryWrite(100, data.data()), 100);
+	EXPECT_EQ(pipe.TryWrite(100, data.data() + 100), 28);
+	EXPECT_EQ(pipe.TryWrite(1, data.data()), 0);
+
+	EXPECT_EQ(pipe.TryRead(90, buf), 90);
+	EXPECT_EQ(memcmp(buf, data.data(), 90), 0);
+	// 写入位置回绕到缓冲区开头
+	EXPECT_EQ(pipe.TryWrite(72, data.data() + 128), 72);
+	EXPECT_EQ(pipe.GetReadableLength(), 110);
+	EXPECT_EQ(pipe.TryRead(200, buf), 110);
+	EXPECT_EQ(memcmp(buf, data.data() + 90, 110), 0);
+}
+
+/// <summary>
+/// 测试关闭后的行为
+/// </summary>
+TEST(Utilities_PipeStream, Close)
+{
+	PipeStream pipe;
+	pipe.Write(5, "hello");
+	pipe.Close();
+	EXPECT_THROW(pipe.Write(1, "x"), Exception);
+
+	// 关闭前写入的数据仍然可以读出
+	EXPECT_TRUE(pipe.IsVaild());
+	char buf[8];
+	EXPECT_EQ(pipe.ReadSome(8, buf), 5);
+	EXPECT_EQ(memcmp(buf, "hello", 5), 0);
+	EXPECT_FALSE(pipe.IsVaild());
+	EXPECT_EQ(pipe.ReadSome(8, buf), 0);
+	EXPECT_THROW(pipe.Read(1, buf), Exception);
+}
+
+/// <summary>
+/// 测试生产者线程与消费者线程之间的阻塞读写
+/// </summary>
+TEST(Utilities_PipeStream, Threads)
+{
+	PipeStream pipe(4096);
+	const uint32_t count = 1000000;
+	thread producer([&]()
+		{
+			auto sw = StreamWriter(pipe);
+			vector<uint32_t> block(1000);
+			for (uint32_t i = 0; i < count; i += 1000)
+			{
+				for (uint32_t j = 0; j < 1000; j++)
+					block[j] = i + j;
+				sw.WriteArray(block);
+			}
+			sw.Write<uint8>(0xFF);
+			pipe.Close();
+		});
+
+	auto sr = StreamReader(pipe);
+	bool ok = true;
+	for (uint32_t i = 0; i < count; i++)
+		ok = ok && sr.Read<uint32_t>() == i;
+	EXPECT_TRUE(ok);
+	EXPECT_EQ(sr.Read<uint8>(), 0xFF);
+	producer.join();
+	EXPECT_FALSE(pipe.IsVaild());
+
+	// 消费者关闭管道时阻塞中的生产者被唤醒
+	PipeStream small(64);
+	thread blocked([&]()
+		{
+			vector<char> big(1024);
+			EXPECT_THROW(small.Write(big.size(), big.data()), Exception);
+		});
+	this_thread::sleep_for(chrono::milliseconds(20));
+	small.Close();
+	blocked.join();
+}
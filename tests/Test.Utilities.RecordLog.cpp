@@ -0,0 +1,139 @@
+/**
+ @file
+ @brief 对 Utilities::RecordWriter 与 Utilities::RecordReader 进行单元测试
+
+ @author 司马坑
+ @date 2026/10/17
+*/
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include <Utilities.RecordLog.h>
+#include <Utilities.MemoryStream.h>
+
+#pragma comment(lib,"E15Utilities.lib")
+
+using namespace Utilities;
+
+namespace
+{
+	std::string MakeRecord(int i)
+	{
+		// 长度从 0 到 1000 字节不等
+		return std::string(static_cast<size_t>(i * 37 % 1001), static_cast<char>('a' + i % 26)) + std::to_string(i);
+	}
+
+	void WriteRecords(MemoryStream& ms, int count, size_t syncInterval)
+	{
+		RecordWriter writer(ms, 0, syncInterval);
+		for (int i = 0; i < count; i++)
+		{
+			auto record = MakeRecord(i);
+			writer.Write(record.size(), record.data());
+		}
+		EXPECT_EQ(writer.GetOffset(), ms.GetLength());
+	}
+
+	std::string ReadAt(MemoryStream& ms, const RecordReader::RecordLocation& location)
+	{
+		std::string text(location.length, '\0');
+		ms.ReadAt(location.offset, text.size(), text.data());
+		return text;
+	}
+}
+
+TEST(Utilities_RecordLog, ReadWrite)
+{
+	MemoryStream ms;
+	WriteRecords(ms, 500, 4096);
+	ms.SetPosition(0);
+
+	RecordReader reader(ms);
+	for (int i = 0; i < 500; i++)
+	{
+		auto record = reader.Read();
+		ASSERT_TRUE(record.has_value());
+		EXPECT_EQ(std::string(reinterpret_cast<const char*>(record->data()), record->size()), MakeRecord(i));
+	}
+	EXPECT_FALSE(reader.Read().has_value());
+	EXPECT_EQ(reader.GetOffset(), ms.GetLength());
+}
+
+TEST(Utilities_RecordLog, Corruption)
+{
+	MemoryStream ms;
+	WriteRecords(ms, 10, 4096);
+	auto length = ms.GetLength();
+
+	// 改写负载中的一个字节
+	uint8_t byte;
+	ms.ReadAt(length / 2, 1, &byte);
+	byte ^= 0x40;
+	ms.WriteAt(length / 2, 1, &byte);
+	ms.SetPosition(0);
+	RecordReader reader(ms);
+	EXPECT_THROW(while (reader.Read()) { }, Exception);
+
+	// 最后一条记录不完整
+	MemoryStream truncated;
+	WriteRecords(truncated, 10, 4096);
+	std::vector<uint8_t> data(static_cast<size_t>(truncated.GetLength()) - 3);
+	truncated.ReadAt(0, data.size(), data.data());
+	MemoryStream ms2;
+	ms2.Write(data.size(), data.data());
+	ms2.SetPosition(0);
+	RecordReader reader2(ms2);
+	for (int i = 0; i < 9; i++)
+		EXPECT_TRUE(reader2.Read().has_value());
+	EXPECT_THROW(reader2.Read(), Exception);
+
+	auto result = RecordReader::Recover(ms2, 4);
+	EXPECT_EQ(result.records.size(), 9);
+	ASSERT_EQ(result.damaged.size(), 1);
+	EXPECT_EQ(result.damaged[0].end, data.size());
+	EXPECT_EQ(result.validLength, result.damaged[0].begin);
+	EXPECT_EQ(ReadAt(ms2, result.records.back()), MakeRecord(8));
+}
+
+TEST(Utilities_RecordLog, Recover)
+{
+	MemoryStream ms;
+	const int count = 5000;
+	WriteRecords(ms, count, 16 * 1024);
+	auto length = ms.GetLength();
+
+	for (size_t threads : { 1, 3, 8 })
+	{
+		auto result = RecordReader::Recover(ms, threads);
+		ASSERT_EQ(result.records.size(), count);
+		EXPECT_TRUE(result.damaged.empty());
+		EXPECT_EQ(result.validLength, length);
+		for (int i = 0; i < count; i += 97)
+			EXPECT_EQ(ReadAt(ms, result.records[i]), MakeRecord(i));
+	}
+
+	// 破坏中间的一段，只丢失该处到下一个同步标记之间的记录
+	auto damage = length / 3;
+	std::vector<uint8_t> garbage(100, 0xE1);
+	ms.WriteAt(damage, garbage.size(), garbage.data());
+	auto result = RecordReader::Recover(ms, 4);
+	ASSERT_EQ(result.damaged.size(), 1);
+	EXPECT_LE(result.damaged[0].begin, damage);
+	EXPECT_GT(result.damaged[0].end, damage + garbage.size());
+	EXPECT_LE(result.damaged[0].end - result.damaged[0].begin, 2 * 16 * 1024 + 1100);
+	EXPECT_EQ(result.validLength, length);
+	EXPECT_LT(result.records.size(), count);
+	EXPECT_GT(result.records.size(), count - 40);
+
+	// 剩下的记录都完好且保持顺序
+	int next = 0;
+	for (auto& location : result.records)
+	{
+		auto text = ReadAt(ms, location);
+		while (next < count && text != MakeRecord(next))
+			next++;
+		ASSERT_LT(next, count);
+		next++;
+	}
+	EXPECT_EQ(ReadAt(ms, result.records.back()), MakeRecord(count - 1));
+}
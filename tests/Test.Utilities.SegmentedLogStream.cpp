@@ -0,0 +1,117 @@
+/**
+ @file
+ @brief 对 Utilities::SegmentedLogStream 进行单元测试
+
+ @author 司马坑
+ @date 2026/10/17
+*/
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+#include <Utilities.SegmentedLogStream.h>
+
+#pragma comment(lib,"E15Utilities.lib")
+
+using namespace Utilities;
+
+namespace
+{
+	std::string ReadSegment(const std::wstring& path)
+	{
+		FileStream fs(path.c_str(), Stream::Type::ReadOnly, false);
+		std::string text(static_cast<size_t>(fs.GetLength()), '\0');
+		fs.Read(text.size(), text.data());
+		return text;
+	}
+}
+
+TEST(Utilities_SegmentedLogStream, Rotate)
+{
+	wchar_t baseName[L_tmpnam];
+	_wtmpnam(baseName);
+	{
+		SegmentedLogStream log(baseName, 16);
+		EXPECT_EQ(log.Append(10, "0123456789"), 10);
+		// 放不下时滚动到下一段，记录不会跨越两个段
+		EXPECT_EQ(log.Append(10, "abcdefghij"), 20);
+		EXPECT_EQ(log.GetSegmentIndex(), 1);
+		// 超过段大小的记录单独占用一个段
+		EXPECT_EQ(log.Commit(20, "ABCDEFGHIJKLMNOPQRST"), 40);
+		EXPECT_EQ(log.GetSegmentIndex(), 2);
+		EXPECT_EQ(log.GetDurableLength(), 40);
+		// 尚未写入的序号永远不会落盘
+		EXPECT_THROW(log.WaitDurable(41), Exception);
+		log.Write(3, "xyz");
+		EXPECT_EQ(log.GetSegmentIndex(), 3);
+		log.Close();
+		EXPECT_EQ(log.GetDurableLength(), 43);
+		EXPECT_FALSE(log.IsVaild());
+		EXPECT_THROW(log.Append(1, "x"), Exception);
+	}
+	SegmentedLogStream log(baseName, 16);
+	EXPECT_EQ(ReadSegment(log.GetSegmentPath(0)), std::string("0123456789"));
+	EXPECT_EQ(ReadSegment(log.GetSegmentPath(1)), std::string("abcdefghij"));
+	EXPECT_EQ(ReadSegment(log.GetSegmentPath(2)), std::string("ABCDEFGHIJKLMNOPQRST"));
+	EXPECT_EQ(log.GetSegmentPath(2), std::wstring(baseName) + L".00000002");
+
+	// 重新打开时从最后一段继续追加
+	EXPECT_EQ(log.GetSegmentIndex(), 3);
+	log.Commit(4, "uvw\n");
+	EXPECT_EQ(log.GetSegmentIndex(), 3);
+	log.Commit(13, "0123456789abc");
+	EXPECT_EQ(log.GetSegmentIndex(), 4);
+	log.Close();
+	EXPECT_EQ(ReadSegment(log.GetSegmentPath(3)), std::string("xyzuvw\n"));
+	EXPECT_EQ(ReadSegment(log.GetSegmentPath(4)), std::string("0123456789abc"));
+}
+
+TEST(Utilities_SegmentedLogStream, GroupCommit)
+{
+	wchar_t baseName[L_tmpnam];
+	_wtmpnam(baseName);
+	const int threadCount = 8;
+	const int recordCount = 200;
+	{
+		SegmentedLogStream log(baseName, 4096);
+		std::vector<std::thread> threads;
+		for (int t = 0; t < threadCount; t++)
+		{
+			threads.emplace_back([&log, t]() {
+				for (int i = 0; i < recordCount; i++)
+				{
+					char record[16];
+					snprintf(record, sizeof(record), "%c%05d\n", 'a' + t, i);
+					auto lsn = log.Commit(7, record);
+					EXPECT_GE(log.GetDurableLength(), lsn);
+				}
+			});
+		}
+		for (auto& thread : threads)
+			thread.join();
+		EXPECT_EQ(log.GetWrittenLength(), uint64_t(7) * threadCount * recordCount);
+		EXPECT_EQ(log.GetDurableLength(), log.GetWrittenLength());
+		// 并发等待的提交共用同步
+		EXPECT_LT(log.GetSyncCount(), uint64_t(threadCount) * recordCount);
+
+		// 每条记录完整地出现在某一段中，且每个线程的记录保持顺序
+		std::vector<int> next(threadCount, 0);
+		for (uint64_t i = 0; i <= log.GetSegmentIndex(); i++)
+		{
+			auto text = ReadSegment(log.GetSegmentPath(i));
+			ASSERT_EQ(text.size() % 7, 0);
+			EXPECT_LE(text.size(), 4096);
+			for (size_t p = 0; p < text.size(); p += 7)
+			{
+				auto t = text[p] - 'a';
+				ASSERT_GE(t, 0);
+				ASSERT_LT(t, threadCount);
+				EXPECT_EQ(std::stoi(text.substr(p + 1, 5)), next[t]++);
+				EXPECT_EQ(text[p + 6], '\n');
+			}
+		}
+		for (auto n : next)
+			EXPECT_EQ(n, recordCount);
+	}
+}
@@ -11,6 +11,7 @@
 #include <gtest/gtest.h>
 #include <Utilities.StreamReader.h>
 #include <Utilities.FileStream.h>
+#include <Utilities.MemoryStream.h>
 
 #pragma comment(lib,"E15Utilities.lib")
 
@@ -58,4 +59,98 @@ TEST(Utilties_StreamReader, STDIO)
 	for (auto i = 0; i < size; i++)
 		EXPECT_EQ(sr.Read<char>(), buf[i]);
 
-}
\ No newline at end of file
+}
+
+TEST(Utilties_StreamReader, Array)
+{
+	struct Vertex { float x, y, z; };
+	Vertex vertices[64];
+	for (auto i = 0; i < 64; i++)
+		vertices[i] = { i * 1.0f, i * 2.0f, i * 3.0f };
+
+	MemoryStream ms(vertices, sizeof(vertices));
+	StreamReader sr = StreamReader(ms);
+
+	Vertex head[16];
+	sr.ReadArray(head, 16);
+	EXPECT_EQ(memcmp(head, vertices, sizeof(head)), 0);
+
+	auto tail = sr.ReadVector<Vertex>(48);
+	ASSERT_EQ(tail.size(), 48);
+	EXPECT_EQ(memcmp(tail.data(), vertices + 16, sizeof(Vertex) * 48), 0);
+
+	float f;
+	EXPECT_THROW(sr.ReadArray(Common::Span<float>(&f, 1)), Exception);
+}
+
+TEST(Utilties_StreamReader, STDIOArray)
+{
+	wchar_t fileName[L_tmpnam];
+	_wtmpnam(fileName);
+	FILE* fp = _wfopen(fileName, L"wb");
+
+	int buf[256];
+	for (auto i = 0; i < 256; i++)
+		buf[i] = rand();
+	fwrite(buf, sizeof(int), 256, fp);
+	fclose(fp);
+	fp = _wfopen(fileName, L"rb");
+
+	StreamReader sr = StreamReader(fp);
+	int cmp[128];
+	sr.ReadArray(Common::Span<int>(cmp));
+	EXPECT_EQ(memcmp(cmp, buf, sizeof(cmp)), 0);
+	auto v = sr.ReadVector<int>(128);
+	EXPECT_EQ(memcmp(v.data(), buf + 128, sizeof(cmp)), 0);
+	fclose(fp);
+}
+
+TEST(Utilties_StreamReader, ReadLine)
+{
+	// 行数足够多，使部分行跨越缓冲区的两次填充
+	std::string text;
+	std::vector<std::string> lines;
+	for (auto i = 0; i < 20000; i++)
+	{
+		lines.push_back(std::string(i % 13, static_cast<char>('a' + i % 26)));
+		text += lines.back();
+		text += i % 3 == 0 ? "\r\n" : "\n";
+	}
+	// 超过缓冲区大小的一行
+	lines.push_back(std::string(200000, 'x'));
+	text += lines.back();
+	text += "\n";
+	// 最后一行没有换行符
+	lines.push_back("last");
+	text += lines.back();
+
+	MemoryStream ms(text.data(), text.size());
+	StreamReader sr = StreamReader(ms);
+	size_t count = 0;
+	while (auto line = sr.ReadLine())
+	{
+		ASSERT_LT(count, lines.size());
+		EXPECT_EQ(*line, lines[count]);
+		count++;
+	}
+	EXPECT_EQ(count, lines.size());
+	EXPECT_FALSE(sr.ReadLine());
+}
+
+TEST(Utilties_StreamReader, ReadUntil)
+{
+	const char text[] = "key=value;;12345678";
+	MemoryStream ms(text, sizeof(text) - 1);
+	StreamReader sr = StreamReader(ms);
+	EXPECT_EQ(*sr.ReadUntil('='), "key");
+	EXPECT_EQ(*sr.ReadUntil(';'), "value");
+	EXPECT_EQ(*sr.ReadUntil(';'), "");
+	// 预读的数据由后续的读取取出
+	EXPECT_EQ(sr.Read<char>(), '1');
+	char digits[3];
+	sr.ReadArray(digits, 3);
+	EXPECT_EQ(memcmp(digits, "234", 3), 0);
+	EXPECT_EQ(*sr.ReadUntil('\n'), "5678");
+	EXPECT_FALSE(sr.ReadUntil('\n'));
+	EXPECT_THROW(sr.Read<char>(), Exception);
+}
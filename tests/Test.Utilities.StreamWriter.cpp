@@ -11,6 +11,7 @@
 #include <gtest/gtest.h>
 #include <Utilities.Stream.h>
 #include <Utilities.FileStream.h>
+#include <Utilities.MemoryStream.h>
 #include <Utilities.StreamReader.h>
 #include <Utilities.StreamWriter.h>
 
@@ -118,4 +119,122 @@ TEST(Utilties_StreamWriter, String)
 	EXPECT_STREQ(buf, str.c_str());
 
 	delete[] buf;
-}
\ No newline at end of file
+}
+
+TEST(Utilties_StreamWriter, Array)
+{
+	std::vector<double> samples(1000);
+	for (auto i = 0; i < 1000; i++)
+		samples[i] = i * 0.5;
+
+	MemoryStream ms;
+	StreamWriter sw = StreamWriter(ms);
+	sw.WriteArray(samples);
+	sw.WriteArray(samples.data(), 10);
+	sw.WriteArray(Common::Span<const double>(samples).SubSpan(990));
+
+	auto view = ms.View();
+	ASSERT_EQ(view.size(), sizeof(double) * 1020);
+	EXPECT_EQ(memcmp(view.data(), samples.data(), sizeof(double) * 1000), 0);
+	EXPECT_EQ(memcmp(view.data() + sizeof(double) * 1000, samples.data(), sizeof(double) * 10), 0);
+	EXPECT_EQ(memcmp(view.data() + sizeof(double) * 1010, samples.data() + 990, sizeof(double) * 10), 0);
+}
+
+TEST(Utilties_StreamWriter, STDIOArray)
+{
+	wchar_t fileName[L_tmpnam];
+	_wtmpnam(fileName);
+
+	int buf[256];
+	for (auto i = 0; i < 256; i++)
+		buf[i] = rand();
+	FILE* fs = _wfopen(fileName, L"wb");
+	StreamWriter sw = StreamWriter(fs);
+	sw.WriteArray(buf, 128);
+	sw.WriteArray(std::vector<int>(buf + 128, buf + 256));
+	fclose(fs);
+
+	int cmp[256];
+	FILE* fp = _wfopen(fileName, L"rb");
+	EXPECT_EQ(fread(cmp, sizeof(int), 256, fp), 256);
+	fclose(fp);
+	EXPECT_EQ(memcmp(cmp, buf, sizeof(buf)), 0);
+}
+
+TEST(Utilties_StreamWriter, Endian)
+{
+	MemoryStream ms;
+	auto sw = StreamWriter(ms);
+	sw.WriteBE<uint32_t>(0x89504E47);
+	sw.WriteLE<uint16_t>(0x0102);
+	sw.WriteBE(1.5f);
+
+	std::vector<int16_t> samples(3000);
+	for (size_t i = 0; i < samples.size(); i++)
+		samples[i] = static_cast<int16_t>(i * 37 - 20000);
+	sw.WriteArrayBE(samples);
+	sw.WriteArrayLE(samples);
+	EXPECT_EQ(ms.GetLength(), 10 + samples.size() * 4);
+
+	const uint8_t header[] = { 0x89, 0x50, 0x4E, 0x47, 0x02, 0x01, 0x3F, 0xC0, 0x00, 0x00 };
+	EXPECT_EQ(memcmp(ms.View().data(), header, sizeof(header)), 0);
+	EXPECT_EQ(ms.View()[10], static_cast<uint8_t>(samples[0] >> 8));
+
+	ms.SetPosition(0);
+	auto sr = StreamReader(ms);
+	EXPECT_EQ(sr.ReadBE<uint32_t>(), 0x89504E47);
+	EXPECT_EQ(sr.ReadLE<uint16_t>(), 0x0102);
+	EXPECT_EQ(sr.ReadBE<float>(), 1.5f);
+	EXPECT_EQ(sr.ReadVectorBE<int16_t>(samples.size()), samples);
+	std::vector<int16_t> le(samples.size());
+	sr.ReadArrayLE(le.data(), le.size());
+	EXPECT_EQ(le, samples);
+}
+
+TEST(Utilties_StreamWriter, Varint)
+{
+	MemoryStream ms;
+	auto sw = StreamWriter(ms);
+	sw.WriteVarint(300u);
+	sw.WriteVarint(-2);
+	sw.WriteVarint<int64_t>(INT64_MIN);
+
+	std::vector<uint64_t> ids(20000);
+	for (size_t i = 0; i < ids.size(); i++)
+		ids[i] = i % 100 == 0 ? i * 1000003 : i % 50;
+	std::vector<int64_t> deltas = { 0, -1, 1, -64, 64, INT64_MAX, INT64_MIN };
+	sw.WriteVarints(ids);
+	sw.WriteVarints(deltas);
+	EXPECT_LT(ms.GetLength(), ids.size() * 2);
+
+	ms.SetPosition(0);
+	auto sr = StreamReader(ms);
+	EXPECT_EQ(sr.ReadVarint<uint16_t>(), 300);
+	EXPECT_EQ(sr.ReadVarint<int8_t>(), -2);
+	EXPECT_EQ(sr.ReadVarint<int64_t>(), INT64_MIN);
+	std::vector<uint64_t> readIds(ids.size());
+	sr.ReadVarints(readIds.data(), readIds.size());
+	EXPECT_EQ(readIds, ids);
+	std::vector<int64_t> readDeltas(deltas.size());
+	sr.ReadVarints(readDeltas.data(), readDeltas.size());
+	EXPECT_EQ(readDeltas, deltas);
+	EXPECT_EQ(ms.GetPosition(), ms.GetLength());
+	EXPECT_THROW(sr.ReadVarint<uint32_t>(), Exception);
+}
+
+TEST(Utilties_StreamWriter, Format)
+{
+	MemoryStream ms;
+	auto sw = StreamWriter(ms);
+	sw.WriteInt(-42);
+	sw.Write(",");
+	sw.WriteHex(0x414fa339u, 8);
+	sw.Write(",");
+	sw.WriteFloat(0.25f);
+	sw.Write(",");
+	sw.WriteFloat(3.14159, 3);
+	sw.Format("\n{},{},{:.1}\n", 7u, "name", 2.25);
+
+	auto view = ms.View();
+	EXPECT_EQ(std::string(reinterpret_cast<const char*>(view.data()), view.size()), "-42,414fa339,0.25,3.142\n7,name,2.2\n");
+}
@@ -0,0 +1,130 @@
+/**
+ @file
+ @brief 对 Utilities::SubStream 进行单元测试
+
+ 这个文件里面是通过几组函数对 Utilities::SubStream 进行功能上的单元测试
+
+ @author 司马坑
+ @date 2026/10/17
+*/
+#define _CRT_SECURE_NO_WARNINGS
+
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <Utilities.SubStream.h>
+#include <Utilities.FileStream.h>
+#include <Utilities.MemoryStream.h>
+#include <Utilities.StreamReader.h>
+#pragma comment(lib,"E15Utilities.lib")
+
+using namespace std;
+using namespace Utilities;
+
+/// <summary>
+/// 测试子流的读写指针与边界检查
+/// </summary>
+TEST(Utilities_SubStream, Bounds)
+{
+	MemoryStream ms;
+	ms.Write(16, "0123456789ABCDEF");
+	ms.SetPosition(3);
+
+	SubStream ss(ms, 4, 8);
+	EXPECT_EQ(ss.GetLength(), 8);
+	EXPECT_EQ(ss.GetPosition(), 0);
+
+	char buf[16] = {};
+	ss.Read(4, buf);
+	EXPECT_EQ(memcmp(buf, "4567", 4), 0);
+	EXPECT_EQ(ss.ReadSome(16, buf), 4);
+	EXPECT_EQ(memcmp(buf, "89AB", 4), 0);
+	EXPECT_EQ(ss.ReadSome(16, buf), 0);
+	EXPECT_THROW(ss.Read(1, buf), Exception);
+
+	ss.Seek(-2);
+	ss.Write(2, "ab");
+	EXPECT_THROW(ss.Write(1, "c"), Exception);
+	EXPECT_THROW(ss.SetPosition(9), Exception);
+	EXPECT_THROW(ss.Seek(-9), Exception);
+
+	// 父流的读写指针不受影响
+	EXPECT_EQ(ms.GetPosition(), 3);
+	ms.SetPosition(0);
+	ms.Read(16, buf);
+	EXPECT_EQ(memcmp(buf, "0123456789abCDEF", 16), 0);
+
+	ss.Close();
+	EXPECT_FALSE(ss.IsVaild());
+	EXPECT_TRUE(ms.IsVaild());
+	EXPECT_THROW(ss.Read(1, buf), Exception);
+}
+
+/// <summary>
+/// 测试嵌套的子流
+/// </summary>
+TEST(Utilities_SubStream, Nested)
+{
+	const char data[] = "header|<payload>|trailer";
+	MemoryStream ms(data, sizeof(data) - 1);
+
+	SubStream outer(ms, 7, 9);
+	SubStream inner(outer, 1, 7);
+	EXPECT_EQ(inner.GetLength(), 7);
+
+	char buf[8] = {};
+	inner.ReadAt(0, 7, buf);
+	EXPECT_EQ(memcmp(buf, "payload", 7), 0);
+	EXPECT_EQ(inner.GetPosition(), 0);
+	EXPECT_THROW(inner.ReadAt(1, 7, buf), Exception);
+	EXPECT_THROW(SubStream(ms, ~0ull, 2), Exception);
+}
+
+/// <summary>
+/// 测试多个线程通过子流并发读取同一个文件
+/// </summary>
+TEST(Utilities_SubStream, Concurrent)
+{
+	wchar_t fileName[L_tmpnam];
+	_wtmpnam(fileName);
+
+	constexpr size_t ThreadCount = 4;
+	constexpr size_t PartSize = 64 * 1024;
+	vector<uint8> data(ThreadCount * PartSize);
+	for (size_t i = 0; i < data.size(); i++)
+		data[i] = static_cast<uint8>(i * 31 + i / 977);
+	{
+		auto fs = FileStream(fileName, Stream::Type::WriteOnly, false);
+		fs.Write(data.size(), data.data());
+	}
+
+	auto fs = FileStream(fileName, Stream::Type::ReadOnly, false);
+	vector<int> ok(ThreadCount, 0);
+	vector<thread> threads;
+	for (size_t t = 0; t < ThreadCount; t++)
+	{
+		threads.emplace_back([&, t]()
+			{
+				SubStream ss(fs, t * PartSize, PartSize);
+				auto sr = StreamReader(ss);
+				bool same = true;
+				for (size_t i = 0; i < PartSize; i += 1024)
+				{
+					auto block = sr.ReadVector<uint8>(1024);
+					same = same && memcmp(block.data(), data.data() + t * PartSize + i, 1024) == 0;
+				}
+				uint8 tail;
+				ok[t] = same && ss.ReadSome(1, &tail) == 0;
+			});
+	}
+	for (auto& t : threads)
+		t.join();
+	for (size_t t = 0; t < ThreadCount; t++)
+		EXPECT_TRUE(ok[t]);
+	EXPECT_EQ(fs.GetPosition(), 0);
+	fs.Close();
+}